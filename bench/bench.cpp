@@ -0,0 +1,500 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glm/glm.hpp>
+#include <glm/vec2.hpp>
+
+#include <box2d/box2d.h>
+
+// Our code
+#include "ball.hpp"
+#include "entity.hpp"
+#include "font.hpp"
+#include "gpu_particles.hpp"
+#include "includes.hpp"
+#include "random.hpp"
+#include "renderer.hpp"
+#include "spatial_grid.hpp"
+
+// CPU hot paths of a frame, without a window or GPU. Each benchmark runs
+// until it has had BENCH_MIN_SECONDS and at least BENCH_MIN_REPEATS runs,
+// the best run is reported as JSON so results can be diffed across builds.
+constexpr int BENCH_MIN_REPEATS = 5;
+const double BENCH_MIN_SECONDS = 0.25;
+constexpr int BENCH_MAX_RESULTS = 32;
+
+constexpr int BENCH_IMAGE_SIZE = 1024; // Same as the uv test texture
+constexpr int BENCH_DIRTY_SPRITES = 4096;
+constexpr int BENCH_PARTICLES = 64 * 1024;
+constexpr int BENCH_GRID_ENTITIES = 16384;
+constexpr int BENCH_GRID_WORLD_SCREENS = 16;
+constexpr int BENCH_TEXT_LINES = 32; // 2 kB of HUD text
+constexpr int BENCH_TEXT_LINE_LENGTH = 64;
+
+typedef void BenchFunction(void* data);
+
+typedef struct BenchResult
+{
+    const char* name;
+    int items; // Per run, one op is one item
+    int repeats;
+    double bestSeconds;
+} BenchResult;
+
+typedef struct BenchData
+{
+    RandomState random;
+
+    Ball balls[MAX_BALLS];
+    PositionTextureVertex vertices[MAX_SPRITES * 4];
+
+    EntityTable entities;
+    EntityId shuffledIds[BENCH_DIRTY_SPRITES];
+    EntityId sortedIds[BENCH_DIRTY_SPRITES];
+    SpriteRange ranges[BENCH_DIRTY_SPRITES];
+    int rangeCount;
+
+    // The same entities spread over one screen and over a large world
+    SpatialGrid screenGrid;
+    SpatialGrid worldGrid;
+    glm::vec2 gridCenters[BENCH_GRID_ENTITIES];
+    glm::vec2 gridHalfExtents[BENCH_GRID_ENTITIES];
+    EntityId visibleIds[MAX_ENTITIES];
+    float gridStep;
+
+    GpuParticleUniforms particleUniforms;
+    GpuParticle particles[BENCH_PARTICLES];
+
+    Font font;
+    char text[BENCH_TEXT_LINES * BENCH_TEXT_LINE_LENGTH + 1];
+
+    SDL_Surface* imageBGR24;
+    SDL_Surface* imageARGB8888;
+} BenchData;
+
+global_variable BenchResult Results[BENCH_MAX_RESULTS];
+global_variable int ResultCount;
+
+// Written by every benchmark so the work cannot be optimized away
+global_variable volatile Uint64 Sink;
+
+// -------------------------------------------------------------------------------
+internal void
+RunBench(const char* name, BenchFunction* function, void* data, int items)
+{
+    BenchResult* result = &Results[ResultCount++];
+    result->name = name;
+    result->items = items;
+    result->bestSeconds = 1e30;
+
+    double totalSeconds = 0.0;
+    while (result->repeats < BENCH_MIN_REPEATS ||
+           totalSeconds < BENCH_MIN_SECONDS)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        function(data);
+        double seconds = (double)(SDL_GetPerformanceCounter() - start) /
+                         (double)SDL_GetPerformanceFrequency();
+
+        result->bestSeconds = SDL_min(result->bestSeconds, seconds);
+        result->repeats += 1;
+        totalSeconds += seconds;
+    }
+}
+
+// The speed correction UpdateBall applies after a bounce
+internal void
+BenchKeepSpeed(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+
+    for (int i = 0; i < MAX_BALLS; ++i)
+    {
+        BallKeepSpeed(&bench->balls[i]);
+    }
+
+    Sink = Sink + (Uint64)bench->balls[0].bounceCount;
+}
+
+internal void
+BenchSpriteQuads(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+
+    for (int i = 0; i < MAX_BALLS; ++i)
+    {
+        const Ball* ball = &bench->balls[i];
+        RendererWriteSpriteQuad(
+          &bench->vertices[i * 4], ball->position, glm::vec2(ball->radius));
+    }
+
+    Sink = Sink + (Uint64)bench->vertices[4].x;
+}
+
+internal void
+BenchMarkDirty(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+
+    for (int i = 0; i < BENCH_DIRTY_SPRITES; ++i)
+    {
+        EntityMarkDirty(&bench->entities, bench->shuffledIds[i]);
+    }
+    Sink = Sink + (Uint64)bench->entities.dirtyCount;
+    EntityClearDirty(&bench->entities);
+}
+
+// The pending list sort before the sprite upload, copy included
+internal void
+BenchSortIds(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+
+    SDL_memcpy(
+      bench->sortedIds, bench->shuffledIds, sizeof(bench->shuffledIds));
+    SDL_qsort(bench->sortedIds,
+              BENCH_DIRTY_SPRITES,
+              sizeof(EntityId),
+              EntityCompareIds);
+
+    Sink = Sink + bench->sortedIds[0];
+}
+
+internal void
+BenchSpriteRanges(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+
+    int cursor = 0;
+    bench->rangeCount = 0;
+    while (RendererNextSpriteRange(bench->sortedIds,
+                                   BENCH_DIRTY_SPRITES,
+                                   &cursor,
+                                   &bench->ranges[bench->rangeCount]))
+    {
+        bench->rangeCount += 1;
+    }
+
+    Sink = Sink + (Uint64)bench->rangeCount;
+}
+
+// Culls against the screen, where everything is visible
+internal void
+BenchGridQueryScreen(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+
+    int count = SpatialGridQuery(&bench->screenGrid,
+                                 glm::vec2(0.0f),
+                                 glm::vec2((float)GAME_WIDTH, GAME_HEIGHT),
+                                 bench->visibleIds,
+                                 NULL);
+
+    Sink = Sink + (Uint64)count;
+}
+
+// The same cull with the world grown past the screen, should cost a
+// fraction of the one above
+internal void
+BenchGridQueryWorld(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+
+    int count = SpatialGridQuery(&bench->worldGrid,
+                                 glm::vec2(0.0f),
+                                 glm::vec2((float)GAME_WIDTH, GAME_HEIGHT),
+                                 bench->visibleIds,
+                                 NULL);
+
+    Sink = Sink + (Uint64)count;
+}
+
+// Every entity moves a little, a few change cells
+internal void
+BenchGridUpdate(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+    bench->gridStep = -bench->gridStep;
+
+    for (int i = 0; i < BENCH_GRID_ENTITIES; ++i)
+    {
+        bench->gridCenters[i].x += bench->gridStep;
+        SpatialGridUpdate(&bench->worldGrid,
+                          (EntityId)(i + 1),
+                          bench->gridCenters[i],
+                          bench->gridHalfExtents[i]);
+    }
+
+    Sink = Sink + (Uint64)bench->worldGrid.idEnd;
+}
+
+// A frame of HUD text with the glyphs already in the atlas
+internal void
+BenchFontLayout(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+    Font* font = &bench->font;
+    font->glyphCount = 0;
+    font->frame += 1;
+
+    int x = FontDrawText(font, 4, 4, 1, bench->text);
+
+    Sink = Sink + (Uint64)(font->glyphCount + x);
+}
+
+// The CPU reference of the compute shader update, nothing dies
+internal void
+BenchSimulateParticles(void* data)
+{
+    BenchData* bench = (BenchData*)data;
+
+    int alive = 0;
+    for (int i = 0; i < BENCH_PARTICLES; ++i)
+    {
+        alive += GpuParticleSimulate(&bench->particleUniforms,
+                                     &bench->particles[i]);
+    }
+
+    Sink = Sink + (Uint64)alive;
+}
+
+// RendererLoadImage converts whatever the BMP holds to ABGR8888
+internal void
+BenchConvert(SDL_Surface* source)
+{
+    SDL_Surface* converted =
+      SDL_ConvertSurface(source, SDL_PIXELFORMAT_ABGR8888);
+    if (converted == NULL)
+    {
+        SDL_Log("SDL_ConvertSurface failed: %s", SDL_GetError());
+        return;
+    }
+
+    Sink = Sink + ((Uint8*)converted->pixels)[0];
+    SDL_DestroySurface(converted);
+}
+
+internal void
+BenchConvertBGR24(void* data)
+{
+    BenchConvert(((BenchData*)data)->imageBGR24);
+}
+
+internal void
+BenchConvertARGB8888(void* data)
+{
+    BenchConvert(((BenchData*)data)->imageARGB8888);
+}
+
+// -------------------------------------------------------------------------------
+internal SDL_Surface*
+CreateNoiseImage(RandomState* random, SDL_PixelFormat format)
+{
+    SDL_Surface* surface =
+      SDL_CreateSurface(BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE, format);
+    if (surface == NULL)
+    {
+        SDL_Log("SDL_CreateSurface failed: %s", SDL_GetError());
+        return NULL;
+    }
+
+    Uint8* pixels = (Uint8*)surface->pixels;
+    for (int i = 0; i < surface->pitch * surface->h; ++i)
+    {
+        pixels[i] = (Uint8)RandomNext(random);
+    }
+
+    return surface;
+}
+
+internal int
+InitBenchData(BenchData* bench)
+{
+    RandomSeed(&bench->random, 0x853c49e6748fea9bULL);
+
+    for (int i = 0; i < MAX_BALLS; ++i)
+    {
+        Ball* ball = &bench->balls[i];
+        ball->radius = RandomRange(&bench->random, 4.0f, 32.0f);
+        ball->position =
+          glm::vec2(RandomRange(&bench->random, 32.0f, GAME_WIDTH - 32.0f),
+                    RandomRange(&bench->random, 32.0f, GAME_HEIGHT - 32.0f));
+
+        float angle = RandomRange(&bench->random, 0.0f, 2.0f * (float)PI);
+        ball->speed = RandomRange(&bench->random, 50.0f, 400.0f);
+        ball->velocity = glm::vec2(SDL_cosf(angle), SDL_sinf(angle)) *
+                         RandomRange(&bench->random, 0.5f, 1.5f) * ball->speed;
+    }
+
+    // Sprites the size of a full entity table, a random subset goes dirty
+    EntityTable* entities = &bench->entities;
+    entities->count = MAX_SPRITES;
+    for (int i = 0; i < BENCH_DIRTY_SPRITES; ++i)
+    {
+        EntityId id = 1 + RandomNext(&bench->random) % (MAX_SPRITES - 1);
+        while (entities->isDirty[id])
+        {
+            id = 1 + id % (MAX_SPRITES - 1);
+        }
+        entities->isDirty[id] = 1;
+        bench->shuffledIds[i] = id;
+    }
+    SDL_memset(entities->isDirty, 0, sizeof(entities->isDirty));
+
+    const glm::vec2 screen((float)GAME_WIDTH, (float)GAME_HEIGHT);
+    SpatialGridInit(&bench->screenGrid, screen);
+    SpatialGridInit(&bench->worldGrid,
+                    screen * (float)BENCH_GRID_WORLD_SCREENS);
+    bench->gridStep = 4.0f;
+    for (int i = 0; i < BENCH_GRID_ENTITIES; ++i)
+    {
+        glm::vec2 halfExtents(RandomRange(&bench->random, 4.0f, 16.0f));
+        glm::vec2 position(RandomRange(&bench->random, 0.0f, 1.0f),
+                           RandomRange(&bench->random, 0.0f, 1.0f));
+        EntityId entity = (EntityId)(i + 1);
+
+        SpatialGridUpdate(
+          &bench->screenGrid, entity, position * screen, halfExtents);
+
+        bench->gridCenters[i] =
+          position * screen * (float)BENCH_GRID_WORLD_SCREENS;
+        bench->gridHalfExtents[i] = halfExtents;
+        SpatialGridUpdate(
+          &bench->worldGrid, entity, bench->gridCenters[i], halfExtents);
+    }
+
+    // Stats lines, the rest of the line padded with spaces
+    char* text = bench->text;
+    for (int line = 0; line < BENCH_TEXT_LINES; ++line)
+    {
+        char* start = &text[line * BENCH_TEXT_LINE_LENGTH];
+        int length = SDL_snprintf(start,
+                                  BENCH_TEXT_LINE_LENGTH,
+                                  "Phase %02d: %7.3f ms, %6d draws, %8u bytes",
+                                  line,
+                                  RandomRange(&bench->random, 0.0f, 16.0f),
+                                  (int)(RandomNext(&bench->random) % 100000),
+                                  (unsigned)RandomNext(&bench->random));
+        SDL_memset(start + length, ' ', BENCH_TEXT_LINE_LENGTH - 1 - length);
+        start[BENCH_TEXT_LINE_LENGTH - 1] = '\n';
+    }
+    text[BENCH_TEXT_LINES * BENCH_TEXT_LINE_LENGTH] = '\0';
+    FontInitCache(&bench->font);
+
+    GpuParticleUniforms* uniforms = &bench->particleUniforms;
+    uniforms->deltaTime = 1.0f / 60.0f;
+    uniforms->damping = 1.0f - GPU_PARTICLES_DRAG * uniforms->deltaTime;
+    uniforms->gravity = GPU_PARTICLES_GRAVITY;
+    uniforms->restitution = GPU_PARTICLES_RESTITUTION;
+    uniforms->bounds = glm::vec2((float)GAME_WIDTH, (float)GAME_HEIGHT);
+    uniforms->emitter = glm::vec2(GAME_WIDTH * 0.5f, GAME_HEIGHT * 0.2f);
+    uniforms->spread = GPU_PARTICLES_SPREAD;
+    uniforms->speedMin = GPU_PARTICLES_SPEED_MIN;
+    uniforms->speedMax = GPU_PARTICLES_SPEED_MAX;
+    uniforms->lifeMin = 1e9f;
+    uniforms->lifeMax = 1e9f;
+    for (int i = 0; i < BENCH_PARTICLES; ++i)
+    {
+        bench->particles[i] = GpuParticleEmit(uniforms, (Uint32)i);
+    }
+
+    bench->imageBGR24 = CreateNoiseImage(&bench->random, SDL_PIXELFORMAT_BGR24);
+    bench->imageARGB8888 =
+      CreateNoiseImage(&bench->random, SDL_PIXELFORMAT_ARGB8888);
+    if (bench->imageBGR24 == NULL || bench->imageARGB8888 == NULL)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+internal void
+WriteResults(FILE* file)
+{
+    fprintf(file, "{\n  \"benchmarks\": [\n");
+    for (int i = 0; i < ResultCount; ++i)
+    {
+        const BenchResult* result = &Results[i];
+        fprintf(file,
+                "    {\"name\": \"%s\", \"items\": %d, \"repeats\": %d, "
+                "\"ns_per_op\": %.3f, \"items_per_sec\": %.0f}%s\n",
+                result->name,
+                result->items,
+                result->repeats,
+                result->bestSeconds * 1e9 / result->items,
+                result->items / result->bestSeconds,
+                i + 1 < ResultCount ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+// Usage: bench [results.json]
+int
+main(int argc, char** argv)
+{
+    if (!SDL_Init(0))
+    {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return -1;
+    }
+
+    BenchData* bench = (BenchData*)SDL_calloc(1, sizeof(BenchData));
+    if (bench == NULL || InitBenchData(bench) < 0)
+    {
+        return -1;
+    }
+
+    const int pixels = BENCH_IMAGE_SIZE * BENCH_IMAGE_SIZE;
+    RunBench("ball_keep_speed", BenchKeepSpeed, bench, MAX_BALLS);
+    RunBench("sprite_quads", BenchSpriteQuads, bench, MAX_BALLS);
+    RunBench("entity_mark_dirty", BenchMarkDirty, bench, BENCH_DIRTY_SPRITES);
+    RunBench("sprite_sort", BenchSortIds, bench, BENCH_DIRTY_SPRITES);
+    RunBench(
+      "sprite_ranges", BenchSpriteRanges, bench, BENCH_DIRTY_SPRITES);
+    RunBench("grid_query_screen",
+             BenchGridQueryScreen,
+             bench,
+             BENCH_GRID_ENTITIES);
+    RunBench("grid_query_world",
+             BenchGridQueryWorld,
+             bench,
+             BENCH_GRID_ENTITIES);
+    RunBench("grid_update", BenchGridUpdate, bench, BENCH_GRID_ENTITIES);
+    RunBench("font_layout",
+             BenchFontLayout,
+             bench,
+             BENCH_TEXT_LINES * BENCH_TEXT_LINE_LENGTH);
+    RunBench("gpu_particles_reference",
+             BenchSimulateParticles,
+             bench,
+             BENCH_PARTICLES);
+    RunBench("image_bgr24_to_abgr8888", BenchConvertBGR24, bench, pixels);
+    RunBench(
+      "image_argb8888_to_abgr8888", BenchConvertARGB8888, bench, pixels);
+
+    WriteResults(stdout);
+    if (argc > 1)
+    {
+        FILE* file = fopen(argv[1], "w");
+        if (file == NULL)
+        {
+            SDL_Log("Could not open %s", argv[1]);
+            return -1;
+        }
+        WriteResults(file);
+        fclose(file);
+    }
+
+    SDL_DestroySurface(bench->imageBGR24);
+    SDL_DestroySurface(bench->imageARGB8888);
+    SDL_free(bench);
+
+    SDL_Quit();
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+
+// Our code
+#include "includes.hpp"
+#include "jobs.hpp"
+
+// Job system micro-benchmark: cost of an empty job, and how a parallel-for
+// over a ball-sized integration loop scales from one worker up to every core.
+// Each worker count first checks that jobs submitted past a full queue still
+// run exactly once.
+constexpr int BENCH_EMPTY_JOBS = 1 << 20;
+constexpr int BENCH_OVERFILL_JOBS = JOBS_QUEUE_SIZE * 3 + 17;
+constexpr int BENCH_ITEMS = 1 << 20;
+constexpr int BENCH_MIN_CHUNK = 1024;
+constexpr int BENCH_REPEATS = 20;
+
+typedef struct BenchBalls
+{
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    int count;
+} BenchBalls;
+
+internal void
+EmptyJob(void* data, int start, int end, int workerIndex)
+{
+    (void)data;
+    (void)start;
+    (void)end;
+    (void)workerIndex;
+}
+
+global_variable std::atomic<int> OverfillRuns[BENCH_OVERFILL_JOBS];
+
+// Counts the runs of job start
+internal void
+CountJob(void* data, int start, int end, int workerIndex)
+{
+    (void)end;
+    (void)workerIndex;
+    std::atomic<int>* runs = (std::atomic<int>*)data;
+    runs[start].fetch_add(1, std::memory_order_relaxed);
+}
+
+// Same work per ball as a frame of movement with wall bounces
+internal void
+IntegrateBalls(void* data, int start, int end, int workerIndex)
+{
+    (void)workerIndex;
+    BenchBalls* balls = (BenchBalls*)data;
+    const float dt = 1.0f / 60.0f;
+
+    for (int i = start; i < end; ++i)
+    {
+        float x = balls->x[i] + balls->vx[i] * dt;
+        float y = balls->y[i] + balls->vy[i] * dt;
+
+        if (x < 0.0f || x > 640.0f)
+        {
+            balls->vx[i] = -balls->vx[i];
+        }
+        if (y < 0.0f || y > 360.0f)
+        {
+            balls->vy[i] = -balls->vy[i];
+        }
+
+        balls->x[i] = SDL_clamp(x, 0.0f, 640.0f);
+        balls->y[i] = SDL_clamp(y, 0.0f, 360.0f);
+    }
+}
+
+internal double
+SecondsSince(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) /
+           (double)SDL_GetPerformanceFrequency();
+}
+
+// Submits more jobs than the queue holds without waiting, the ones that do
+// not fit run inline while the queued ones keep their records
+internal bool
+CheckOverfill(JobSystem* jobs)
+{
+    std::atomic<int>* runs = OverfillRuns;
+    for (int i = 0; i < BENCH_OVERFILL_JOBS; ++i)
+    {
+        runs[i].store(0, std::memory_order_relaxed);
+    }
+
+    JobStats before = JobsGetStats(jobs);
+    JobCounter counter;
+    counter.value.store(0);
+    for (int i = 0; i < BENCH_OVERFILL_JOBS; ++i)
+    {
+        JobsRun(jobs, CountJob, runs, i, i + 1, &counter);
+    }
+    JobsWait(jobs, &counter);
+    JobStats after = JobsGetStats(jobs);
+
+    int wrong = 0;
+    for (int i = 0; i < BENCH_OVERFILL_JOBS; ++i)
+    {
+        if (runs[i].load(std::memory_order_relaxed) != 1)
+        {
+            wrong += 1;
+        }
+    }
+
+    printf("  overfill: %d jobs, %llu inline, %d not run exactly once\n",
+           BENCH_OVERFILL_JOBS,
+           (unsigned long long)(after.inlined - before.inlined),
+           wrong);
+
+    return wrong == 0;
+}
+
+internal void
+BenchEmptyJobs(JobSystem* jobs)
+{
+    JobCounter counter;
+    counter.value.store(0);
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < BENCH_EMPTY_JOBS; i += JOBS_QUEUE_SIZE / 2)
+    {
+        // Stay under the queue size so nothing runs inline
+        for (int j = 0; j < JOBS_QUEUE_SIZE / 2; ++j)
+        {
+            JobsRun(jobs, EmptyJob, NULL, 0, 1, &counter);
+        }
+        JobsWait(jobs, &counter);
+    }
+    double seconds = SecondsSince(start);
+
+    printf("  empty job: %.1f ns/job\n", seconds * 1e9 / BENCH_EMPTY_JOBS);
+}
+
+internal double
+BenchParallelFor(JobSystem* jobs, BenchBalls* balls)
+{
+    double best = 1e30;
+    for (int repeat = 0; repeat < BENCH_REPEATS; ++repeat)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        JobsParallelFor(
+          jobs, IntegrateBalls, balls, balls->count, BENCH_MIN_CHUNK, NULL);
+        best = SDL_min(best, SecondsSince(start));
+    }
+
+    return best;
+}
+
+int
+main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    if (!SDL_Init(0))
+    {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return -1;
+    }
+
+    BenchBalls balls = { 0 };
+    balls.count = BENCH_ITEMS;
+    balls.x = (float*)SDL_malloc(sizeof(float) * BENCH_ITEMS);
+    balls.y = (float*)SDL_malloc(sizeof(float) * BENCH_ITEMS);
+    balls.vx = (float*)SDL_malloc(sizeof(float) * BENCH_ITEMS);
+    balls.vy = (float*)SDL_malloc(sizeof(float) * BENCH_ITEMS);
+    for (int i = 0; i < BENCH_ITEMS; ++i)
+    {
+        balls.x[i] = (float)(i % 640);
+        balls.y[i] = (float)(i % 360);
+        balls.vx[i] = 100.0f + (float)(i % 7);
+        balls.vy[i] = 150.0f - (float)(i % 5);
+    }
+
+    int coreCount = SDL_min(SDL_GetNumLogicalCPUCores(), JOBS_MAX_WORKERS);
+    double baseline = 0.0;
+    int result = 0;
+
+    printf("%d items, best of %d runs\n", BENCH_ITEMS, BENCH_REPEATS);
+    for (int workerCount = 1; workerCount <= coreCount; ++workerCount)
+    {
+        JobSystem* jobs = (JobSystem*)SDL_calloc(1, sizeof(JobSystem));
+        if (JobsInit(jobs, workerCount) < 0)
+        {
+            SDL_free(jobs);
+            break;
+        }
+
+        if (!CheckOverfill(jobs))
+        {
+            result = 1;
+        }
+
+        BenchEmptyJobs(jobs);
+
+        double seconds = BenchParallelFor(jobs, &balls);
+        if (workerCount == 1)
+        {
+            baseline = seconds;
+        }
+
+        JobStats stats = JobsGetStats(jobs);
+        printf("  %2d workers: %8.3f ms, %5.2fx speedup, %llu stolen\n",
+               workerCount,
+               seconds * 1000.0,
+               baseline / seconds,
+               (unsigned long long)stats.stolen);
+
+        JobsShutdown(jobs);
+        SDL_free(jobs);
+    }
+
+    SDL_free(balls.x);
+    SDL_free(balls.y);
+    SDL_free(balls.vx);
+    SDL_free(balls.vy);
+
+    SDL_Quit();
+
+    return result;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <stddef.h>
+
+// Linear bump allocator over one block reserved up front. Everything pushed
+// is released at once by ArenaReset, or back to a mark by ArenaEndScope.
+// Arenas are not thread safe, each one has a single owner at a time.
+
+// Fills released memory with ARENA_POISON so stale pointers read garbage.
+// Off by default since it touches every used byte on each frame reset,
+// build with -DARENA_DEBUG=1 when hunting a stale pointer.
+#ifndef ARENA_DEBUG
+#define ARENA_DEBUG 0
+#endif
+
+const Uint8 ARENA_POISON = 0xCD;
+const size_t ARENA_DEFAULT_ALIGNMENT = 16;
+
+constexpr size_t FRAME_ARENA_CAPACITY = 4 * 1024 * 1024;
+constexpr size_t SCRATCH_ARENA_CAPACITY = 1024 * 1024;
+
+typedef struct Arena
+{
+    const char* name;
+    Uint8* base;
+    size_t capacity;
+    size_t used;
+
+    size_t lastUsed;  // Bytes in use at the last reset
+    size_t peakUsed;  // Highest lastUsed so far
+    Uint64 failures; // Pushes that did not fit
+} Arena;
+
+// Marks the arena position, everything pushed after it is released by
+// ArenaEndScope. Scopes nest.
+typedef struct ArenaScope
+{
+    Arena* arena;
+    size_t mark;
+} ArenaScope;
+
+extern int
+ArenaInit(Arena* arena, const char* name, size_t capacity);
+
+extern void
+ArenaDestroy(Arena* arena);
+
+// Returns NULL when the arena is full, memory is not cleared
+extern void*
+ArenaPush(Arena* arena, size_t size, size_t alignment);
+
+#define ArenaPushArray(arena, Type, count)                                     \
+    ((Type*)ArenaPush((arena), sizeof(Type) * (count), alignof(Type)))
+
+extern void
+ArenaReset(Arena* arena);
+
+extern ArenaScope
+ArenaBeginScope(Arena* arena);
+
+extern void
+ArenaEndScope(ArenaScope scope);
+
+extern void
+ArenaPrintStats(const Arena* arena);
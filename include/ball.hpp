@@ -2,14 +2,42 @@
 
 #include <SDL3/SDL.h>
 
+#include <glm/glm.hpp>
+
 #include <box2d/box2d.h>
 
-typedef struct Ball // @Note: Actually a rectangle
+#include "entity.hpp"
+
+constexpr int MAX_BALLS = 16384;
+
+typedef struct Ball // Circle body, drawn as an SDF circle
 {
     glm::vec2 position;
     glm::vec2 velocity;
     float radius;
+    float speed; // Launch speed, kept constant across bounces
+
+    int bounceCount;
 
     // Physics
-    b2BodyId* body;
+    EntityId entity;
+    b2BodyId bodyId;
 } Ball;
+
+// Counts a bounce and scales the velocity back to the launch speed, the
+// solver bleeds a little energy on every one. Returns whether the velocity
+// changed and the body needs it too.
+inline bool
+BallKeepSpeed(Ball* ball)
+{
+    ball->bounceCount += 1;
+
+    float speed = glm::length(ball->velocity);
+    if (speed <= 0.0f || ball->speed <= 0.0f)
+    {
+        return false;
+    }
+
+    ball->velocity = ball->velocity * (ball->speed / speed);
+    return true;
+}
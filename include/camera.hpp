@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <glm/glm.hpp>
+
+// 2D camera over the world. Everything is submitted in world space (pixels,
+// y up) and the vertex shaders apply the view projection pushed once per
+// frame, so moving the camera never touches a vertex buffer.
+//
+// WASD pans, Q and E rotate, = and - zoom, R resets. Keys are read on the
+// main thread with the simulation at rest and applied by the simulation.
+const float CAMERA_PAN_SPEED = 320.0f;   // Screen pixels per second
+const float CAMERA_ROTATE_SPEED = 1.5f;  // Radians per second
+const float CAMERA_ZOOM_SPEED = 2.0f;    // Factor per second
+const float CAMERA_ZOOM_MIN = 1.0f / 16.0f;
+const float CAMERA_ZOOM_MAX = 8.0f;
+
+typedef enum CameraKey
+{
+    CAMERA_KEY_LEFT = 1 << 0,
+    CAMERA_KEY_RIGHT = 1 << 1,
+    CAMERA_KEY_DOWN = 1 << 2,
+    CAMERA_KEY_UP = 1 << 3,
+    CAMERA_KEY_ROTATE_LEFT = 1 << 4,
+    CAMERA_KEY_ROTATE_RIGHT = 1 << 5,
+    CAMERA_KEY_ZOOM_IN = 1 << 6,
+    CAMERA_KEY_ZOOM_OUT = 1 << 7,
+} CameraKey;
+
+typedef struct Camera
+{
+    glm::vec2 position; // World point at the center of the screen
+    float zoom;         // Screen pixels per world pixel
+    float rotation;     // Radians, counter clockwise
+
+    Uint32 heldKeys; // CameraKey bits
+    bool isResetPending;
+} Camera;
+
+// Shows the game area exactly like the screen space renderer did
+extern void
+CameraInit(Camera* camera);
+
+// Returns true if the event was a camera key
+extern bool
+CameraHandleEvent(Camera* camera, const SDL_Event* event);
+
+// Simulation side
+extern void
+CameraUpdate(Camera* camera, float deltaTime);
+
+extern glm::mat4
+CameraViewProjection(const Camera* camera);
+
+// World space rectangle holding everything on screen
+extern void
+CameraBounds(const Camera* camera, glm::vec2* viewMin, glm::vec2* viewMax);
@@ -4,8 +4,31 @@
 
 #include <box2d/box2d.h>
 
+#include "arena.hpp"
 #include "ball.hpp"
+#include "camera.hpp"
+#include "debug_draw.hpp"
+#include "dynamic_resolution.hpp"
+#include "entity.hpp"
+#include "font.hpp"
+#include "frame_pacer.hpp"
+#include "frame_pipeline.hpp"
+#include "gpu_particles.hpp"
+#include "input.hpp"
+#include "jobs.hpp"
+#include "particles.hpp"
+#include "perf_hud.hpp"
+#include "physics.hpp"
+#include "post.hpp"
+#include "prop.hpp"
+#include "random.hpp"
 #include "renderer.hpp"
+#include "replay.hpp"
+#include "scenario.hpp"
+#include "shapes.hpp"
+#include "snapshot.hpp"
+#include "spatial_grid.hpp"
+#include "tilemap.hpp"
 
 typedef struct Context
 {
@@ -22,6 +45,26 @@ typedef struct Context
 
     GameRenderer Renderer;
 
+    // Frame lifetime allocations of the simulation side. There are two so
+    // the snapshot being rendered outlives the reset of the next frame.
+    Arena frameArenas[2];
+    int frameArenaIndex;
+    Arena* frameArena;
+
+    // Render side temporaries, main thread only
+    Arena scratchArena;
+
+    JobSystem jobs;
+    FramePipeline framePipeline;
+    FramePacer framePacer;
+    InputState input;
+    Camera camera;
+    ReplayState replay;
+    Scenario scenario;
+
+    // Most recently built, the renderer's only view of the simulation
+    const RenderSnapshot* renderSnapshot;
+
     // Physics
     b2WorldDef worldDef;
     b2WorldId worldId;
@@ -33,9 +76,34 @@ typedef struct Context
     b2BodyDef bodyDefRight;
 
     b2BodyId topBoxId;
-    b2Polygon topBoxPolygon;
+    b2BodyId bottomBoxId;
+    b2BodyId leftBoxId;
+    b2BodyId rightBoxId;
     b2ShapeDef groundShapeDef;
 
+    PhysicsState physics;
+    DebugDraw debugDraw;
+    GpuParticles gpuParticles;
+    ParticleSystem particles;
+    Tilemap tilemap;
+    ShapeRenderer shapes;
+    Font font;
+    PerfHud perfHud;
+    PostChain post;
+    DynamicResolution dynamicResolution;
+
+    // Simulation timers
+    Uint64 frameIndex;
+    double simulationTime;
+
     // Game data
-    Ball ball;
+    RandomState random;
+    EntityTable entities;
+    SpatialGrid spatialGrid; // Entity bounds for culling, simulation side
+    Ball balls[MAX_BALLS];
+    int ballCount;
+    Prop props[MAX_PROPS];
+    int propCount;
+
+    SimulationSnapshot* snapshot;
 } Context;
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <glm/glm.hpp>
+
+#include <box2d/box2d.h>
+
+#include "font.hpp"
+
+// Forward declaration
+struct Context;
+
+// Everything Box2D draws ends up as triangles in one vertex buffer, lines
+// are expanded to thin quads so a single pipeline covers all of it. The
+// buffers start at DEBUG_DRAW_INITIAL_VERTICES and double, up to the
+// maximum, whenever a frame did not fit; the next frame then has room.
+// A circle takes about 36 vertices.
+constexpr Uint32 DEBUG_DRAW_INITIAL_VERTICES = 1024 * 1024;
+constexpr Uint32 DEBUG_DRAW_MAX_VERTICES = 8 * 1024 * 1024;
+const int DEBUG_DRAW_CIRCLE_SEGMENTS = 12;
+const float DEBUG_DRAW_LINE_WIDTH = 1.0f;   // Pixels
+const float DEBUG_DRAW_AXIS_LENGTH = 16.0f; // Pixels
+const Uint8 DEBUG_DRAW_FILL_ALPHA = 96;
+// Text from Box2D (mass labels) goes to the font, it may use this many of
+// the frame's glyphs so text queued after it still fits
+constexpr int DEBUG_DRAW_MAX_GLYPHS = FONT_MAX_GLYPHS / 2;
+
+typedef struct PositionColorVertex
+{
+    float x, y, z;
+    Uint8 r, g, b, a;
+} PositionColorVertex;
+
+typedef struct DebugDrawStats
+{
+    int shapes;
+    Uint32 vertices;
+    Uint32 droppedVertices;
+    int strings;
+    int droppedStrings;
+} DebugDrawStats;
+
+typedef struct DebugDraw
+{
+    bool isEnabled;
+    bool isAvailable; // False if the shaders or pipeline failed to load
+
+    b2DebugDraw callbacks;
+
+    SDL_GPUGraphicsPipeline* Pipeline;
+    SDL_GPUBuffer* VertexBuffer;
+    SDL_GPUTransferBuffer* TransferBuffer;
+    Uint32 capacity;         // Vertices in both buffers
+    Uint32 requiredVertices; // Of the last frame, dropped ones included
+
+    // Points into the mapped transfer buffer while Box2D is drawing
+    PositionColorVertex* vertices;
+    Uint32 vertexCount;
+
+    // Where text goes while Box2D is drawing, in screen pixels
+    Font* font;
+    glm::mat4 viewProjection;
+
+    DebugDrawStats stats;
+} DebugDraw;
+
+extern int
+DebugDrawInit(Context* context);
+
+// Off, shapes, shapes with mass labels
+extern void
+DebugDrawToggle(Context* context);
+
+extern void
+DebugDrawBuild(Context* context);
+
+extern void
+DebugDrawUpload(Context* context, SDL_GPUCopyPass* copyPass);
+
+extern void
+DebugDrawRender(Context* context, SDL_GPURenderPass* renderPass);
+
+extern void
+DebugDrawDestroy(Context* context);
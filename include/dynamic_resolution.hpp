@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include "frame_pacer.hpp"
+
+// Forward declaration
+struct Context;
+
+// Picks the internal resolution from measured frame times. The world is
+// drawn offscreen at GAME_WIDTH x GAME_HEIGHT times a scale between
+// DYNAMIC_RESOLUTION_MIN_SCALE and the window's integer scale from
+// RendererResizeWindow, then upscaled like the post effects output.
+//
+// The measured time is the frame minus what the pacer slept and spun, so
+// a paced frame with slack reads as cheap. It is smoothed, then compared
+// against the budget with a gap between the two thresholds: the scale
+// steps down after a few frames over, and only steps back up after many
+// frames well under, and never right after a change. Steps are a tenth
+// of the scale on the DYNAMIC_RESOLUTION_STEP grid, so only a few sizes
+// ever reach the render target pool.
+const float DYNAMIC_RESOLUTION_MIN_SCALE = 0.5f;
+const float DYNAMIC_RESOLUTION_STEP = 0.125f; // 80 x 45 pixels, the grain
+const float DYNAMIC_RESOLUTION_STEP_FRACTION = 0.1f; // Of the scale
+const float DYNAMIC_RESOLUTION_SMOOTHING = 0.1f;
+const float DYNAMIC_RESOLUTION_HIGH = 0.95f; // Of the budget, steps down
+const float DYNAMIC_RESOLUTION_LOW = 0.7f;   // Of the budget, steps up
+constexpr int DYNAMIC_RESOLUTION_DOWN_FRAMES = 8;
+constexpr int DYNAMIC_RESOLUTION_UP_FRAMES = 90;
+constexpr int DYNAMIC_RESOLUTION_COOLDOWN_FRAMES = 30;
+
+typedef struct DynamicResolutionStats
+{
+    Uint64 stepsDown;
+    Uint64 stepsUp;
+    float minScale; // Lowest scale used
+} DynamicResolutionStats;
+
+typedef struct DynamicResolution
+{
+    bool isEnabled;
+    float budgetMs; // 0 follows the frame pacer's target
+
+    float scale;
+    float smoothedMs;
+    int overFrames;
+    int underFrames;
+    int cooldownFrames;
+
+    FramePacerStats lastPacer;
+
+    DynamicResolutionStats stats;
+} DynamicResolution;
+
+// Starts at native resolution, call after the window scale is known. A
+// budgetMs of 0 follows the frame pacer and leaves the controller off.
+extern void
+DynamicResolutionInit(Context* context, float budgetMs);
+
+extern void
+DynamicResolutionToggle(Context* context);
+
+// Whether the world is drawn at the controller's resolution this frame
+extern bool
+DynamicResolutionIsActive(const Context* context);
+
+// Once per loop iteration with the wall time of the previous frame
+extern void
+DynamicResolutionUpdate(Context* context, float deltaTime);
+
+// The internal resolution, GAME_WIDTH x GAME_HEIGHT when inactive
+extern void
+DynamicResolutionGetSize(const Context* context,
+                         Uint32* width,
+                         Uint32* height);
+
+extern void
+DynamicResolutionPrintStats(const DynamicResolution* controller);
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <stdint.h>
+
+// Every simulated object gets a small integer id into a dense table. Box2D
+// user data stores that id instead of a pointer, so event processing is a
+// couple of array lookups rather than a chase through game structs.
+typedef Uint32 EntityId; // 0 is the null entity
+
+constexpr int MAX_ENTITIES = 16384 + 64;
+
+typedef enum EntityKind
+{
+    ENTITY_KIND_NONE = 0,
+    ENTITY_KIND_BALL,
+    ENTITY_KIND_WALL,
+    ENTITY_KIND_BOX,    // Prop with a dynamic body
+    ENTITY_KIND_SPRITE, // Prop without physics
+} EntityKind;
+
+typedef struct EntityTable
+{
+    // Structure of arrays, indexed by EntityId
+    Uint8 kind[MAX_ENTITIES];
+    Uint32 index[MAX_ENTITIES]; // Index into the kind's own array
+
+    int count; // Slot 0 is reserved for the null entity
+
+    // Entities whose visuals changed since the renderer last consumed them
+    Uint8 isDirty[MAX_ENTITIES];
+    EntityId dirtyList[MAX_ENTITIES];
+    int dirtyCount;
+} EntityTable;
+
+inline EntityId
+EntityCreate(EntityTable* table, EntityKind kind, Uint32 index)
+{
+    if (table->count == 0)
+    {
+        table->count = 1;
+    }
+
+    if (table->count >= MAX_ENTITIES)
+    {
+        SDL_Log("Entity table is full!");
+        return 0;
+    }
+
+    EntityId id = (EntityId)table->count++;
+    table->kind[id] = (Uint8)kind;
+    table->index[id] = index;
+
+    return id;
+}
+
+inline void
+EntityMarkDirty(EntityTable* table, EntityId id)
+{
+    if (id == 0 || table->isDirty[id])
+    {
+        return;
+    }
+
+    table->isDirty[id] = 1;
+    table->dirtyList[table->dirtyCount++] = id;
+}
+
+inline void
+EntityMarkAllDirty(EntityTable* table)
+{
+    for (int id = 1; id < table->count; ++id)
+    {
+        EntityMarkDirty(table, (EntityId)id);
+    }
+}
+
+inline void
+EntityClearDirty(EntityTable* table)
+{
+    for (int i = 0; i < table->dirtyCount; ++i)
+    {
+        table->isDirty[table->dirtyList[i]] = 0;
+    }
+    table->dirtyCount = 0;
+}
+
+// qsort comparator for EntityId arrays
+inline int
+EntityCompareIds(const void* a, const void* b)
+{
+    EntityId left = *(const EntityId*)a;
+    EntityId right = *(const EntityId*)b;
+    return (left > right) - (left < right);
+}
+
+inline void*
+EntityToUserData(EntityId id)
+{
+    return (void*)(uintptr_t)id;
+}
+
+inline EntityId
+EntityFromUserData(void* userData)
+{
+    return (EntityId)(uintptr_t)userData;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include "renderer.hpp"
+
+// Forward declaration
+struct Context;
+
+// Text from an embedded 5x7 bitmap font. Glyphs are rasterized on first
+// use at the requested integer scale, with a drop shadow, into slots of an
+// atlas texture; the least recently used slot is evicted when it fills up.
+//
+// Text is laid out in screen space (GAME pixels, origin at the top left)
+// into a fixed array, so a frame of text allocates nothing. The quads go
+// into the sprite vertex buffer after the particle slots and are drawn with
+// the sprite pipeline on top of everything else.
+constexpr int FONT_FIRST_CHAR = 32;
+constexpr int FONT_CHAR_COUNT = 95; // Printable ASCII
+constexpr int FONT_GLYPH_WIDTH = 5;
+constexpr int FONT_GLYPH_HEIGHT = 7;
+constexpr int FONT_ADVANCE = 6; // Glyph and shadow, before scaling
+constexpr int FONT_LINE_HEIGHT = 9;
+constexpr int FONT_MAX_SCALE = 4;
+constexpr int FONT_MAX_GLYPHS = RENDERER_TEXT_SLOTS; // Quads per frame
+constexpr int FONT_PRINTF_MAX = 512;
+
+// Every slot fits the largest scale
+constexpr int FONT_ATLAS_SIZE = 256;
+constexpr int FONT_SLOT_WIDTH = FONT_ADVANCE * FONT_MAX_SCALE;
+constexpr int FONT_SLOT_HEIGHT = (FONT_GLYPH_HEIGHT + 1) * FONT_MAX_SCALE;
+constexpr int FONT_SLOTS_PER_ROW = FONT_ATLAS_SIZE / FONT_SLOT_WIDTH;
+constexpr int FONT_SLOT_COUNT =
+  FONT_SLOTS_PER_ROW * (FONT_ATLAS_SIZE / FONT_SLOT_HEIGHT);
+constexpr int FONT_SLOT_PIXELS = FONT_SLOT_WIDTH * FONT_SLOT_HEIGHT;
+
+typedef struct FontSlot
+{
+    Sint16 glyph; // Char index * FONT_MAX_SCALE + scale - 1, -1 if free
+    Sint16 previous; // Towards the most recently used, -1 ends
+    Sint16 next;
+    Uint64 lastUsedFrame;
+} FontSlot;
+
+typedef struct FontStats
+{
+    int glyphs; // Quads drawn
+    int hits;
+    int misses; // Rasterized into the atlas
+    int evictions;
+    int dropped; // No room in the quads or the atlas this frame
+    Uint32 uploadedBytes;
+    double layoutSeconds;
+} FontStats;
+
+typedef struct Font
+{
+    bool isAvailable;
+
+    SDL_GPUTexture* Atlas;
+    SDL_GPUTransferBuffer* TransferBuffer;      // Glyph quads, cycled
+    SDL_GPUTransferBuffer* AtlasTransferBuffer; // Pending slots, cycled
+
+    // Glyph cache, the slots form a list from the most recently used
+    FontSlot slots[FONT_SLOT_COUNT];
+    Sint16 slotFor[FONT_CHAR_COUNT * FONT_MAX_SCALE]; // -1 if not cached
+    Sint16 head;
+    Sint16 tail;
+    Uint64 frame; // Counts builds
+
+    // CPU copy of the atlas, one RGBA8 block per slot. Rasterized slots
+    // stay pending until a frame reaches the copy pass.
+    Uint32 slotPixels[FONT_SLOT_COUNT][FONT_SLOT_PIXELS];
+    Uint8 isPending[FONT_SLOT_COUNT];
+    Sint16 pendingSlots[FONT_SLOT_COUNT];
+    int pendingCount;
+
+    // Screen space quads laid out since the last build
+    PositionTextureVertex vertices[FONT_MAX_GLYPHS * 4];
+    int glyphCount;
+
+    // Render side, written by the build
+    int drawCount;
+    int uploadSlotCount;
+
+    FontStats current; // Since the last build
+    FontStats stats;   // Of the last build
+} Font;
+
+// Creates the atlas and buffers, call after the renderer's buffers exist
+extern int
+FontInit(Context* context);
+
+// Empties the glyph cache and the queued text, no GPU work
+extern void
+FontInitCache(Font* font);
+
+// Lays out a line of text, '\n' starts a new one. Scale is clamped to
+// [1, FONT_MAX_SCALE]. Returns the x after the last glyph. Call with the
+// simulation at rest.
+extern int
+FontDrawText(Font* font, int x, int y, int scale, const char* text);
+
+extern int
+FontPrintf(Font* font, int x, int y, int scale, const char* format, ...)
+  SDL_PRINTF_VARARG_FUNC(5);
+
+// Writes the queued text to the transfer buffer, call with the simulation
+// at rest
+extern void
+FontBuild(Context* context);
+
+extern void
+FontUpload(Context* context, SDL_GPUCopyPass* copyPass);
+
+// Binds the sprite pipeline and buffers with the atlas, expects the screen
+// projection to be pushed
+extern void
+FontRender(Context* context, SDL_GPURenderPass* renderPass);
+
+extern void
+FontDestroy(Context* context);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Sleeps away the slack at the end of a frame instead of letting the loop
+// spin. SDL_DelayPrecise covers all but the last FRAME_PACER_SPIN_NS, the
+// rest is spun so wake-up jitter from the scheduler does not show up in
+// frame times. Deadlines sit on a fixed grid so errors do not accumulate.
+const Uint64 FRAME_PACER_SPIN_NS = 1000000; // 1 ms
+const float FRAME_PACER_DEFAULT_FPS = 60.0f;
+
+typedef struct FramePacerStats
+{
+    Uint64 pacedFrames;
+    Uint64 missedFrames; // Already past the deadline, nothing to wait for
+
+    // Wake-up time minus deadline over the paced frames
+    double errorSum; // Nanoseconds, absolute
+    Uint64 errorMax;
+
+    Uint64 sleepNS;
+    Uint64 spinNS;
+} FramePacerStats;
+
+typedef struct FramePacer
+{
+    float targetFps; // 0 disables pacing
+    Uint64 frameNS;
+    Uint64 nextDeadline; // SDL_GetTicksNS time
+
+    Uint64 lastError; // Nanoseconds, of the most recent paced frame
+
+    FramePacerStats stats;
+} FramePacer;
+
+extern void
+FramePacerInit(FramePacer* pacer, float targetFps);
+
+extern void
+FramePacerSetTarget(FramePacer* pacer, float targetFps);
+
+// Call once per frame, after the frame has been submitted
+extern void
+FramePacerWait(FramePacer* pacer);
+
+extern void
+FramePacerPrintStats(const FramePacer* pacer);
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Forward declaration
+struct Context;
+
+// Runs the simulation of frame N+1 on its own thread while the main thread
+// records and submits frame N. The two sides only share the double
+// buffered RenderSnapshot, and they meet once per frame: everything between
+// FramePipelineWait and the next FramePipelineKick (input, debug draw) runs
+// with the simulation at rest. GPU work stays on the main thread because
+// SDL wants the swapchain acquired on the thread that created the window.
+typedef void FrameSimulateFunction(Context* context, float deltaTime);
+
+typedef struct FramePipelineStats
+{
+    Uint64 frames;
+    double inputSeconds;
+    double simulateSeconds;
+    double renderSeconds;
+    double buildSeconds; // Main thread work with the simulation at rest
+    double frameSeconds; // Simulate and render together, as the loop saw it
+} FramePipelineStats;
+
+typedef struct FramePipeline
+{
+    bool isEnabled; // False runs everything on the main thread, for debugging
+
+    Context* context;
+    FrameSimulateFunction* simulate;
+
+    SDL_Thread* thread;
+    SDL_Semaphore* startSimulation;
+    SDL_Semaphore* simulationDone;
+    bool isQuitting;
+    bool isSimulating; // Between kick and wait
+    float deltaTime;
+
+    FramePipelineStats stats;
+} FramePipeline;
+
+extern int
+FramePipelineInit(Context* context,
+                  FrameSimulateFunction* simulate,
+                  bool isEnabled);
+
+// Simulates on the calling thread
+extern void
+FramePipelineSimulate(FramePipeline* pipeline, float deltaTime);
+
+// Starts simulating on the pipeline thread
+extern void
+FramePipelineKick(FramePipeline* pipeline, float deltaTime);
+
+extern void
+FramePipelineWait(FramePipeline* pipeline);
+
+extern void
+FramePipelineDestroy(Context* context);
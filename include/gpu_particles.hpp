@@ -0,0 +1,196 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <glm/glm.hpp>
+
+// Forward declaration
+struct Context;
+
+// Particles live entirely on the GPU. Every frame a compute pass moves the
+// survivors of one storage buffer into the other through an append counter,
+// a second pass emits new particles after them and a one thread pass turns
+// the count into the indirect dispatch and draw arguments. The vertex shader
+// pulls the particles straight out of the storage buffer.
+//
+// The update is mirrored on the CPU by GpuParticlesReferenceStep, the
+// shaders in shaders/source/Particle*.hlsl have to be kept in sync with it.
+constexpr Uint32 GPU_PARTICLES_MAX_CAPACITY = 4 * 1024 * 1024;
+constexpr Uint32 GPU_PARTICLES_THREADS = 64; // numthreads of the kernels
+const float GPU_PARTICLES_MAX_DELTA_TIME = 1.0f / 20.0f;
+const float GPU_PARTICLES_GRAVITY = -240.0f; // Pixels per second squared
+const float GPU_PARTICLES_DRAG = 0.25f;      // Fraction per second
+const float GPU_PARTICLES_RESTITUTION = 0.6f;
+const float GPU_PARTICLES_SPREAD = 1.2f; // Radians around straight up
+const float GPU_PARTICLES_SPEED_MIN = 80.0f;
+const float GPU_PARTICLES_SPEED_MAX = 260.0f;
+const float GPU_PARTICLES_LIFE_MIN = 1.0f; // Seconds
+const float GPU_PARTICLES_LIFE_MAX = 4.0f;
+const float GPU_PARTICLES_VALIDATE_TOLERANCE = 0.05f; // Pixels
+constexpr Uint32 GPU_PARTICLES_VALIDATE_CAPACITY = 64 * 1024;
+const int GPU_PARTICLES_VALIDATE_FRAMES = 240;
+
+// Matches the Particle struct of the shaders
+typedef struct GpuParticle
+{
+    glm::vec2 position;
+    glm::vec2 velocity;
+    float life; // Seconds left
+    float size; // Half extent in pixels
+    Uint32 color;
+    Uint32 id;
+} GpuParticle;
+
+// Matches the UniformBlock cbuffer of the shaders, every kernel and the
+// vertex shader get the same block
+typedef struct GpuParticleUniforms
+{
+    float deltaTime;
+    float damping; // Velocity scale for this step
+    float gravity;
+    float restitution;
+    glm::vec2 bounds;
+    Uint32 capacity;
+    Uint32 emitCount;
+    glm::vec2 emitter;
+    Uint32 firstId; // Id of the first particle emitted this step
+    float spread;
+    float speedMin;
+    float speedMax;
+    float lifeMin;
+    float lifeMax;
+} GpuParticleUniforms;
+
+typedef struct GpuParticles
+{
+    bool isAvailable; // False if disabled or the pipelines failed to load
+
+    SDL_GPUComputePipeline* SimulatePipeline;
+    SDL_GPUComputePipeline* EmitPipeline;
+    SDL_GPUComputePipeline* FinalizePipeline;
+    SDL_GPUGraphicsPipeline* RenderPipeline;
+
+    // Ping-pong state, current holds the particles of the last update
+    SDL_GPUBuffer* ParticleBuffers[2];
+    int current;
+
+    // [0] live particles, [1] append counter of the running update
+    SDL_GPUBuffer* CounterBuffer;
+    // Indirect dispatch arguments followed by the indirect draw arguments
+    SDL_GPUBuffer* ArgumentBuffer;
+
+    Uint32 capacity;
+    float emitRate; // Particles per second
+    float emitRemainder;
+    Uint32 nextId;
+    Uint64 lastCounter;
+
+    GpuParticleUniforms uniforms; // Of the last update
+} GpuParticles;
+
+// PCG hash, the shaders use the same one so both sides emit alike
+inline Uint32
+GpuParticleHash(Uint32 value)
+{
+    Uint32 state = value * 747796405u + 2891336453u;
+    Uint32 word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+// [0, 1) from the top 24 bits
+inline float
+GpuParticleUnit(Uint32 value)
+{
+    return (float)(value >> 8) * (1.0f / 16777216.0f);
+}
+
+inline GpuParticle
+GpuParticleEmit(const GpuParticleUniforms* uniforms, Uint32 index)
+{
+    GpuParticle particle;
+    particle.id = uniforms->firstId + index;
+
+    Uint32 hash = GpuParticleHash(particle.id);
+    float angle =
+      1.5707963f + (GpuParticleUnit(hash) - 0.5f) * uniforms->spread;
+    hash = GpuParticleHash(hash);
+    float speed =
+      uniforms->speedMin +
+      GpuParticleUnit(hash) * (uniforms->speedMax - uniforms->speedMin);
+    hash = GpuParticleHash(hash);
+    particle.life =
+      uniforms->lifeMin +
+      GpuParticleUnit(hash) * (uniforms->lifeMax - uniforms->lifeMin);
+    hash = GpuParticleHash(hash);
+    particle.size = 0.5f + GpuParticleUnit(hash);
+    particle.color = 0xFF000000u | (GpuParticleHash(hash) & 0x00FFFFFFu);
+
+    particle.position = uniforms->emitter;
+    particle.velocity =
+      glm::vec2(SDL_cosf(angle) * speed, SDL_sinf(angle) * speed);
+
+    return particle;
+}
+
+// Returns false once the particle has died
+inline bool
+GpuParticleSimulate(const GpuParticleUniforms* uniforms, GpuParticle* particle)
+{
+    particle->life -= uniforms->deltaTime;
+    if (particle->life <= 0.0f)
+    {
+        return false;
+    }
+
+    particle->velocity.y += uniforms->gravity * uniforms->deltaTime;
+    particle->velocity *= uniforms->damping;
+    particle->position += particle->velocity * uniforms->deltaTime;
+
+    // Reflect off the edges of the game area
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        float bound = uniforms->bounds[axis];
+        if (particle->position[axis] < 0.0f)
+        {
+            particle->position[axis] = -particle->position[axis];
+            particle->velocity[axis] *= -uniforms->restitution;
+        }
+        else if (particle->position[axis] > bound)
+        {
+            particle->position[axis] = 2.0f * bound - particle->position[axis];
+            particle->velocity[axis] *= -uniforms->restitution;
+        }
+    }
+
+    return true;
+}
+
+// emitRate 0 picks the rate that keeps the buffer about full
+extern int
+GpuParticlesInit(Context* context, Uint32 capacity, float emitRate);
+
+// Records the compute passes, call outside of any other pass
+extern void
+GpuParticlesDispatch(Context* context, SDL_GPUCommandBuffer* cmdbuf);
+
+extern void
+GpuParticlesRender(Context* context,
+                   SDL_GPUCommandBuffer* cmdbuf,
+                   SDL_GPURenderPass* renderPass);
+
+// CPU version of one update: survivors of in, in order, then the emitted
+// particles. Returns the number written to out.
+extern Uint32
+GpuParticlesReferenceStep(const GpuParticleUniforms* uniforms,
+                          const GpuParticle* in,
+                          Uint32 inCount,
+                          GpuParticle* out);
+
+// Runs frameCount fixed steps on the GPU and the CPU and compares the
+// results, 0 if they match
+extern int
+GpuParticlesValidate(Context* context, int frameCount);
+
+extern void
+GpuParticlesDestroy(Context* context);
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+// Keyboard and mouse button events are kept with their SDL timestamps. The
+// newest one rides along with the frame that consumes it (through the
+// RenderSnapshot), and the time from the event to SDL_SubmitGPUCommandBuffer
+// for that frame goes into a histogram for the active present mode.
+constexpr int INPUT_RING_SIZE = 256;
+constexpr int INPUT_LATENCY_BUCKETS = 100;
+const double INPUT_LATENCY_BUCKET_MS = 0.5; // Last bucket takes the rest
+constexpr int INPUT_PRESENT_MODE_COUNT = 3; // SDL_GPUPresentMode values
+
+typedef struct InputEvent
+{
+    Uint64 timestamp; // Nanoseconds, SDL_GetTicksNS time base
+    Uint32 type;
+    Uint32 code; // Keycode or mouse button
+} InputEvent;
+
+typedef struct InputLatencyHistogram
+{
+    Uint32 buckets[INPUT_LATENCY_BUCKETS];
+    Uint64 count;
+    double sumMs;
+    double maxMs;
+} InputLatencyHistogram;
+
+typedef struct InputState
+{
+    InputEvent ring[INPUT_RING_SIZE];
+    Uint64 eventCount; // Total recorded, the ring holds the newest ones
+
+    // Newest event no frame has picked up yet, 0 if there is none
+    Uint64 pendingTimestamp;
+
+    InputLatencyHistogram latency[INPUT_PRESENT_MODE_COUNT];
+} InputState;
+
+// Returns false for events that are not player input
+extern bool
+InputRecordEvent(InputState* input, const SDL_Event* event);
+
+// Hands the pending timestamp to the frame being built
+extern Uint64
+InputTakeTimestamp(InputState* input);
+
+extern void
+InputRecordLatency(InputState* input,
+                   SDL_GPUPresentMode presentMode,
+                   Uint64 inputTimestamp);
+
+extern void
+InputPrintLatency(const InputState* input);
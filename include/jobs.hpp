@@ -0,0 +1,105 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <atomic>
+
+// Work stealing job system. Every worker (the main thread is worker 0) owns
+// a Chase-Lev deque: the owner pushes and pops at the bottom, idle workers
+// steal from the top. Completion is tracked with atomic counters that any
+// worker can wait on while helping to run jobs. Outside of the job workers
+// only one thread at a time may submit or wait, it stands in as worker 0.
+constexpr int JOBS_MAX_WORKERS = 64;
+constexpr int JOBS_QUEUE_SIZE = 4096; // Power of two, jobs per worker
+
+// Runs items [start, end) of a job. workerIndex is in [0, workerCount).
+typedef void JobFunction(void* data, int start, int end, int workerIndex);
+
+typedef struct JobCounter
+{
+    std::atomic<int> value;
+} JobCounter;
+
+typedef struct Job
+{
+    JobFunction* function;
+    void* data;
+    int start;
+    int end;
+    JobCounter* counter;
+} Job;
+
+typedef struct JobDeque
+{
+    alignas(64) std::atomic<Sint64> top;
+    alignas(64) std::atomic<Sint64> bottom;
+    alignas(64) std::atomic<Job*> buffer[JOBS_QUEUE_SIZE];
+} JobDeque;
+
+typedef struct JobStats
+{
+    Uint64 executed;
+    Uint64 stolen;
+    Uint64 inlined; // Queue was full, ran on the submitting thread
+} JobStats;
+
+typedef struct JobWorker
+{
+    JobDeque deque;
+
+    // Job records, one per deque slot and only written by the owning
+    // thread while the slot is empty
+    Job pool[JOBS_QUEUE_SIZE];
+
+    struct JobSystem* system;
+    SDL_Thread* thread;
+    int index;
+    Uint32 randomState; // Victim selection when stealing
+
+    JobStats stats;
+} JobWorker;
+
+typedef struct JobSystem
+{
+    JobWorker* workers; // workerCount entries, 0 is the main thread
+    int workerCount;
+
+    SDL_Semaphore* wakeup;
+    std::atomic<bool> isRunning;
+} JobSystem;
+
+// workerCount includes the calling thread, 0 picks one per logical core
+extern int
+JobsInit(JobSystem* jobs, int workerCount);
+
+extern void
+JobsShutdown(JobSystem* jobs);
+
+extern void
+JobsRun(JobSystem* jobs,
+        JobFunction* function,
+        void* data,
+        int start,
+        int end,
+        JobCounter* counter);
+
+// Splits [0, count) into chunks of at least minChunk items, a few chunks
+// per worker so stealing can balance uneven work. A NULL counter makes the
+// call block until the whole range is done.
+extern void
+JobsParallelFor(JobSystem* jobs,
+                JobFunction* function,
+                void* data,
+                int count,
+                int minChunk,
+                JobCounter* counter);
+
+// Runs other jobs until the counter reaches zero
+extern void
+JobsWait(JobSystem* jobs, JobCounter* counter);
+
+extern int
+JobsCurrentWorker(void);
+
+extern JobStats
+JobsGetStats(JobSystem* jobs);
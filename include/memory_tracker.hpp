@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <atomic>
+
+// Every SDL_malloc goes through here once MemoryTrackerInstall has run, and
+// Box2D and stb_image are routed through SDL_malloc. Allocations are
+// charged to the calling thread's current tag, anything untagged counts as
+// SDL internal.
+typedef enum MemoryTag
+{
+    MEMORY_TAG_SDL = 0,
+    MEMORY_TAG_GAME,
+    MEMORY_TAG_RENDERER,
+    MEMORY_TAG_ASSETS,
+    MEMORY_TAG_PHYSICS,
+    MEMORY_TAG_STB,
+
+    MEMORY_TAG_COUNT,
+} MemoryTag;
+
+// Frames after startup (or after a spawn or restore) before strict mode
+// considers the loop to be in its steady state
+constexpr int MEMORY_WARMUP_FRAMES = 120;
+
+typedef struct MemoryTagStats
+{
+    std::atomic<Sint64> liveBytes;
+    std::atomic<Sint64> peakBytes;
+    std::atomic<Uint64> allocations;
+    std::atomic<Uint64> allocatedBytes;
+
+    Uint64 frameStartAllocations;
+    Uint64 lastFrameAllocations;
+} MemoryTagStats;
+
+typedef struct MemoryTracker
+{
+    bool isInstalled;
+    bool isStrict; // Trap on allocations in the steady state frame loop
+
+    MemoryTagStats tags[MEMORY_TAG_COUNT];
+
+    // All tags together, the tag peaks happen at different times
+    std::atomic<Sint64> liveBytes;
+    std::atomic<Sint64> peakBytes;
+
+    Uint64 frames;
+    int warmupFrames; // Left before the steady state
+    std::atomic<bool> isInFrame;
+} MemoryTracker;
+
+extern const char* MemoryTagNames[];
+
+// Call before anything else touches SDL
+extern bool
+MemoryTrackerInstall(bool isStrict);
+
+// Returns the previous tag for MemoryPopTag
+extern MemoryTag
+MemoryPushTag(MemoryTag tag);
+
+extern void
+MemoryPopTag(MemoryTag previous);
+
+// For callers that cannot set a tag around the allocation, like stb_image
+extern void*
+MemoryTaggedMalloc(MemoryTag tag, size_t size);
+
+extern void*
+MemoryTaggedRealloc(MemoryTag tag, void* mem, size_t size);
+
+// Brackets the part of the loop strict mode watches
+extern void
+MemoryTrackerBeginFrame(void);
+
+extern void
+MemoryTrackerEndFrame(void);
+
+// Something legitimately grew (spawned bodies, a rebuilt world)
+extern void
+MemoryTrackerRestartWarmup(void);
+
+extern const MemoryTracker*
+MemoryTrackerGet(void);
+
+extern void
+MemoryTrackerPrint(void);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <glm/glm.hpp>
+
+// Forward declaration
+struct Context;
+
+// CPU particles for machines where the compute shader particles are not an
+// option. State is stored as separate arrays so the update runs eight
+// particles at a time with AVX2, falling back to scalar code without it.
+// The array is split into fixed chunks that the job system updates in
+// parallel; each chunk swap-removes its own dead particles and the holes
+// left between chunks are then filled from the end of the array.
+//
+// The quads go into the sprite vertex buffer, in the slots the renderer
+// keeps after the entity sprites (GameRenderer.particleSlotCount).
+constexpr int PARTICLES_MAX_CAPACITY = 1024 * 1024;
+constexpr int PARTICLES_CHUNK_SIZE = 4096; // Multiple of the 8 AVX2 lanes
+constexpr int PARTICLES_QUAD_MIN_CHUNK = 8192;
+const float PARTICLES_GRAVITY = -240.0f; // Pixels per second squared
+const float PARTICLES_DRAG = 0.5f;       // Fraction per second
+const float PARTICLES_RESTITUTION = 0.5f;
+const float PARTICLES_SPEED_MIN = 40.0f;
+const float PARTICLES_SPEED_MAX = 220.0f;
+const float PARTICLES_LIFE_MIN = 0.5f; // Seconds
+const float PARTICLES_LIFE_MAX = 2.5f;
+const float PARTICLES_HALF_SIZE = 1.0f; // Pixels
+
+typedef struct ParticleStats
+{
+    int alive;
+    int emitted;
+    int died;
+    int moved; // Copies made by the compaction between chunks
+    double updateSeconds;
+} ParticleStats;
+
+typedef struct ParticleSystem
+{
+    bool isEnabled;
+    bool hasAvx2;
+
+    int capacity; // Rounded up to a multiple of 8
+    int count;
+
+    // One aligned block, capacity entries per array
+    float* positionX;
+    float* positionY;
+    float* velocityX;
+    float* velocityY;
+    float* life;
+    int* chunkAlive;
+
+    glm::vec2 emitter;
+    float emitRate; // Particles per second
+    float emitRemainder;
+
+    // Render side, written with the simulation at rest
+    SDL_GPUTransferBuffer* TransferBuffer;
+    int drawCount;
+
+    ParticleStats stats;
+} ParticleSystem;
+
+// The capacity in use, whole 8 particle AVX2 rows
+inline int
+ParticlesRoundCapacity(int capacity)
+{
+    return (capacity + 7) & ~7;
+}
+
+// GameRenderer.particleSlotCount has to cover the rounded capacity, it is
+// set before the renderer creates its buffers
+extern int
+ParticlesInit(Context* context, int capacity, float emitRate);
+
+// Simulation side
+extern void
+ParticlesUpdate(Context* context, float deltaTime);
+
+// Writes the quads into the transfer buffer, call with the simulation at
+// rest. They are drawn by the next frame.
+extern void
+ParticlesBuild(Context* context);
+
+extern void
+ParticlesUpload(Context* context, SDL_GPUCopyPass* copyPass);
+
+extern void
+ParticlesDestroy(Context* context);
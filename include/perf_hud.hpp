@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include "frame_pacer.hpp"
+#include "frame_pipeline.hpp"
+
+// Forward declaration
+struct Context;
+
+// Overlay with a rolling frame time graph, the CPU time of each phase of
+// the loop and what the last frame drew, uploaded and allocated. F12
+// toggles it. The panel and graphs are one batch of colored triangles
+// drawn with the debug draw pipeline, the numbers go through the font.
+// Both are drawn last, in screen pixels.
+constexpr int PERF_HUD_HISTORY = 160; // Frames in the graph, a pixel each
+constexpr int PERF_HUD_MAX_QUADS = 256;
+constexpr int PERF_HUD_GRAPH_HEIGHT = 40;
+const float PERF_HUD_GRAPH_BUDGETS = 2.0f; // Frame budgets up the graph
+const float PERF_HUD_SMOOTHING = 0.1f;     // Weight of the newest frame
+
+typedef enum PerfHudPhase
+{
+    PERF_HUD_PHASE_INPUT = 0,
+    PERF_HUD_PHASE_SIMULATE,
+    PERF_HUD_PHASE_RENDER,
+    PERF_HUD_PHASE_BUILD, // Everything built with the simulation at rest
+    PERF_HUD_PHASE_WAIT,  // Frame pacer sleep and spin
+
+    PERF_HUD_PHASE_COUNT,
+} PerfHudPhase;
+
+typedef struct PerfHud
+{
+    bool isEnabled;
+    bool isAvailable; // False without the debug draw pipeline
+
+    SDL_GPUBuffer* VertexBuffer;
+    SDL_GPUTransferBuffer* TransferBuffer; // Cycled
+
+    // Milliseconds, the history is a ring ending at cursor - 1
+    float frameMs[PERF_HUD_HISTORY];
+    int cursor;
+    int sampleCount;
+    float phaseMs[PERF_HUD_PHASE_COUNT]; // Smoothed
+
+    // Totals at the previous frame, the phases are the difference
+    FramePipelineStats lastPipeline;
+    FramePacerStats lastPacer;
+
+    // Render side, written by the build
+    Uint32 vertexCount;
+
+    double buildSeconds; // The overlay's own cost, of the last build
+} PerfHud;
+
+extern const char* PerfHudPhaseNames[];
+
+// Call after the debug draw pipeline and the font exist
+extern int
+PerfHudInit(Context* context);
+
+// Once per loop iteration with the wall time of the previous frame,
+// enabled or not, so the graph is full when it is turned on
+extern void
+PerfHudRecordFrame(Context* context, float deltaTime);
+
+// Writes the graphs and queues the text, call with the simulation at rest
+// and before FontBuild
+extern void
+PerfHudBuild(Context* context);
+
+extern void
+PerfHudUpload(Context* context, SDL_GPUCopyPass* copyPass);
+
+// Expects the screen projection to be pushed
+extern void
+PerfHudRender(Context* context, SDL_GPURenderPass* renderPass);
+
+extern void
+PerfHudDestroy(Context* context);
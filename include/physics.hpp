@@ -0,0 +1,149 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <box2d/box2d.h>
+
+#include "entity.hpp"
+#include "jobs.hpp"
+
+// Forward declaration
+struct Context;
+struct Ball;
+struct Prop;
+
+// Box2D is tuned for meter sized objects, the game works in pixels
+const float PHYSICS_PIXELS_PER_METER = 64.0f;
+const float PHYSICS_TIMESTEP = 1.0f / 60.0f;
+const int PHYSICS_SUBSTEPS = 4;
+const int PHYSICS_MAX_STEPS_PER_FRAME = 4;
+const float PHYSICS_WALL_THICKNESS = 16.0f; // Pixels
+
+constexpr int PHYSICS_MAX_EVENTS = 8192;
+constexpr int PHYSICS_MAX_TASKS = 64; // Box2D tasks per step on the job system
+
+typedef enum PhysicsWall
+{
+    PHYSICS_WALL_TOP = 0,
+    PHYSICS_WALL_BOTTOM,
+    PHYSICS_WALL_LEFT,
+    PHYSICS_WALL_RIGHT,
+
+    PHYSICS_WALL_COUNT,
+} PhysicsWall;
+
+// Everything needed to recreate a body and its single shape. The shape
+// follows from the entity kind: balls are circles with a radius of
+// halfExtents.x, walls are boxes.
+typedef struct PhysicsBodyDesc
+{
+    EntityId entity;
+    Uint8 type; // b2BodyType
+    bool isAwake;
+    glm::vec2 position; // Pixels
+    glm::vec2 velocity; // Pixels per second
+    glm::vec2 halfExtents;
+    b2Rot rotation;
+    float angularVelocity;
+} PhysicsBodyDesc;
+
+typedef enum PhysicsEventType
+{
+    PHYSICS_EVENT_CONTACT_BEGIN = 0,
+    PHYSICS_EVENT_CONTACT_END,
+    PHYSICS_EVENT_CONTACT_HIT,
+    PHYSICS_EVENT_SENSOR_BEGIN,
+    PHYSICS_EVENT_SENSOR_END,
+
+    PHYSICS_EVENT_TYPE_COUNT,
+} PhysicsEventType;
+
+// Pointer free copy of a Box2D contact or sensor event. For sensor events
+// entityA is the sensor and entityB the visiting shape.
+typedef struct PhysicsEvent
+{
+    Uint32 type;
+    EntityId entityA;
+    EntityId entityB;
+    float approachSpeed; // Hit events only, pixels per second
+} PhysicsEvent;
+
+typedef struct PhysicsEventCounters
+{
+    int counts[PHYSICS_EVENT_TYPE_COUNT];
+    int total;
+    int dropped; // Did not fit into the event array
+} PhysicsEventCounters;
+
+// One Box2D parallel loop running on the job system
+typedef struct PhysicsTask
+{
+    b2TaskCallback* callback;
+    void* taskContext;
+    JobCounter counter;
+} PhysicsTask;
+
+typedef struct PhysicsState
+{
+    float accumulator;
+    Uint64 stepCount;
+    int stepsThisFrame;
+
+    // Filled once per step, consumed by gameplay once per frame. Allocated
+    // from the frame arena.
+    PhysicsEvent* events;
+    int eventCount;
+    int eventCapacity;
+
+    PhysicsEventCounters lastStep;
+    PhysicsEventCounters lastFrame;
+    PhysicsEventCounters total;
+
+    // Reset before every step, Box2D runs anything past the limit inline
+    PhysicsTask tasks[PHYSICS_MAX_TASKS];
+    int taskCount;
+
+    glm::vec2 wallCenters[PHYSICS_WALL_COUNT];
+    glm::vec2 wallHalfExtents[PHYSICS_WALL_COUNT];
+} PhysicsState;
+
+extern const char* PhysicsEventNames[];
+
+inline float
+PhysicsToMeters(float pixels)
+{
+    return pixels / PHYSICS_PIXELS_PER_METER;
+}
+
+inline float
+PhysicsToPixels(float meters)
+{
+    return meters * PHYSICS_PIXELS_PER_METER;
+}
+
+extern int
+PhysicsInit(Context* context);
+
+extern int
+PhysicsCreateBall(Context* context, Ball* ball);
+
+// Gives a prop that already has its entity a dynamic box body
+extern int
+PhysicsCreateBox(Context* context, Prop* prop, glm::vec2 velocity);
+
+extern b2BodyId
+PhysicsCreateBody(Context* context, const PhysicsBodyDesc* desc);
+
+extern bool
+PhysicsDescribeBody(Context* context, EntityId entity, PhysicsBodyDesc* desc);
+
+extern void
+PhysicsRebuildWorld(Context* context,
+                    const PhysicsBodyDesc* bodies,
+                    int bodyCount);
+
+extern void
+PhysicsStep(Context* context, float deltaTime);
+
+extern void
+PhysicsDestroy(Context* context);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+// Forward declaration
+struct Context;
+
+// Full screen effects on the internal resolution image, before it is
+// upscaled to the swapchain, so their cost does not grow with the window.
+// With any effect on, the world is drawn into a pooled target at the
+// internal resolution (GAME_WIDTH x GAME_HEIGHT unless dynamic resolution
+// picks another); each effect is a pass into the other of two pooled
+// targets, and the last one is upscaled into the letterbox of the window.
+// Bloom blurs a half size bright pass, grading looks colors up in a LUT
+// built at init. Overlays are drawn after the upscale and are left alone.
+//
+// SDL_GPU has no timestamp queries, the per effect time is the CPU cost of
+// recording its passes.
+constexpr int POST_LUT_SIZE = 16; // Cells per side of the 3D LUT
+const float POST_BLOOM_THRESHOLD = 0.6f;
+const float POST_BLOOM_STRENGTH = 0.8f;
+const float POST_GRADE_AMOUNT = 1.0f;
+const float POST_SCANLINE_STRENGTH = 0.25f;
+const float POST_VIGNETTE = 0.3f;
+
+// In chain order
+typedef enum PostEffect
+{
+    POST_EFFECT_BLOOM = 0,
+    POST_EFFECT_GRADE,
+    POST_EFFECT_SCANLINES,
+
+    POST_EFFECT_COUNT,
+} PostEffect;
+
+typedef struct PostStats
+{
+    double effectSeconds[POST_EFFECT_COUNT]; // Of the last frame, 0 if off
+    double upscaleSeconds;
+    int passes;
+} PostStats;
+
+typedef struct PostChain
+{
+    bool isAvailable;
+    bool isEffectEnabled[POST_EFFECT_COUNT];
+
+    SDL_GPUGraphicsPipeline* CopyPipeline; // Into the swapchain
+    SDL_GPUGraphicsPipeline* BrightPipeline;
+    SDL_GPUGraphicsPipeline* BlurPipeline;
+    SDL_GPUGraphicsPipeline* BloomPipeline;
+    SDL_GPUGraphicsPipeline* GradePipeline;
+    SDL_GPUGraphicsPipeline* ScanlinePipeline;
+    SDL_GPUTexture* Lut; // POST_LUT_SIZE slices side by side
+
+    PostStats stats;
+} PostChain;
+
+extern const char* PostEffectNames[];
+
+// Call after the samplers exist. Effects in enabledEffects (a bit per
+// PostEffect) start on.
+extern int
+PostInit(Context* context, Uint32 enabledEffects);
+
+// Whether the frame should be drawn offscreen at all
+extern bool
+PostIsActive(const Context* context);
+
+extern void
+PostToggleEffect(Context* context, PostEffect effect);
+
+// Runs the enabled effects on the width x height internal image, the
+// returned texture holds the result and may be the image itself. Targets
+// come from the renderer's pool, the image may be handed back to it.
+extern SDL_GPUTexture*
+PostRender(Context* context,
+           SDL_GPUCommandBuffer* cmdbuf,
+           SDL_GPUTexture* image,
+           Uint32 width,
+           Uint32 height);
+
+// Draws the image over the render pass's viewport, point sampled unless
+// filtered
+extern void
+PostUpscale(Context* context,
+            SDL_GPURenderPass* renderPass,
+            SDL_GPUTexture* image,
+            bool isFiltered);
+
+extern void
+PostDestroy(Context* context);
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_USE_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PROFILER_USE_TSC 1
+#else
+#define PROFILER_USE_TSC 0
+#endif
+
+// Scoped zones are appended to a ring buffer owned by the thread that ran
+// them, so recording never takes a lock. Each thread keeps its newest
+// PROFILER_EVENTS_PER_THREAD zones, ProfilerWriteTrace turns them into
+// Chrome trace event JSON for chrome://tracing or Perfetto.
+constexpr int PROFILER_MAX_THREADS = 80;
+constexpr Uint32 PROFILER_EVENTS_PER_THREAD = 1 << 15; // Power of two
+
+typedef struct ProfileEvent
+{
+    const char* name; // Must outlive the profiler, string literals
+    Uint64 start;
+    Uint64 end;
+} ProfileEvent;
+
+typedef struct ProfileThread
+{
+    char name[32];
+    int index;
+
+    // Written by the owning thread only, read when the trace is written
+    std::atomic<Uint64> count;
+    ProfileEvent events[PROFILER_EVENTS_PER_THREAD];
+} ProfileThread;
+
+extern std::atomic<bool> ProfilerIsEnabled;
+extern thread_local ProfileThread* ProfilerCurrentThread;
+
+extern int
+ProfilerInit(void);
+
+extern void
+ProfilerShutdown(void);
+
+// Names the calling thread in the trace, registering it if needed
+extern void
+ProfilerSetThreadName(const char* name);
+
+extern ProfileThread*
+ProfilerRegisterThread(void);
+
+// Returns 0 on success
+extern int
+ProfilerWriteTrace(const char* path);
+
+inline Uint64
+ProfilerTimestamp(void)
+{
+#if PROFILER_USE_TSC
+    return __rdtsc();
+#else
+    return SDL_GetPerformanceCounter();
+#endif
+}
+
+inline void
+ProfilerRecord(const char* name, Uint64 start, Uint64 end)
+{
+    ProfileThread* thread = ProfilerCurrentThread;
+    if (thread == NULL)
+    {
+        thread = ProfilerRegisterThread();
+        if (thread == NULL)
+        {
+            return;
+        }
+    }
+
+    Uint64 count = thread->count.load(std::memory_order_relaxed);
+    ProfileEvent* event =
+      &thread->events[count & (PROFILER_EVENTS_PER_THREAD - 1)];
+    event->name = name;
+    event->start = start;
+    event->end = end;
+    thread->count.store(count + 1, std::memory_order_release);
+}
+
+struct ProfileScope
+{
+    const char* name;
+    Uint64 start;
+
+    ProfileScope(const char* zoneName)
+      : name(zoneName)
+      , start(ProfilerIsEnabled.load(std::memory_order_relaxed)
+                ? ProfilerTimestamp()
+                : 0)
+    {
+    }
+
+    ~ProfileScope()
+    {
+        if (start != 0)
+        {
+            ProfilerRecord(name, start, ProfilerTimestamp());
+        }
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name)                                                     \
+    ProfileScope PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <box2d/box2d.h>
+
+#include "entity.hpp"
+
+constexpr int MAX_PROPS = 16384;
+
+// Scenery spawned by scenarios. Boxes are dynamic Box2D bodies that do not
+// rotate, static sprites have no body at all.
+typedef struct Prop
+{
+    glm::vec2 position;
+    glm::vec2 halfExtents;
+
+    // Physics, null for static sprites
+    EntityId entity;
+    b2BodyId bodyId;
+} Prop;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// PCG32, small enough to live in the simulation state and be snapshotted
+typedef struct RandomState
+{
+    Uint64 state;
+    Uint64 increment;
+} RandomState;
+
+inline Uint32
+RandomNext(RandomState* random)
+{
+    Uint64 oldState = random->state;
+    random->state = oldState * 6364136223846793005ULL + random->increment;
+
+    Uint32 xorShifted = (Uint32)(((oldState >> 18u) ^ oldState) >> 27u);
+    Uint32 rotation = (Uint32)(oldState >> 59u);
+
+    return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+}
+
+inline void
+RandomSeed(RandomState* random, Uint64 seed)
+{
+    random->state = 0;
+    random->increment = (seed << 1u) | 1u;
+    RandomNext(random);
+    random->state += seed;
+    RandomNext(random);
+}
+
+// Uniform float in [min, max)
+inline float
+RandomRange(RandomState* random, float min, float max)
+{
+    float unit = (RandomNext(random) >> 8) * (1.0f / 16777216.0f);
+    return min + (max - min) * unit;
+}
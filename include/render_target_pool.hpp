@@ -0,0 +1,97 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+// Offscreen textures for passes that only live within a frame. A pass
+// acquires a target by descriptor and gets back any pooled texture that
+// matches and that the GPU is done with, or a new one. Everything acquired
+// is handed back at the end of the frame, or earlier with
+// RenderTargetPoolRelease so a later pass of the same frame can reuse it.
+//
+// Each submitted frame leaves a fence; a texture is only handed out again
+// once the frame that last used it has signaled, so the next frame never
+// waits on the one still in flight. Targets unused for a while are
+// released, a window resize does not leave the old sizes behind.
+constexpr int RENDER_TARGET_POOL_MAX_TARGETS = 32;
+constexpr int RENDER_TARGET_POOL_MAX_FRAMES = 4; // Fences in flight
+constexpr Uint64 RENDER_TARGET_POOL_IDLE_FRAMES = 120;
+
+typedef struct RenderTargetDesc
+{
+    Uint32 width;
+    Uint32 height;
+    SDL_GPUTextureFormat format;
+    SDL_GPUTextureUsageFlags usage;
+} RenderTargetDesc;
+
+typedef struct RenderTarget
+{
+    RenderTargetDesc desc;
+    SDL_GPUTexture* texture; // NULL if the entry is free
+    Uint64 bytes;
+    bool isAcquired;
+    Uint64 lastUsedFrame;
+} RenderTarget;
+
+typedef struct RenderTargetFrame
+{
+    SDL_GPUFence* fence;
+    Uint64 frame;
+} RenderTargetFrame;
+
+typedef struct RenderTargetPoolStats
+{
+    int liveTargets;
+    Uint64 liveBytes; // VRAM held by the pool
+    Uint64 peakBytes;
+    Uint64 created;
+    Uint64 reused;
+    Uint64 evicted;
+    Uint64 failures; // Acquires with the pool full
+    Uint64 fenceWaits; // Frames that found every fence slot taken
+} RenderTargetPoolStats;
+
+typedef struct RenderTargetPool
+{
+    SDL_GPUDevice* device;
+
+    RenderTarget targets[RENDER_TARGET_POOL_MAX_TARGETS];
+
+    // Submitted frames, oldest first
+    RenderTargetFrame pending[RENDER_TARGET_POOL_MAX_FRAMES];
+    int pendingCount;
+
+    Uint64 frame; // Counts RenderTargetPoolBeginFrame
+    Uint64 completedFrame; // Newest frame the GPU has finished
+
+    RenderTargetPoolStats stats;
+} RenderTargetPool;
+
+extern void
+RenderTargetPoolInit(RenderTargetPool* pool, SDL_GPUDevice* device);
+
+// Waits for the GPU and releases every texture
+extern void
+RenderTargetPoolDestroy(RenderTargetPool* pool);
+
+// Retires the frames the GPU has finished and evicts idle targets, call
+// before the frame's first acquire
+extern void
+RenderTargetPoolBeginFrame(RenderTargetPool* pool);
+
+// Returns NULL if the texture cannot be created or the pool is full
+extern SDL_GPUTexture*
+RenderTargetPoolAcquire(RenderTargetPool* pool, const RenderTargetDesc* desc);
+
+// Hands the texture back for the rest of this frame, NULL is ignored
+extern void
+RenderTargetPoolRelease(RenderTargetPool* pool, SDL_GPUTexture* texture);
+
+// Releases what is still acquired and keeps the frame's fence, which the
+// pool owns from here. A NULL fence (nothing submitted) is fine.
+extern void
+RenderTargetPoolEndFrame(RenderTargetPool* pool, SDL_GPUFence* fence);
+
+extern void
+RenderTargetPoolPrintStats(const RenderTargetPool* pool);
@@ -3,6 +3,12 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_gpu.h>
 
+#include <glm/glm.hpp>
+
+#include "entity.hpp"
+#include "render_target_pool.hpp"
+#include "spatial_grid.hpp"
+
 // Forward declaration
 struct Context;
 
@@ -10,14 +16,97 @@ const int GAME_WIDTH = 640;
 const int GAME_HEIGHT = 360;
 
 extern const char* SamplerNames[];
+extern const char* PresentModeNames[];
 constexpr size_t NumSamplers = 6;
 
+// One sprite slot per entity, indexed by EntityId
+constexpr int MAX_SPRITES = MAX_ENTITIES;
+
+// Dirty slots closer together than this are uploaded as one range
+constexpr int SPRITE_UPLOAD_MERGE_GAP = 4;
+
+// Dirty sprites per job when rewriting vertices
+constexpr int SPRITE_WRITE_MIN_CHUNK = 256;
+
+// Sprite slots for text, after the particle slots
+constexpr int RENDERER_TEXT_SLOTS = 4096;
+
+// Vertex uniform slot holding the camera's view projection, pushed once per
+// frame and shared by every pipeline. Other vertex uniforms go after it.
+constexpr Uint32 RENDERER_CAMERA_UNIFORM_SLOT = 0;
+
+// Copies of the test image, so scenarios can measure texture switches
+constexpr int RENDERER_MAX_TEXTURES = 16;
+constexpr int RENDERER_MAX_SPRITE_BATCHES = 64;
+
 typedef struct PositionTextureVertex
 {
     float x, y, z;
     float u, v;
 } PositionTextureVertex;
 
+typedef struct SpriteRange
+{
+    EntityId first;
+    EntityId last;
+} SpriteRange;
+
+// Sprite slots [first, first + count) drawn with their own texture and
+// sampler. Slots outside every batch use texture 0 and the sampler picked
+// with the arrow keys.
+typedef struct SpriteBatch
+{
+    EntityId first;
+    int count;
+    int textureIndex;
+    int samplerIndex; // -1 follows CurrentSamplerIndex
+} SpriteBatch;
+
+typedef struct SpriteStats
+{
+    int dirtySprites;
+    int uploadRanges;
+    Uint32 uploadedBytes;
+    int drawnSprites;
+    int drawCalls;
+    SpatialGridStats cull; // Of the snapshot drawn last
+} SpriteStats;
+
+// Everything the renderer needs from one simulated frame. Built by the
+// simulation and never written again until the renderer is done with it;
+// there are two so the next one can be built while this one is submitted.
+typedef struct RenderSnapshot
+{
+    Uint64 sequence; // Counts builds, tells a new snapshot from a repeat
+    Uint64 frameIndex;
+    int spriteCount;
+
+    // Newest input event this frame consumed, 0 if none
+    Uint64 inputTimestamp;
+
+    // Camera, the view rectangle is in world space
+    glm::mat4 viewProjection;
+    glm::vec2 viewMin;
+    glm::vec2 viewMax;
+
+    // Entities whose sprite changed, with their quads packed in list order.
+    // Both arrays are allocated from the frame arena.
+    int dirtyCount;
+    EntityId* dirtyList;
+    PositionTextureVertex* dirtyVertices;
+
+    // Entities overlapping the view, sorted by id. Also from the frame
+    // arena, NULL keeps the previous list.
+    int visibleCount;
+    EntityId* visibleList;
+    SpatialGridStats cullStats;
+
+    // Visible balls, taken out of the visible list when the shape renderer
+    // draws them instead
+    int shapeCount;
+    EntityId* shapeList;
+} RenderSnapshot;
+
 typedef struct GameRenderer
 {
     bool isInitialized = false;
@@ -42,8 +131,140 @@ typedef struct GameRenderer
     SDL_GPUShader* fragmentShader;
 
     SDL_Surface* imageData;
+
+    // SpriteTextures[0] is ColorTexture. Set the count before
+    // RendererCreateTexture, batches before the first frame.
+    SDL_GPUTexture* SpriteTextures[RENDERER_MAX_TEXTURES];
+    int spriteTextureCount;
+    SpriteBatch SpriteBatches[RENDERER_MAX_SPRITE_BATCHES];
+    int spriteBatchCount;
+
+    // Sprite slots after MAX_SPRITES for the CPU particles, set before
+    // RendererCreateTexture
+    int particleSlotCount;
+
+    // CPU copy of the sprite vertex buffer, only dirty slots are rewritten
+    // and uploaded. Owned by the render side.
+    PositionTextureVertex SpriteVertices[MAX_SPRITES * 4];
+    SDL_GPUTransferBuffer* SpriteTransferBuffer;
+    SpriteStats spriteStats;
+
+    // Sprites taken from snapshots that have not reached the GPU yet, kept
+    // across frames that could not acquire a swapchain texture
+    Uint8 isPendingUpload[MAX_SPRITES];
+    EntityId pendingList[MAX_SPRITES];
+    int pendingCount;
+
+    // Sprites that survived the cull, drawn through an index buffer of
+    // their own that is rewritten whenever a new list comes in
+    EntityId VisibleList[MAX_SPRITES];
+    int visibleCount;
+    bool isVisibleListPending;
+    SDL_GPUBuffer* VisibleIndexBuffer;
+    SDL_GPUTransferBuffer* VisibleTransferBuffer;
+
+    RenderSnapshot Snapshots[2];
+    int snapshotIndex; // Next one to build
+    Uint64 snapshotSequence;
+    Uint64 appliedSequence; // Last snapshot taken in by the render side
+
+    // Camera of the snapshot drawn last
+    glm::mat4 ViewProjection;
+    glm::vec2 viewMin;
+    glm::vec2 viewMax;
+
+    SDL_GPUPresentMode PresentMode;
+    Uint64 pendingInputTimestamp; // Waiting for a submitted frame
+
+    // Offscreen targets of the frame's passes
+    RenderTargetPool targetPool;
+
+    // Of the target the world was drawn into last, the swapchain or the
+    // internal resolution image
+    Uint32 renderWidth;
+    Uint32 renderHeight;
+
+    // Draws of every pass, counted while recording, and the total of the
+    // last submitted frame
+    int recordedDrawCalls;
+    int drawCalls;
 } GameRenderer;
 
+// Call after every draw so the frame total covers all passes
+inline void
+RendererCountDraw(GameRenderer* renderer)
+{
+    renderer->recordedDrawCalls += 1;
+}
+
+// World space center and half extents to the four corners, the camera is
+// applied in the vertex shader
+inline void
+RendererWriteSpriteQuad(PositionTextureVertex* quad,
+                        glm::vec2 center,
+                        glm::vec2 halfExtents)
+{
+    float left = center.x - halfExtents.x;
+    float right = center.x + halfExtents.x;
+    float top = center.y - halfExtents.y;
+    float bottom = center.y + halfExtents.y;
+
+    quad[0] = (PositionTextureVertex){ left, top, 0, 0, 0 };     // Top-left
+    quad[1] = (PositionTextureVertex){ right, top, 0, 1, 0 };    // Top-right
+    quad[2] = (PositionTextureVertex){ right, bottom, 0, 1, 1 }; // Bottom-right
+    quad[3] = (PositionTextureVertex){ left, bottom, 0, 0, 1 };  // Bottom-left
+}
+
+// First sprite slot of the text quads
+inline int
+RendererTextFirstSlot(const GameRenderer* renderer)
+{
+    return MAX_SPRITES + renderer->particleSlotCount;
+}
+
+// Walks a sorted id list, merging slots that are close together into one
+// contiguous range. Returns false once the list is exhausted.
+inline bool
+RendererNextSpriteRange(const EntityId* list,
+                        int count,
+                        int* cursor,
+                        SpriteRange* range)
+{
+    if (*cursor >= count)
+    {
+        return false;
+    }
+
+    range->first = list[*cursor];
+    range->last = range->first;
+    *cursor += 1;
+
+    while (*cursor < count &&
+           list[*cursor] - range->last <= SPRITE_UPLOAD_MERGE_GAP)
+    {
+        range->last = list[*cursor];
+        *cursor += 1;
+    }
+
+    return true;
+}
+
+extern SDL_GPUShader*
+RendererLoadShader(Context* context,
+                   SDL_GPUDevice* device,
+                   const char* shaderFilename,
+                   Uint32 samplerCount,
+                   Uint32 uniformBufferCount,
+                   Uint32 storageBufferCount,
+                   Uint32 storageTextureCount);
+
+// Code, format and entrypoint are filled in from the compiled shader
+extern SDL_GPUComputePipeline*
+RendererLoadComputePipeline(Context* context,
+                            SDL_GPUDevice* device,
+                            const char* shaderFilename,
+                            const SDL_GPUComputePipelineCreateInfo* createInfo);
+
 extern int
 RendererInitShaders(Context* context);
 
@@ -62,8 +283,22 @@ RendererCreateTexture(Context* context);
 extern SDL_GPUTransferBuffer*
 RendererCreateTransferBuffers(Context* context);
 
+// Batches must be sorted by first slot and must not overlap
+extern int
+RendererSetSpriteBatches(Context* context,
+                         const SpriteBatch* batches,
+                         int batchCount);
+
+extern int
+RendererSetPresentMode(Context* context, SDL_GPUPresentMode presentMode);
+
+// Simulation side: captures the sprites that changed since the last build
+extern RenderSnapshot*
+RendererBuildSnapshot(Context* context);
+
+// Render side: never touches simulation state, only the snapshot
 extern int
-RendererRenderFrame(Context* context);
+RendererRenderFrame(Context* context, const RenderSnapshot* snapshot);
 
 extern SDL_Surface*
 RendererLoadImage(Context* context, const char* filename, int numChannels);
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Forward declaration
+struct Context;
+
+// Player input and the deltaTime of every frame, written as a flat binary
+// log. Played back with the same seed and the fixed physics timestep the
+// simulation comes out bit-identical, which makes a log a repeatable
+// benchmark or profiling scenario. Window events stay live in both modes.
+//
+// Layout, host endian: ReplayHeader, then per frame a ReplayFrame followed
+// by its eventCount ReplayEvents.
+constexpr Uint32 REPLAY_MAGIC = 0x314C5052; // "RPL1"
+constexpr Uint32 REPLAY_VERSION = 1;
+constexpr int REPLAY_MAX_FRAME_EVENTS = 64;
+
+typedef enum ReplayMode
+{
+    REPLAY_MODE_OFF,
+    REPLAY_MODE_RECORD,
+    REPLAY_MODE_PLAYBACK,
+} ReplayMode;
+
+typedef struct ReplayHeader
+{
+    Uint32 magic;
+    Uint32 version;
+    Uint64 seed;
+} ReplayHeader;
+
+typedef struct ReplayFrame
+{
+    float deltaTime;
+    Uint32 eventCount;
+} ReplayFrame;
+
+typedef struct ReplayEvent
+{
+    Uint32 type;
+    Uint32 code; // Keycode or mouse button
+    Uint16 modifiers;
+    Uint8 isRepeat;
+    Uint8 clicks;
+} ReplayEvent;
+
+typedef struct ReplayState
+{
+    ReplayMode mode;
+    Uint64 seed;
+
+    // Recording
+    SDL_IOStream* file;
+    ReplayEvent frameEvents[REPLAY_MAX_FRAME_EVENTS];
+    Uint32 frameEventCount;
+    Uint64 droppedEvents;
+
+    // Playback, the whole log is loaded up front
+    Uint8* data;
+    size_t dataSize;
+    size_t readOffset;
+    const ReplayEvent* playbackEvents;
+    Uint32 playbackEventCount;
+    Uint32 playbackEventNext;
+
+    Uint64 frames;
+    Uint64 startTicks; // SDL_GetTicksNS
+} ReplayState;
+
+extern int
+ReplayStartRecording(ReplayState* replay, const char* path, Uint64 seed);
+
+// Replaces seed with the one the log was recorded with
+extern int
+ReplayStartPlayback(ReplayState* replay, const char* path, Uint64* seed);
+
+// Keyboard and mouse button events, the ones a log carries
+extern bool
+ReplayIsPlayerInput(const SDL_Event* event);
+
+// Call before Input. During playback deltaTime is replaced with the
+// recorded one, returns false once the log is exhausted.
+extern bool
+ReplayBeginFrame(ReplayState* replay, float* deltaTime);
+
+extern void
+ReplayRecordEvent(ReplayState* replay, const SDL_Event* event);
+
+// Next recorded event of the current frame, false when there are no more
+extern bool
+ReplayNextEvent(ReplayState* replay, SDL_Event* event);
+
+// Call after Input with the deltaTime the frame simulates
+extern void
+ReplayEndFrame(ReplayState* replay, float deltaTime);
+
+// Prints the frame count, wall time and a hash of the simulation state so
+// two runs of the same log can be compared
+extern void
+ReplayStop(Context* context);
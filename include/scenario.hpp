@@ -0,0 +1,91 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include "renderer.hpp"
+
+// Forward declaration
+struct Context;
+
+// A workload to spawn at startup, read from a text file of "key value"
+// lines (# starts a comment) and overridden by --key value arguments:
+//
+//   name          label for the report
+//   balls         bouncing balls
+//   boxes         dynamic Box2D boxes
+//   sprites       static sprites without physics
+//   world         screens per side the static sprites are spread over
+//   textures      copies of the test texture the spawned sprites cycle through
+//   samplers      comma separated SamplerNames, cycled the same way
+//   warmup        frames to skip before measuring
+//   measure       frames to measure, the report follows
+//   results       CSV file the report line is appended to
+//   exit          1 quits once the report is out
+//   tilemap       chunks per side of the background tilemap, 0 disables
+//   tileedits     random tile changes per frame
+//   shapes        static SDF shapes spread over the world
+//   particles     capacity of the CPU particles, 0 disables
+//   particleemit  CPU particles emitted per second, 0 keeps them about full
+//   gpuparticles  capacity of the compute shader particles, 0 disables
+//   gpuemit       particles emitted per second, 0 keeps the buffer about full
+//   post          comma separated PostEffectNames to start with, or "none"
+//   dynres        frame budget in ms for dynamic resolution, 0 disables
+//   snapshots     capture then restore this many times after the report
+constexpr int SCENARIO_MAX_MEASURE_FRAMES = 4096;
+constexpr int SCENARIO_MAX_SNAPSHOTS = 1000;
+constexpr int SCENARIO_DEFAULT_WARMUP_FRAMES = 120;
+constexpr int SCENARIO_DEFAULT_MEASURE_FRAMES = 600;
+constexpr int SCENARIO_MAX_WORLD_SCREENS = 16;
+
+typedef struct Scenario
+{
+    char name[64];
+    int ballCount;
+    int boxCount;
+    int spriteCount;
+    int worldScreens;
+    int textureCount;
+    int samplers[NumSamplers];
+    int samplerCount; // 0 follows the sampler picked with the arrow keys
+    int warmupFrames;
+    int measureFrames;
+    char resultsPath[256];
+    bool isExitWhenDone;
+    int tilemapChunks;
+    int tileEditsPerFrame;
+    int shapeCount;
+    int particleCapacity;
+    int particleRate;
+    int gpuParticleCapacity;
+    int gpuParticleRate;
+    Uint32 postEffects; // A bit per PostEffect
+    float dynamicResolutionBudgetMs;
+    int snapshotRestores;
+
+    // Steady state measurement
+    Uint64 frames;
+    float frameTimes[SCENARIO_MAX_MEASURE_FRAMES]; // Milliseconds
+    int frameTimeCount;
+    bool isReported;
+} Scenario;
+
+extern void
+ScenarioInit(Scenario* scenario);
+
+// Returns -1 for unknown keys or bad values
+extern int
+ScenarioSet(Scenario* scenario, const char* key, const char* value);
+
+extern int
+ScenarioLoad(Scenario* scenario, const char* path);
+
+// Spawns the workload of context->scenario and sets up its sprite batches
+extern int
+ScenarioSpawn(Context* context);
+
+extern void
+ScenarioSpawnRandomBall(Context* context);
+
+// Call once per frame with the wall time of the previous frame
+extern void
+ScenarioEndFrame(Context* context, float frameSeconds);
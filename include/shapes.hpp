@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <glm/glm.hpp>
+
+#include "ball.hpp"
+
+// Forward declaration
+struct Context;
+
+// Circles, rounded rectangles and capsules drawn analytically: one instance
+// per shape, expanded to a quad in the vertex shader, and a signed distance
+// evaluated per pixel for the anti-aliased edge. No texture is sampled.
+//
+// The instance buffer holds the static shapes first, uploaded once, then
+// the visible balls, rewritten every frame with the simulation at rest.
+constexpr int SHAPES_MAX_STATIC = 1024 * 1024;
+constexpr int SHAPES_MAX_DYNAMIC = MAX_BALLS;
+constexpr Uint64 SHAPES_SEED = 0x2545f4914f6cdd1dULL;
+
+typedef enum ShapeKind
+{
+    SHAPE_KIND_CIRCLE = 0,       // Radius in halfExtents.x
+    SHAPE_KIND_ROUNDED_RECT = 1, // Corners of cornerRadius
+    SHAPE_KIND_CAPSULE = 2,      // Along x, radius in halfExtents.y
+} ShapeKind;
+
+// Matches the instance layout in SdfShape.vert
+typedef struct ShapeInstance
+{
+    glm::vec2 center; // World space
+    glm::vec2 halfExtents;
+    float rotation; // Radians, counter clockwise
+    float cornerRadius;
+    Uint32 kind;  // ShapeKind
+    Uint32 color; // RGBA8
+} ShapeInstance;
+
+typedef struct ShapeStats
+{
+    int staticShapes;
+    int dynamicShapes;
+    Uint32 uploadedBytes;
+} ShapeStats;
+
+typedef struct ShapeRenderer
+{
+    bool isAvailable;
+
+    SDL_GPUGraphicsPipeline* Pipeline;
+    SDL_GPUBuffer* InstanceBuffer;
+    SDL_GPUTransferBuffer* TransferBuffer; // Dynamic shapes, cycled
+
+    // Released once the static shapes are on their way to the GPU
+    SDL_GPUTransferBuffer* StaticTransferBuffer;
+
+    int staticCount;
+    int dynamicCount; // Render side, written with the simulation at rest
+
+    ShapeStats stats;
+} ShapeRenderer;
+
+// Spreads staticCount random shapes over the world
+extern int
+ShapesInit(Context* context, int staticCount, glm::vec2 worldSize);
+
+// Writes the visible balls of the newest snapshot, call with the
+// simulation at rest
+extern void
+ShapesBuild(Context* context);
+
+extern void
+ShapesUpload(Context* context, SDL_GPUCopyPass* copyPass);
+
+// Binds its own pipeline, expects the camera to be pushed
+extern void
+ShapesRender(Context* context,
+             SDL_GPUCommandBuffer* cmdbuf,
+             SDL_GPURenderPass* renderPass);
+
+extern void
+ShapesDestroy(Context* context);
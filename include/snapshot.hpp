@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include "ball.hpp"
+#include "entity.hpp"
+#include "physics.hpp"
+#include "prop.hpp"
+#include "random.hpp"
+
+// Forward declaration
+struct Context;
+
+// The full simulation state in one preallocated block. Capturing is plain
+// copies and allocates nothing. Restoring copies back and then rebuilds
+// the Box2D world from the body descriptions, which allocates the world
+// and every body and shape again, so its cost grows with the body count.
+// Restoring the bodies in place would keep the cached contacts of the
+// current world and the run would no longer repeat the captured one.
+typedef struct SimulationSnapshot
+{
+    bool isValid;
+
+    // Timers
+    Uint64 frameIndex;
+    double simulationTime;
+    float physicsAccumulator;
+    Uint64 physicsStepCount;
+
+    RandomState random;
+
+    int ballCount;
+    Ball balls[MAX_BALLS];
+
+    int propCount;
+    Prop props[MAX_PROPS];
+
+    int entityCount;
+    Uint8 entityKind[MAX_ENTITIES];
+    Uint32 entityIndex[MAX_ENTITIES];
+
+    // Box2D world, in entity order
+    int bodyCount;
+    PhysicsBodyDesc bodies[MAX_ENTITIES];
+
+    // Stats, in milliseconds
+    float captureTime;
+    float restoreTime;
+} SimulationSnapshot;
+
+extern SimulationSnapshot*
+SnapshotCreate(void);
+
+extern void
+SnapshotCapture(Context* context, SimulationSnapshot* snapshot);
+
+extern int
+SnapshotRestore(Context* context, SimulationSnapshot* snapshot);
+
+extern void
+SnapshotDestroy(SimulationSnapshot* snapshot);
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <glm/glm.hpp>
+
+#include "entity.hpp"
+
+// Loose grid over the world, used to cull the entity sprites against the
+// view. An entity is filed under the cell holding its center and a query
+// widens its rectangle by the largest half extent a cell accepts, so
+// nothing overlapping the view is missed. Bigger entities (the walls) go
+// into one extra list that every query tests.
+//
+// Only entities that moved are refiled, a couple of list links each, and a
+// query visits the cells under the view rather than every entity, so its
+// cost does not grow with the size of the world.
+constexpr int SPATIAL_GRID_CELL_SIZE = 64; // Pixels
+const float SPATIAL_GRID_LOOSENESS = SPATIAL_GRID_CELL_SIZE * 0.5f;
+constexpr int SPATIAL_GRID_MAX_CELLS_PER_SIDE = 256;
+constexpr int SPATIAL_GRID_MAX_CELLS =
+  SPATIAL_GRID_MAX_CELLS_PER_SIDE * SPATIAL_GRID_MAX_CELLS_PER_SIDE;
+constexpr int SPATIAL_GRID_OVERSIZED = SPATIAL_GRID_MAX_CELLS; // List index
+constexpr Sint32 SPATIAL_GRID_NONE = -1;
+
+typedef struct SpatialGridStats
+{
+    int cellsVisited;
+    int tested;
+    int visible;
+    double querySeconds;
+} SpatialGridStats;
+
+typedef struct SpatialGrid
+{
+    int cellsX;
+    int cellsY;
+    int idEnd; // One past the highest id ever filed
+
+    // Indexed by EntityId. Lists are doubly linked through the ids, entity
+    // 0 ends them.
+    Sint32 cell[MAX_ENTITIES]; // SPATIAL_GRID_NONE when not filed
+    EntityId next[MAX_ENTITIES];
+    EntityId previous[MAX_ENTITIES];
+    glm::vec2 boundsMin[MAX_ENTITIES];
+    glm::vec2 boundsMax[MAX_ENTITIES];
+
+    EntityId heads[SPATIAL_GRID_MAX_CELLS + 1]; // Oversized list last
+} SpatialGrid;
+
+// The world starts at the origin. Entities outside it still work, they
+// are filed under the nearest edge cell.
+extern void
+SpatialGridInit(SpatialGrid* grid, glm::vec2 worldSize);
+
+// Files a new entity or refiles one that moved
+extern void
+SpatialGridUpdate(SpatialGrid* grid,
+                  EntityId entity,
+                  glm::vec2 center,
+                  glm::vec2 halfExtents);
+
+extern void
+SpatialGridRemove(SpatialGrid* grid, EntityId entity);
+
+// Removes every entity with an id past count, after a snapshot restore
+// shrank the entity table
+extern void
+SpatialGridTruncate(SpatialGrid* grid, int count);
+
+// Writes the entities overlapping [viewMin, viewMax] to result, which has
+// room for idEnd entries, in no particular order. Returns their count.
+extern int
+SpatialGridQuery(const SpatialGrid* grid,
+                 glm::vec2 viewMin,
+                 glm::vec2 viewMax,
+                 EntityId* result,
+                 SpatialGridStats* stats);
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include "random.hpp"
+
+// Forward declaration
+struct Context;
+
+// Background tile layer split into square chunks. Each chunk owns a fixed
+// region of one persistent vertex buffer that is only rewritten when one of
+// its tiles changes, and only the chunks overlapping the view are drawn.
+// The quads reuse the sprite index buffer through a base vertex offset.
+//
+// Tile 0 is empty, the others pick a cell of the sprite texture.
+constexpr int TILEMAP_CHUNK_SIZE = 32; // Tiles per side
+constexpr int TILEMAP_CHUNK_TILES = TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE;
+constexpr int TILEMAP_TILE_SIZE = 16; // Pixels
+constexpr int TILEMAP_CHUNK_PIXELS = TILEMAP_CHUNK_SIZE * TILEMAP_TILE_SIZE;
+constexpr int TILEMAP_MAX_CHUNKS_PER_SIDE = 16;
+constexpr int TILEMAP_MAX_CHUNKS =
+  TILEMAP_MAX_CHUNKS_PER_SIDE * TILEMAP_MAX_CHUNKS_PER_SIDE;
+constexpr int TILEMAP_MAX_CHUNK_UPLOADS = 8; // Per frame, the rest waits
+constexpr int TILEMAP_ATLAS_COLUMNS = 8;
+constexpr int TILEMAP_TILE_KINDS =
+  TILEMAP_ATLAS_COLUMNS * TILEMAP_ATLAS_COLUMNS;
+constexpr Uint64 TILEMAP_SEED = 0x7f4a7c15ULL;
+
+typedef Uint8 Tile;
+
+typedef struct TileChunk
+{
+    bool isDirty;
+    int quadCount; // Non-empty tiles in the vertex buffer, render side
+} TileChunk;
+
+typedef struct TileChunkUpload
+{
+    int chunk;
+    int quadCount;
+    Uint32 transferOffset; // Vertices
+} TileChunkUpload;
+
+typedef struct TilemapStats
+{
+    int chunks;
+    int visibleChunks;
+    int drawnQuads;
+    int rebuiltChunks;
+    Uint32 uploadedBytes;
+} TilemapStats;
+
+typedef struct Tilemap
+{
+    bool isEnabled;
+
+    int width; // Tiles
+    int height;
+    int chunksX;
+    int chunksY;
+    Tile* tiles; // Row major, row 0 at the bottom
+
+    TileChunk chunks[TILEMAP_MAX_CHUNKS];
+    int dirtyList[TILEMAP_MAX_CHUNKS];
+    int dirtyCount;
+
+    // Random tile changes per frame, to measure the rebuilds
+    int editsPerFrame;
+    RandomState random;
+
+    SDL_GPUBuffer* VertexBuffer;
+    SDL_GPUTransferBuffer* TransferBuffer;
+
+    // Built with the simulation at rest, go out with the next copy pass
+    TileChunkUpload uploads[TILEMAP_MAX_CHUNK_UPLOADS];
+    int uploadCount;
+
+    TilemapStats stats;
+} Tilemap;
+
+// A chunksPerSide x chunksPerSide map of generated tiles
+extern int
+TilemapInit(Context* context, int chunksPerSide, int editsPerFrame);
+
+// Marks the chunk for a rebuild if the tile changes
+extern void
+TilemapSetTile(Tilemap* tilemap, int x, int y, Tile tile);
+
+// Simulation side, applies the random edits
+extern void
+TilemapUpdate(Context* context);
+
+// Writes the dirty chunks into the transfer buffer, call with the
+// simulation at rest
+extern void
+TilemapBuild(Context* context);
+
+extern void
+TilemapUpload(Context* context, SDL_GPUCopyPass* copyPass);
+
+// Expects the sprite pipeline and index buffer to be bound, leaves the
+// tilemap vertex buffer bound
+extern void
+TilemapRender(Context* context, SDL_GPURenderPass* renderPass);
+
+extern void
+TilemapDestroy(Context* context);
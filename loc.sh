@@ -1,3 +1,3 @@
 #!/bin/bash
 
-cloc src/*.cpp include/ball.hpp include/context.hpp include/includes.hpp include/renderer.hpp 
\ No newline at end of file
+cloc src/*.cpp include/arena.hpp include/ball.hpp include/context.hpp include/debug_draw.hpp include/includes.hpp include/input.hpp include/memory_tracker.hpp include/jobs.hpp include/renderer.hpp include/entity.hpp include/frame_pacer.hpp include/frame_pipeline.hpp include/physics.hpp include/random.hpp include/snapshot.hpp include/profiler.hpp include/replay.hpp include/prop.hpp include/scenario.hpp include/gpu_particles.hpp include/particles.hpp include/tilemap.hpp include/spatial_grid.hpp include/camera.hpp include/shapes.hpp include/font.hpp include/perf_hud.hpp include/render_target_pool.hpp include/post.hpp include/dynamic_resolution.hpp 
\ No newline at end of file
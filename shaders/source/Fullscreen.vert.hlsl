@@ -0,0 +1,15 @@
+struct Output {
+    float2 TexCoord : TEXCOORD0;
+    float4 Position : SV_Position;
+};
+
+// One triangle over the whole target, no vertex buffer
+Output main(uint vertexIndex : SV_VertexID) {
+    float2 texCoord = float2((vertexIndex << 1) & 2, vertexIndex & 2);
+
+    Output output;
+    output.TexCoord = texCoord;
+    output.Position = float4(texCoord * float2(2.0f, -2.0f) +
+                             float2(-1.0f, 1.0f), 0.0f, 1.0f);
+    return output;
+}
@@ -0,0 +1,67 @@
+// Keep in sync with GpuParticleEmit in include/gpu_particles.hpp
+struct Particle {
+    float2 Position;
+    float2 Velocity;
+    float Life;
+    float Size;
+    uint Color;
+    uint Id;
+};
+
+cbuffer UniformBlock : register(b0, space2) {
+    float DeltaTime;
+    float Damping;
+    float Gravity;
+    float Restitution;
+    float2 Bounds;
+    uint Capacity;
+    uint EmitCount;
+    float2 Emitter;
+    uint FirstId;
+    float Spread;
+    float SpeedMin;
+    float SpeedMax;
+    float LifeMin;
+    float LifeMax;
+};
+
+RWStructuredBuffer<Particle> ParticlesOut : register(u0, space1);
+RWStructuredBuffer<uint> Counters : register(u1, space1);
+
+uint Hash(uint value) {
+    uint state = value * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+float Unit(uint value) {
+    return (float)(value >> 8) * (1.0f / 16777216.0f);
+}
+
+// New particles go right after the survivors, the slots past the capacity
+// are dropped
+[numthreads(64, 1, 1)]
+void main(uint3 GlobalInvocationID : SV_DispatchThreadID) {
+    uint index = Counters[1] + GlobalInvocationID.x;
+    if (GlobalInvocationID.x >= EmitCount || index >= Capacity) {
+        return;
+    }
+
+    Particle particle;
+    particle.Id = FirstId + GlobalInvocationID.x;
+
+    uint hash = Hash(particle.Id);
+    float angle = 1.5707963f + (Unit(hash) - 0.5f) * Spread;
+    hash = Hash(hash);
+    float speed = SpeedMin + Unit(hash) * (SpeedMax - SpeedMin);
+    hash = Hash(hash);
+    particle.Life = LifeMin + Unit(hash) * (LifeMax - LifeMin);
+    hash = Hash(hash);
+    particle.Size = 0.5f + Unit(hash);
+    particle.Color = 0xFF000000u | (Hash(hash) & 0x00FFFFFFu);
+
+    particle.Position = Emitter;
+    particle.Velocity = float2(cos(angle) * speed, sin(angle) * speed);
+
+    ParticlesOut[index] = particle;
+}
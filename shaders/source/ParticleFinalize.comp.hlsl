@@ -0,0 +1,37 @@
+cbuffer UniformBlock : register(b0, space2) {
+    float DeltaTime;
+    float Damping;
+    float Gravity;
+    float Restitution;
+    float2 Bounds;
+    uint Capacity;
+    uint EmitCount;
+    float2 Emitter;
+    uint FirstId;
+    float Spread;
+    float SpeedMin;
+    float SpeedMax;
+    float LifeMin;
+    float LifeMax;
+};
+
+RWStructuredBuffer<uint> Counters : register(u0, space1);
+RWStructuredBuffer<uint> Arguments : register(u1, space1);
+
+// Turns the append counter into the live count and the indirect arguments
+// of the next update and of the draw
+[numthreads(1, 1, 1)]
+void main(uint3 GlobalInvocationID : SV_DispatchThreadID) {
+    uint alive = min(Counters[1] + EmitCount, Capacity);
+    Counters[0] = alive;
+    Counters[1] = 0;
+
+    Arguments[0] = (alive + 63) / 64;
+    Arguments[1] = 1;
+    Arguments[2] = 1;
+
+    Arguments[4] = alive * 6;
+    Arguments[5] = 1;
+    Arguments[6] = 0;
+    Arguments[7] = 0;
+}
@@ -0,0 +1,59 @@
+struct Particle {
+    float2 Position;
+    float2 Velocity;
+    float Life;
+    float Size;
+    uint Color;
+    uint Id;
+};
+
+// World space to clip space, pushed once per frame
+cbuffer CameraBlock : register(b0, space1) {
+    float4x4 ViewProjection;
+};
+
+cbuffer UniformBlock : register(b1, space1) {
+    float DeltaTime;
+    float Damping;
+    float Gravity;
+    float Restitution;
+    float2 Bounds;
+    uint Capacity;
+    uint EmitCount;
+    float2 Emitter;
+    uint FirstId;
+    float Spread;
+    float SpeedMin;
+    float SpeedMax;
+    float LifeMin;
+    float LifeMax;
+};
+
+StructuredBuffer<Particle> Particles : register(t0, space0);
+
+struct Output {
+    float4 Color : TEXCOORD0;
+    float4 Position : SV_Position;
+};
+
+static const float2 Corners[6] = {
+    float2(-1.0f, -1.0f), float2(1.0f, -1.0f), float2(1.0f, 1.0f),
+    float2(-1.0f, -1.0f), float2(1.0f, 1.0f), float2(-1.0f, 1.0f),
+};
+
+// Six vertices per particle, pulled from the storage buffer
+Output main(uint VertexIndex : SV_VertexID) {
+    Particle particle = Particles[VertexIndex / 6];
+    float2 position = particle.Position + Corners[VertexIndex % 6] * particle.Size;
+
+    Output output;
+    output.Position = mul(ViewProjection, float4(position, 0.0f, 1.0f));
+    output.Color = float4(particle.Color & 0xFF,
+                          (particle.Color >> 8) & 0xFF,
+                          (particle.Color >> 16) & 0xFF,
+                          particle.Color >> 24) / 255.0f;
+
+    // Fade out over the last half second
+    output.Color.a *= saturate(particle.Life * 2.0f);
+    return output;
+}
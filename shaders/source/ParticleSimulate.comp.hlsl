@@ -0,0 +1,62 @@
+// Keep in sync with GpuParticleSimulate in include/gpu_particles.hpp
+struct Particle {
+    float2 Position;
+    float2 Velocity;
+    float Life;
+    float Size;
+    uint Color;
+    uint Id;
+};
+
+cbuffer UniformBlock : register(b0, space2) {
+    float DeltaTime;
+    float Damping;
+    float Gravity;
+    float Restitution;
+    float2 Bounds;
+    uint Capacity;
+    uint EmitCount;
+    float2 Emitter;
+    uint FirstId;
+    float Spread;
+    float SpeedMin;
+    float SpeedMax;
+    float LifeMin;
+    float LifeMax;
+};
+
+StructuredBuffer<Particle> ParticlesIn : register(t0, space0);
+RWStructuredBuffer<Particle> ParticlesOut : register(u0, space1);
+RWStructuredBuffer<uint> Counters : register(u1, space1);
+
+[numthreads(64, 1, 1)]
+void main(uint3 GlobalInvocationID : SV_DispatchThreadID) {
+    if (GlobalInvocationID.x >= Counters[0]) {
+        return;
+    }
+
+    Particle particle = ParticlesIn[GlobalInvocationID.x];
+    particle.Life -= DeltaTime;
+    if (particle.Life <= 0.0f) {
+        return;
+    }
+
+    particle.Velocity.y += Gravity * DeltaTime;
+    particle.Velocity *= Damping;
+    particle.Position += particle.Velocity * DeltaTime;
+
+    // Reflect off the edges of the game area
+    for (int axis = 0; axis < 2; ++axis) {
+        if (particle.Position[axis] < 0.0f) {
+            particle.Position[axis] = -particle.Position[axis];
+            particle.Velocity[axis] *= -Restitution;
+        } else if (particle.Position[axis] > Bounds[axis]) {
+            particle.Position[axis] = 2.0f * Bounds[axis] - particle.Position[axis];
+            particle.Velocity[axis] *= -Restitution;
+        }
+    }
+
+    uint index;
+    InterlockedAdd(Counters[1], 1, index);
+    ParticlesOut[index] = particle;
+}
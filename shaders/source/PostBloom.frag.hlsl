@@ -0,0 +1,17 @@
+Texture2D<float4> Image : register(t0, space2);
+Texture2D<float4> Bloom : register(t1, space2);
+SamplerState Sampler : register(s0, space2);
+SamplerState BloomSampler : register(s1, space2);
+
+// See PostUniforms
+cbuffer PostBlock : register(b0, space3) {
+    float2 TexelSize;
+    float Strength;
+    float Unused;
+};
+
+float4 main(float2 TexCoord : TEXCOORD0) : SV_Target0 {
+    float3 color = Image.Sample(Sampler, TexCoord).rgb;
+    color += Bloom.Sample(BloomSampler, TexCoord).rgb * Strength;
+    return float4(color, 1.0f);
+}
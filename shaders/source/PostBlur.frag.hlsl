@@ -0,0 +1,24 @@
+Texture2D<float4> Image : register(t0, space2);
+SamplerState Sampler : register(s0, space2);
+
+// See PostUniforms, the texel size is along the blur direction
+cbuffer PostBlock : register(b0, space3) {
+    float2 TexelSize;
+    float Unused0;
+    float Unused1;
+};
+
+// 9 tap Gaussian in 5 linear samples
+static const float Offsets[3] = { 0.0f, 1.3846153846f, 3.2307692308f };
+static const float Weights[3] = { 0.2270270270f, 0.3162162162f,
+                                  0.0702702703f };
+
+float4 main(float2 TexCoord : TEXCOORD0) : SV_Target0 {
+    float3 color = Image.Sample(Sampler, TexCoord).rgb * Weights[0];
+    for (int i = 1; i < 3; ++i) {
+        float2 offset = TexelSize * Offsets[i];
+        color += Image.Sample(Sampler, TexCoord + offset).rgb * Weights[i];
+        color += Image.Sample(Sampler, TexCoord - offset).rgb * Weights[i];
+    }
+    return float4(color, 1.0f);
+}
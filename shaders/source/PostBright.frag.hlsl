@@ -0,0 +1,17 @@
+Texture2D<float4> Image : register(t0, space2);
+SamplerState Sampler : register(s0, space2);
+
+// See PostUniforms
+cbuffer PostBlock : register(b0, space3) {
+    float2 TexelSize;
+    float Threshold;
+    float Unused;
+};
+
+// Rendered at half size, the linear sample averages a 2x2 block
+float4 main(float2 TexCoord : TEXCOORD0) : SV_Target0 {
+    float3 color = Image.Sample(Sampler, TexCoord).rgb;
+    float brightness = max(color.r, max(color.g, color.b));
+    float weight = saturate((brightness - Threshold) / (1.0f - Threshold));
+    return float4(color * weight, 1.0f);
+}
@@ -0,0 +1,7 @@
+Texture2D<float4> Image : register(t0, space2);
+SamplerState Sampler : register(s0, space2);
+
+// Upscale to the swapchain, the point sampler keeps the pixels square
+float4 main(float2 TexCoord : TEXCOORD0) : SV_Target0 {
+    return float4(Image.Sample(Sampler, TexCoord).rgb, 1.0f);
+}
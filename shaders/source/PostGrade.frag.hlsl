@@ -0,0 +1,29 @@
+Texture2D<float4> Image : register(t0, space2);
+Texture2D<float4> Lut : register(t1, space2);
+SamplerState Sampler : register(s0, space2);
+SamplerState LutSampler : register(s1, space2);
+
+// See PostUniforms
+cbuffer PostBlock : register(b0, space3) {
+    float2 TexelSize;
+    float LutSize; // Cells per side
+    float Amount;  // 0 leaves the image alone
+};
+
+// The 3D LUT is a strip of LutSize slices along x, one per blue value.
+// Red and green are filtered by the sampler, blue between two slices.
+float3 SampleLut(float3 color) {
+    float blue = color.b * (LutSize - 1.0f);
+    float slice = floor(blue);
+    float2 cell = (color.rg * (LutSize - 1.0f) + 0.5f) / LutSize;
+    float2 uv0 = float2((slice + cell.x) / LutSize, cell.y);
+    float next = slice < LutSize - 1.0f ? 1.0f / LutSize : 0.0f;
+    float3 low = Lut.Sample(LutSampler, uv0).rgb;
+    float3 high = Lut.Sample(LutSampler, uv0 + float2(next, 0.0f)).rgb;
+    return lerp(low, high, blue - slice);
+}
+
+float4 main(float2 TexCoord : TEXCOORD0) : SV_Target0 {
+    float3 color = saturate(Image.Sample(Sampler, TexCoord).rgb);
+    return float4(lerp(color, SampleLut(color), Amount), 1.0f);
+}
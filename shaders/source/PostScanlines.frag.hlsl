@@ -0,0 +1,21 @@
+Texture2D<float4> Image : register(t0, space2);
+SamplerState Sampler : register(s0, space2);
+
+// See PostUniforms, the texel size is of a game pixel
+cbuffer PostBlock : register(b0, space3) {
+    float2 TexelSize;
+    float Strength; // Darkening of the odd rows
+    float Vignette;
+};
+
+float4 main(float2 TexCoord : TEXCOORD0) : SV_Target0 {
+    float3 color = Image.Sample(Sampler, TexCoord).rgb;
+
+    // Every other game row, upscaling makes them bands
+    float row = floor(TexCoord.y / TexelSize.y);
+    color *= 1.0f - Strength * fmod(row, 2.0f);
+
+    float2 centered = TexCoord * 2.0f - 1.0f;
+    color *= 1.0f - Vignette * dot(centered, centered) * 0.5f;
+    return float4(color, 1.0f);
+}
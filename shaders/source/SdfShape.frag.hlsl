@@ -0,0 +1,42 @@
+struct Input {
+    float2 Local : TEXCOORD0;
+    nointerpolation float2 HalfExtents : TEXCOORD1;
+    nointerpolation float CornerRadius : TEXCOORD2;
+    nointerpolation uint Kind : TEXCOORD3;
+    float4 Color : TEXCOORD4;
+};
+
+// Signed distances, negative inside. Kinds match ShapeKind.
+float RoundedRect(float2 p, float2 halfExtents, float radius) {
+    float2 q = abs(p) - halfExtents + radius;
+    return length(max(q, 0.0f)) + min(max(q.x, q.y), 0.0f) - radius;
+}
+
+float Capsule(float2 p, float2 halfExtents) {
+    float radius = halfExtents.y;
+    float segment = max(halfExtents.x - radius, 0.0f);
+    p.x -= clamp(p.x, -segment, segment);
+    return length(p) - radius;
+}
+
+float4 main(Input input) : SV_Target0 {
+    float distance;
+    if (input.Kind == 0) {
+        distance = length(input.Local) - input.HalfExtents.x;
+    } else if (input.Kind == 1) {
+        distance =
+            RoundedRect(input.Local, input.HalfExtents, input.CornerRadius);
+    } else {
+        distance = Capsule(input.Local, input.HalfExtents);
+    }
+
+    // About one pixel of coverage ramp, whatever the zoom
+    float coverage = saturate(0.5f - distance / max(fwidth(distance), 1e-5f));
+    if (coverage <= 0.0f) {
+        discard;
+    }
+
+    float4 color = input.Color;
+    color.a *= coverage;
+    return color;
+}
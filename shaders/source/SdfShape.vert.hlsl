@@ -0,0 +1,52 @@
+// World space to clip space, pushed once per frame
+cbuffer CameraBlock : register(b0, space1) {
+    float4x4 ViewProjection;
+};
+
+cbuffer ShapeBlock : register(b1, space1) {
+    float PixelSize; // World units per screen pixel
+};
+
+// One instance per shape, see ShapeInstance
+struct Input {
+    float4 CenterHalfExtents : TEXCOORD0;
+    float2 RotationCornerRadius : TEXCOORD1;
+    uint Kind : TEXCOORD2;
+    float4 Color : TEXCOORD3;
+    uint VertexIndex : SV_VertexID;
+};
+
+struct Output {
+    float2 Local : TEXCOORD0;
+    nointerpolation float2 HalfExtents : TEXCOORD1;
+    nointerpolation float CornerRadius : TEXCOORD2;
+    nointerpolation uint Kind : TEXCOORD3;
+    float4 Color : TEXCOORD4;
+    float4 Position : SV_Position;
+};
+
+static const float2 Corners[6] = {
+    float2(-1.0f, -1.0f), float2(1.0f, -1.0f), float2(1.0f, 1.0f),
+    float2(-1.0f, -1.0f), float2(1.0f, 1.0f), float2(-1.0f, 1.0f),
+};
+
+// The quad is grown by a pixel so the anti-aliased edge is not clipped
+Output main(Input input) {
+    float2 halfExtents = input.CenterHalfExtents.zw;
+    float2 local = Corners[input.VertexIndex % 6] * (halfExtents + PixelSize);
+
+    float c = cos(input.RotationCornerRadius.x);
+    float s = sin(input.RotationCornerRadius.x);
+    float2 rotated =
+        float2(c * local.x - s * local.y, s * local.x + c * local.y);
+    float2 position = input.CenterHalfExtents.xy + rotated;
+
+    Output output;
+    output.Local = local;
+    output.HalfExtents = halfExtents;
+    output.CornerRadius = input.RotationCornerRadius.y;
+    output.Kind = input.Kind;
+    output.Color = input.Color;
+    output.Position = mul(ViewProjection, float4(position, 0.0f, 1.0f));
+    return output;
+}
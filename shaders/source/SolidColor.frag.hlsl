@@ -0,0 +1,3 @@
+float4 main(float4 Color : TEXCOORD0) : SV_Target0 {
+    return Color;
+}
@@ -1,6 +1,10 @@
 Texture2D<float4> Texture : register(t0, space2);
 SamplerState Sampler : register(s0, space2);
 
+// Alpha tested, the pipeline does not blend. Keeps the space around the
+// glyphs of the font atlas out.
 float4 main(float2 TexCoord : TEXCOORD0) : SV_Target0 {
-    return Texture.Sample(Sampler, TexCoord);
+    float4 color = Texture.Sample(Sampler, TexCoord);
+    clip(color.a - 0.5f);
+    return color;
 }
@@ -1,3 +1,8 @@
+// World space to clip space, pushed once per frame
+cbuffer CameraBlock : register(b0, space1) {
+    float4x4 ViewProjection;
+};
+
 struct Input {
     float3 Position : TEXCOORD0;
     float2 TexCoord : TEXCOORD1;
@@ -11,6 +16,6 @@ struct Output {
 Output main(Input input) {
     Output output;
     output.TexCoord = input.TexCoord;
-    output.Position = float4(input.Position, 1.0f);
+    output.Position = mul(ViewProjection, float4(input.Position, 1.0f));
     return output;
 }
@@ -29,10 +29,10 @@ for filename in *.frag.hlsl; do
     fi
 done
 
-## for filename in *.comp.hlsl; do
-##     if [ -f "$filename" ]; then
-##         shadercross "$filename" -o "../compiled/SPIRV/${filename/.hlsl/.spv}"
-##         shadercross "$filename" -o "../compiled/MSL/${filename/.hlsl/.msl}"
-##         shadercross "$filename" -o "../compiled/DXIL/${filename/.hlsl/.dxil}"
-##     fi
-## done
+for filename in *.comp.hlsl; do
+    if [ -f "$filename" ]; then
+        shadercross "$filename" -o "../compiled/SPIRV/${filename/.hlsl/.spv}"
+        shadercross "$filename" -o "../compiled/MSL/${filename/.hlsl/.msl}"
+        shadercross "$filename" -o "../compiled/DXIL/${filename/.hlsl/.dxil}"
+    fi
+done
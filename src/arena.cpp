@@ -0,0 +1,113 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Our code
+#include "arena.hpp"
+#include "includes.hpp"
+
+// -------------------------------------------------------------------------------
+internal void
+Poison(Arena* arena, size_t from, size_t to)
+{
+#if ARENA_DEBUG
+    if (to > from)
+    {
+        SDL_memset(arena->base + from, ARENA_POISON, to - from);
+    }
+#else
+    (void)arena;
+    (void)from;
+    (void)to;
+#endif
+}
+
+int
+ArenaInit(Arena* arena, const char* name, size_t capacity)
+{
+    *arena = (Arena){ 0 };
+    arena->name = name;
+    arena->base = (Uint8*)SDL_aligned_alloc(ARENA_DEFAULT_ALIGNMENT, capacity);
+    if (arena->base == NULL)
+    {
+        SDL_Log("Could not allocate the %s arena!", name);
+        return -1;
+    }
+    arena->capacity = capacity;
+
+    Poison(arena, 0, capacity);
+
+    return 0;
+}
+
+void
+ArenaDestroy(Arena* arena)
+{
+    SDL_aligned_free(arena->base);
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+
+void*
+ArenaPush(Arena* arena, size_t size, size_t alignment)
+{
+    // alignment is a power of two
+    size_t start = (arena->used + alignment - 1) & ~(alignment - 1);
+    if (start + size > arena->capacity)
+    {
+        if (arena->failures++ == 0)
+        {
+            SDL_Log("The %s arena is full (%zu of %zu bytes used)",
+                    arena->name,
+                    arena->used,
+                    arena->capacity);
+        }
+        return NULL;
+    }
+
+    arena->used = start + size;
+    return arena->base + start;
+}
+
+void
+ArenaReset(Arena* arena)
+{
+    arena->lastUsed = arena->used;
+    arena->peakUsed = SDL_max(arena->peakUsed, arena->used);
+
+    Poison(arena, 0, arena->used);
+    arena->used = 0;
+}
+
+ArenaScope
+ArenaBeginScope(Arena* arena)
+{
+    ArenaScope scope = {
+        .arena = arena,
+        .mark = arena->used,
+    };
+    return scope;
+}
+
+void
+ArenaEndScope(ArenaScope scope)
+{
+    Arena* arena = scope.arena;
+    arena->peakUsed = SDL_max(arena->peakUsed, arena->used);
+
+    Poison(arena, scope.mark, arena->used);
+    arena->used = scope.mark;
+}
+
+void
+ArenaPrintStats(const Arena* arena)
+{
+    printf("Arena %s: peak %.1f KB of %.1f KB, %llu failed pushes\n",
+           arena->name,
+           SDL_max(arena->peakUsed, arena->used) / 1024.0,
+           arena->capacity / 1024.0,
+           (unsigned long long)arena->failures);
+}
@@ -0,0 +1,146 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "camera.hpp"
+#include "includes.hpp"
+#include "renderer.hpp"
+
+// -------------------------------------------------------------------------------
+internal Uint32
+KeyFor(SDL_Keycode key)
+{
+    switch (key)
+    {
+        case SDLK_A:
+            return CAMERA_KEY_LEFT;
+        case SDLK_D:
+            return CAMERA_KEY_RIGHT;
+        case SDLK_S:
+            return CAMERA_KEY_DOWN;
+        case SDLK_W:
+            return CAMERA_KEY_UP;
+        case SDLK_Q:
+            return CAMERA_KEY_ROTATE_LEFT;
+        case SDLK_E:
+            return CAMERA_KEY_ROTATE_RIGHT;
+        case SDLK_EQUALS:
+            return CAMERA_KEY_ZOOM_IN;
+        case SDLK_MINUS:
+            return CAMERA_KEY_ZOOM_OUT;
+        default:
+            return 0;
+    }
+}
+
+// -1, 0 or 1 from a pair of held keys
+internal float
+Axis(Uint32 heldKeys, Uint32 negative, Uint32 positive)
+{
+    return (float)((heldKeys & positive) != 0) -
+           (float)((heldKeys & negative) != 0);
+}
+
+// -------------------------------------------------------------------------------
+void
+CameraInit(Camera* camera)
+{
+    SDL_memset(camera, 0, sizeof(Camera));
+    camera->position = glm::vec2(GAME_WIDTH * 0.5f, GAME_HEIGHT * 0.5f);
+    camera->zoom = 1.0f;
+}
+
+bool
+CameraHandleEvent(Camera* camera, const SDL_Event* event)
+{
+    if (event->type != SDL_EVENT_KEY_DOWN && event->type != SDL_EVENT_KEY_UP)
+    {
+        return false;
+    }
+
+    if (event->key.key == SDLK_R)
+    {
+        camera->isResetPending |= event->type == SDL_EVENT_KEY_DOWN;
+        return true;
+    }
+
+    Uint32 key = KeyFor(event->key.key);
+    if (event->type == SDL_EVENT_KEY_DOWN)
+    {
+        camera->heldKeys |= key;
+    }
+    else
+    {
+        camera->heldKeys &= ~key;
+    }
+
+    return key != 0;
+}
+
+void
+CameraUpdate(Camera* camera, float deltaTime)
+{
+    if (camera->isResetPending)
+    {
+        Uint32 heldKeys = camera->heldKeys;
+        CameraInit(camera);
+        camera->heldKeys = heldKeys;
+    }
+
+    Uint32 keys = camera->heldKeys;
+    float zoom = Axis(keys, CAMERA_KEY_ZOOM_OUT, CAMERA_KEY_ZOOM_IN);
+    camera->zoom *= SDL_powf(CAMERA_ZOOM_SPEED, zoom * deltaTime);
+    camera->zoom = SDL_clamp(camera->zoom, CAMERA_ZOOM_MIN, CAMERA_ZOOM_MAX);
+
+    camera->rotation +=
+      Axis(keys, CAMERA_KEY_ROTATE_RIGHT, CAMERA_KEY_ROTATE_LEFT) *
+      CAMERA_ROTATE_SPEED * deltaTime;
+
+    // Panning follows the screen axes at a constant on-screen speed
+    glm::vec2 pan(Axis(keys, CAMERA_KEY_LEFT, CAMERA_KEY_RIGHT),
+                  Axis(keys, CAMERA_KEY_DOWN, CAMERA_KEY_UP));
+    float c = SDL_cosf(camera->rotation);
+    float s = SDL_sinf(camera->rotation);
+    glm::vec2 worldPan(c * pan.x - s * pan.y, s * pan.x + c * pan.y);
+    camera->position +=
+      worldPan * (CAMERA_PAN_SPEED * deltaTime / camera->zoom);
+}
+
+glm::mat4
+CameraViewProjection(const Camera* camera)
+{
+    // Translate to the camera, rotate by -rotation, scale by the zoom and
+    // map the screen to [-1, 1]. Written out column by column.
+    float c = SDL_cosf(camera->rotation);
+    float s = SDL_sinf(camera->rotation);
+    float scaleX = camera->zoom * 2.0f / (float)GAME_WIDTH;
+    float scaleY = camera->zoom * 2.0f / (float)GAME_HEIGHT;
+    glm::vec2 p = camera->position;
+
+    glm::mat4 result(1.0f);
+    result[0][0] = scaleX * c;
+    result[0][1] = -scaleY * s;
+    result[1][0] = scaleX * s;
+    result[1][1] = scaleY * c;
+    result[3][0] = -(result[0][0] * p.x + result[1][0] * p.y);
+    result[3][1] = -(result[0][1] * p.x + result[1][1] * p.y);
+
+    return result;
+}
+
+void
+CameraBounds(const Camera* camera, glm::vec2* viewMin, glm::vec2* viewMax)
+{
+    float c = SDL_fabsf(SDL_cosf(camera->rotation));
+    float s = SDL_fabsf(SDL_sinf(camera->rotation));
+    float halfWidth = GAME_WIDTH * 0.5f / camera->zoom;
+    float halfHeight = GAME_HEIGHT * 0.5f / camera->zoom;
+
+    glm::vec2 halfExtents(c * halfWidth + s * halfHeight,
+                          s * halfWidth + c * halfHeight);
+    *viewMin = camera->position - halfExtents;
+    *viewMax = camera->position + halfExtents;
+}
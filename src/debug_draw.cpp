@@ -0,0 +1,692 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glm/glm.hpp>
+#include <glm/vec2.hpp>
+
+#include <box2d/box2d.h>
+
+// Our code
+#include "context.hpp"
+#include "debug_draw.hpp"
+#include "includes.hpp"
+
+typedef struct DebugColor
+{
+    Uint8 r, g, b, a;
+} DebugColor;
+
+// -------------------------------------------------------------------------------
+internal DebugColor
+ToDebugColor(b2HexColor color, Uint8 alpha)
+{
+    return (DebugColor){ (Uint8)((color >> 16) & 0xFF),
+                         (Uint8)((color >> 8) & 0xFF),
+                         (Uint8)(color & 0xFF),
+                         alpha };
+}
+
+// Box2D meters to pixels
+internal glm::vec2
+ToPixels(b2Vec2 point)
+{
+    return glm::vec2(PhysicsToPixels(point.x), PhysicsToPixels(point.y));
+}
+
+// Makes room for count vertices, dropping the whole primitive if it does not
+// fit so the buffer always holds complete triangles
+internal PositionColorVertex*
+Reserve(DebugDraw* debugDraw, Uint32 count)
+{
+    if (debugDraw->vertices == NULL ||
+        debugDraw->vertexCount + count > debugDraw->capacity)
+    {
+        debugDraw->stats.droppedVertices += count;
+        return NULL;
+    }
+
+    PositionColorVertex* result = &debugDraw->vertices[debugDraw->vertexCount];
+    debugDraw->vertexCount += count;
+    return result;
+}
+
+internal void
+WriteVertex(PositionColorVertex* vertex, glm::vec2 pixel, DebugColor color)
+{
+    vertex->x = pixel.x;
+    vertex->y = pixel.y;
+    vertex->z = 0.0f;
+    vertex->r = color.r;
+    vertex->g = color.g;
+    vertex->b = color.b;
+    vertex->a = color.a;
+}
+
+internal void
+PushLine(DebugDraw* debugDraw, glm::vec2 a, glm::vec2 b, DebugColor color)
+{
+    glm::vec2 direction = b - a;
+    float length = glm::length(direction);
+    if (length <= 0.0f)
+    {
+        return;
+    }
+
+    PositionColorVertex* v = Reserve(debugDraw, 6);
+    if (v == NULL)
+    {
+        return;
+    }
+
+    glm::vec2 normal = glm::vec2(-direction.y, direction.x) *
+                       (DEBUG_DRAW_LINE_WIDTH * 0.5f / length);
+
+    WriteVertex(&v[0], a - normal, color);
+    WriteVertex(&v[1], b - normal, color);
+    WriteVertex(&v[2], b + normal, color);
+    WriteVertex(&v[3], a - normal, color);
+    WriteVertex(&v[4], b + normal, color);
+    WriteVertex(&v[5], a + normal, color);
+}
+
+// Convex polygon as a triangle fan
+internal void
+PushFan(DebugDraw* debugDraw,
+        const glm::vec2* points,
+        int pointCount,
+        DebugColor color)
+{
+    if (pointCount < 3)
+    {
+        return;
+    }
+
+    PositionColorVertex* v = Reserve(debugDraw, (pointCount - 2) * 3);
+    if (v == NULL)
+    {
+        return;
+    }
+
+    for (int i = 1; i < pointCount - 1; ++i)
+    {
+        WriteVertex(v++, points[0], color);
+        WriteVertex(v++, points[i], color);
+        WriteVertex(v++, points[i + 1], color);
+    }
+}
+
+internal void
+PushOutline(DebugDraw* debugDraw,
+            const glm::vec2* points,
+            int pointCount,
+            DebugColor color)
+{
+    for (int i = 0; i < pointCount; ++i)
+    {
+        PushLine(debugDraw, points[i], points[(i + 1) % pointCount], color);
+    }
+}
+
+internal void
+CirclePoints(glm::vec2 center, float radius, glm::vec2* points)
+{
+    // Rotating a unit vector avoids a sin/cos pair per segment
+    const float angle = 2.0f * (float)PI / DEBUG_DRAW_CIRCLE_SEGMENTS;
+    const float c = SDL_cosf(angle);
+    const float s = SDL_sinf(angle);
+
+    glm::vec2 r = glm::vec2(radius, 0.0f);
+    for (int i = 0; i < DEBUG_DRAW_CIRCLE_SEGMENTS; ++i)
+    {
+        points[i] = center + r;
+        r = glm::vec2(c * r.x - s * r.y, s * r.x + c * r.y);
+    }
+}
+
+// -------------------------------------------------------------------------------
+// Box2D callbacks, userContext is the DebugDraw
+internal void
+DrawPolygon(const b2Vec2* vertices,
+            int vertexCount,
+            b2HexColor color,
+            void* userContext)
+{
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+    debugDraw->stats.shapes += 1;
+
+    glm::vec2 points[B2_MAX_POLYGON_VERTICES];
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        points[i] = ToPixels(vertices[i]);
+    }
+
+    PushOutline(debugDraw, points, vertexCount, ToDebugColor(color, 255));
+}
+
+internal void
+DrawSolidPolygon(b2Transform transform,
+                 const b2Vec2* vertices,
+                 int vertexCount,
+                 float radius,
+                 b2HexColor color,
+                 void* userContext)
+{
+    (void)radius; // Rounded corners are drawn sharp
+
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+    debugDraw->stats.shapes += 1;
+
+    glm::vec2 points[B2_MAX_POLYGON_VERTICES];
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        points[i] = ToPixels(b2TransformPoint(transform, vertices[i]));
+    }
+
+    PushFan(debugDraw,
+            points,
+            vertexCount,
+            ToDebugColor(color, DEBUG_DRAW_FILL_ALPHA));
+    PushOutline(debugDraw, points, vertexCount, ToDebugColor(color, 255));
+}
+
+internal void
+DrawCircle(b2Vec2 center, float radius, b2HexColor color, void* userContext)
+{
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+    debugDraw->stats.shapes += 1;
+
+    glm::vec2 points[DEBUG_DRAW_CIRCLE_SEGMENTS];
+    CirclePoints(ToPixels(center), PhysicsToPixels(radius), points);
+
+    PushOutline(
+      debugDraw, points, DEBUG_DRAW_CIRCLE_SEGMENTS, ToDebugColor(color, 255));
+}
+
+internal void
+DrawSolidCircle(b2Transform transform,
+                float radius,
+                b2HexColor color,
+                void* userContext)
+{
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+    debugDraw->stats.shapes += 1;
+
+    glm::vec2 center = ToPixels(transform.p);
+    float pixelRadius = PhysicsToPixels(radius);
+
+    // Filled disc plus a line showing the rotation, the full outline would
+    // double the vertex count
+    glm::vec2 points[DEBUG_DRAW_CIRCLE_SEGMENTS];
+    CirclePoints(center, pixelRadius, points);
+    PushFan(debugDraw,
+            points,
+            DEBUG_DRAW_CIRCLE_SEGMENTS,
+            ToDebugColor(color, DEBUG_DRAW_FILL_ALPHA));
+
+    glm::vec2 axis =
+      glm::vec2(transform.q.c, transform.q.s) * pixelRadius + center;
+    PushLine(debugDraw, center, axis, ToDebugColor(color, 255));
+}
+
+internal void
+DrawSolidCapsule(b2Vec2 p1,
+                 b2Vec2 p2,
+                 float radius,
+                 b2HexColor color,
+                 void* userContext)
+{
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+    debugDraw->stats.shapes += 1;
+
+    glm::vec2 a = ToPixels(p1);
+    glm::vec2 b = ToPixels(p2);
+    float pixelRadius = PhysicsToPixels(radius);
+    DebugColor fill = ToDebugColor(color, DEBUG_DRAW_FILL_ALPHA);
+
+    glm::vec2 points[DEBUG_DRAW_CIRCLE_SEGMENTS];
+    CirclePoints(a, pixelRadius, points);
+    PushFan(debugDraw, points, DEBUG_DRAW_CIRCLE_SEGMENTS, fill);
+    CirclePoints(b, pixelRadius, points);
+    PushFan(debugDraw, points, DEBUG_DRAW_CIRCLE_SEGMENTS, fill);
+
+    glm::vec2 direction = b - a;
+    float length = glm::length(direction);
+    if (length > 0.0f)
+    {
+        glm::vec2 normal =
+          glm::vec2(-direction.y, direction.x) * (pixelRadius / length);
+        glm::vec2 body[4] = { a - normal, b - normal, b + normal, a + normal };
+        PushFan(debugDraw, body, 4, fill);
+        PushOutline(debugDraw, body, 4, ToDebugColor(color, 255));
+    }
+}
+
+internal void
+DrawSegment(b2Vec2 p1, b2Vec2 p2, b2HexColor color, void* userContext)
+{
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+    PushLine(debugDraw, ToPixels(p1), ToPixels(p2), ToDebugColor(color, 255));
+}
+
+internal void
+DrawTransform(b2Transform transform, void* userContext)
+{
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+
+    glm::vec2 origin = ToPixels(transform.p);
+    glm::vec2 xAxis = glm::vec2(transform.q.c, transform.q.s);
+    glm::vec2 yAxis = glm::vec2(-transform.q.s, transform.q.c);
+
+    PushLine(debugDraw,
+             origin,
+             origin + xAxis * DEBUG_DRAW_AXIS_LENGTH,
+             (DebugColor){ 255, 0, 0, 255 });
+    PushLine(debugDraw,
+             origin,
+             origin + yAxis * DEBUG_DRAW_AXIS_LENGTH,
+             (DebugColor){ 0, 255, 0, 255 });
+}
+
+internal void
+DrawPoint(b2Vec2 p, float size, b2HexColor color, void* userContext)
+{
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+
+    glm::vec2 center = ToPixels(p);
+    float half = size * 0.5f;
+    glm::vec2 quad[4] = {
+        center + glm::vec2(-half, -half),
+        center + glm::vec2(half, -half),
+        center + glm::vec2(half, half),
+        center + glm::vec2(-half, half),
+    };
+    PushFan(debugDraw, quad, 4, ToDebugColor(color, 255));
+}
+
+// The font has a single color, the text is drawn from p to the right in
+// screen pixels so it keeps its size under the camera's zoom
+internal void
+DrawString(b2Vec2 p, const char* s, b2HexColor color, void* userContext)
+{
+    (void)color;
+    DebugDraw* debugDraw = (DebugDraw*)userContext;
+    Font* font = debugDraw->font;
+    if (font == NULL || font->glyphCount >= DEBUG_DRAW_MAX_GLYPHS)
+    {
+        debugDraw->stats.droppedStrings += 1;
+        return;
+    }
+
+    glm::vec4 clip =
+      debugDraw->viewProjection * glm::vec4(ToPixels(p), 0.0f, 1.0f);
+    int x = (int)((clip.x + 1.0f) * 0.5f * GAME_WIDTH);
+    int y = (int)((1.0f - clip.y) * 0.5f * GAME_HEIGHT);
+
+    FontDrawText(font, x, y, 1, s);
+    debugDraw->stats.strings += 1;
+}
+
+// -------------------------------------------------------------------------------
+internal int
+CreatePipeline(Context* context)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+
+    SDL_GPUShader* vertexShader = RendererLoadShader(
+      context, context->Renderer.Device, "PositionColor.vert", 0, 1, 0, 0);
+    if (vertexShader == NULL)
+    {
+        SDL_Log("Failed to create debug draw vertex shader!");
+        return -1;
+    }
+
+    SDL_GPUShader* fragmentShader = RendererLoadShader(
+      context, context->Renderer.Device, "SolidColor.frag", 0, 0, 0, 0);
+    if (fragmentShader == NULL)
+    {
+        SDL_Log("Failed to create debug draw fragment shader!");
+        SDL_ReleaseGPUShader(context->Renderer.Device, vertexShader);
+        return -1;
+    }
+
+    SDL_GPUVertexBufferDescription vertexBufferDescriptions[] = {
+        {
+          .slot = 0,
+          .pitch = sizeof(PositionColorVertex),
+          .input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX,
+          .instance_step_rate = 0,
+        },
+    };
+
+    SDL_GPUVertexAttribute vertexAttributes[] = {
+        { .location = 0,
+          .buffer_slot = 0,
+          .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3,
+          .offset = 0 },
+        { .location = 1,
+          .buffer_slot = 0,
+          .format = SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM,
+          .offset = sizeof(float) * 3 },
+    };
+
+    SDL_GPUColorTargetDescription colorTargetDescriptions[] = {
+        {
+          .format = SDL_GetGPUSwapchainTextureFormat(context->Renderer.Device,
+                                                     context->Renderer.Window),
+          .blend_state =
+            (SDL_GPUColorTargetBlendState){
+              .src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA,
+              .dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+              .color_blend_op = SDL_GPU_BLENDOP_ADD,
+              .src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
+              .dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+              .alpha_blend_op = SDL_GPU_BLENDOP_ADD,
+              .enable_blend = true,
+            },
+        },
+    };
+
+    SDL_GPUGraphicsPipelineCreateInfo pipelineCreateInfo = {
+        .vertex_shader = vertexShader,
+        .fragment_shader = fragmentShader,
+        .vertex_input_state =
+          (SDL_GPUVertexInputState){
+            .vertex_buffer_descriptions = vertexBufferDescriptions,
+            .num_vertex_buffers = 1,
+            .vertex_attributes = vertexAttributes,
+            .num_vertex_attributes = 2,
+          },
+        .primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
+        .rasterizer_state =
+          (SDL_GPURasterizerState){
+            .fill_mode = SDL_GPU_FILLMODE_FILL,
+            .cull_mode = SDL_GPU_CULLMODE_NONE,
+            .front_face = SDL_GPU_FRONTFACE_CLOCKWISE,
+          },
+        .target_info = {
+          .color_target_descriptions = colorTargetDescriptions,
+          .num_color_targets = 1,
+        },
+    };
+
+    debugDraw->Pipeline = SDL_CreateGPUGraphicsPipeline(
+      context->Renderer.Device, &pipelineCreateInfo);
+
+    SDL_ReleaseGPUShader(context->Renderer.Device, vertexShader);
+    SDL_ReleaseGPUShader(context->Renderer.Device, fragmentShader);
+
+    if (debugDraw->Pipeline == NULL)
+    {
+        SDL_Log("Failed to create debug draw pipeline!");
+        return -1;
+    }
+
+    return 0;
+}
+
+// Replaces both buffers, SDL keeps the old ones alive until the GPU is
+// done with them
+internal int
+CreateBuffers(Context* context, Uint32 capacity)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    SDL_GPUBufferCreateInfo vertexBufferCreateInfo = {
+        .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
+        .size = static_cast<Uint32>(sizeof(PositionColorVertex) * capacity),
+    };
+    SDL_GPUBuffer* vertexBuffer =
+      SDL_CreateGPUBuffer(device, &vertexBufferCreateInfo);
+
+    SDL_GPUTransferBufferCreateInfo transferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = static_cast<Uint32>(sizeof(PositionColorVertex) * capacity),
+    };
+    SDL_GPUTransferBuffer* transferBuffer =
+      SDL_CreateGPUTransferBuffer(device, &transferBufferCreateInfo);
+
+    if (vertexBuffer == NULL || transferBuffer == NULL)
+    {
+        SDL_Log("Could not create the debug draw buffers for %u vertices: %s",
+                capacity,
+                SDL_GetError());
+        if (vertexBuffer != NULL)
+        {
+            SDL_ReleaseGPUBuffer(device, vertexBuffer);
+        }
+        if (transferBuffer != NULL)
+        {
+            SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        }
+        return -1;
+    }
+    SDL_SetGPUBufferName(device, vertexBuffer, "Debug Draw Vertex Buffer");
+
+    if (debugDraw->VertexBuffer != NULL)
+    {
+        SDL_ReleaseGPUBuffer(device, debugDraw->VertexBuffer);
+    }
+    if (debugDraw->TransferBuffer != NULL)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, debugDraw->TransferBuffer);
+    }
+
+    debugDraw->VertexBuffer = vertexBuffer;
+    debugDraw->TransferBuffer = transferBuffer;
+    debugDraw->capacity = capacity;
+
+    return 0;
+}
+
+// Makes room for what the last frame needed, its vertices are uploaded by
+// now
+internal void
+GrowBuffers(Context* context)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+    Uint32 required = debugDraw->requiredVertices;
+    if (required <= debugDraw->capacity ||
+        debugDraw->capacity >= DEBUG_DRAW_MAX_VERTICES)
+    {
+        return;
+    }
+
+    Uint32 capacity = debugDraw->capacity;
+    while (capacity < required && capacity < DEBUG_DRAW_MAX_VERTICES)
+    {
+        capacity *= 2;
+    }
+    capacity = SDL_min(capacity, DEBUG_DRAW_MAX_VERTICES);
+
+    if (CreateBuffers(context, capacity) == 0)
+    {
+        SDL_Log("Debug draw buffers grown to %u vertices%s",
+                capacity,
+                capacity < required ? ", the maximum, some are dropped" : "");
+    }
+}
+
+int
+DebugDrawInit(Context* context)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+
+    // Debug drawing is optional, the game runs fine without it
+    if (CreatePipeline(context) < 0)
+    {
+        debugDraw->isAvailable = false;
+        return -1;
+    }
+
+    if (CreateBuffers(context, DEBUG_DRAW_INITIAL_VERTICES) < 0)
+    {
+        debugDraw->isAvailable = false;
+        return -1;
+    }
+
+    debugDraw->callbacks = b2DefaultDebugDraw();
+    debugDraw->callbacks.DrawPolygonFcn = DrawPolygon;
+    debugDraw->callbacks.DrawSolidPolygonFcn = DrawSolidPolygon;
+    debugDraw->callbacks.DrawCircleFcn = DrawCircle;
+    debugDraw->callbacks.DrawSolidCircleFcn = DrawSolidCircle;
+    debugDraw->callbacks.DrawSolidCapsuleFcn = DrawSolidCapsule;
+    debugDraw->callbacks.DrawSegmentFcn = DrawSegment;
+    debugDraw->callbacks.DrawTransformFcn = DrawTransform;
+    debugDraw->callbacks.DrawPointFcn = DrawPoint;
+    debugDraw->callbacks.DrawStringFcn = DrawString;
+    debugDraw->callbacks.drawShapes = true;
+    debugDraw->callbacks.context = debugDraw;
+
+    debugDraw->isAvailable = true;
+
+    return 0;
+}
+
+void
+DebugDrawToggle(Context* context)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+    if (!debugDraw->isAvailable)
+    {
+        return;
+    }
+
+    if (!debugDraw->isEnabled)
+    {
+        debugDraw->isEnabled = true;
+        debugDraw->callbacks.drawMass = false;
+    }
+    else if (!debugDraw->callbacks.drawMass && context->font.isAvailable)
+    {
+        debugDraw->callbacks.drawMass = true;
+    }
+    else
+    {
+        debugDraw->isEnabled = false;
+    }
+
+    SDL_Log("Physics debug draw: %s",
+            !debugDraw->isEnabled          ? "off"
+            : debugDraw->callbacks.drawMass ? "shapes and mass"
+                                            : "shapes");
+}
+
+void
+DebugDrawBuild(Context* context)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+    debugDraw->vertexCount = 0;
+    debugDraw->stats = (DebugDrawStats){ 0 };
+
+    if (!debugDraw->isEnabled || !debugDraw->isAvailable)
+    {
+        return;
+    }
+
+    GrowBuffers(context);
+
+    // Box2D skips everything outside of the camera's view
+    glm::vec2 viewMin;
+    glm::vec2 viewMax;
+    CameraBounds(&context->camera, &viewMin, &viewMax);
+    debugDraw->callbacks.useDrawingBounds = true;
+    debugDraw->callbacks.drawingBounds = (b2AABB){
+        .lowerBound = (b2Vec2){ PhysicsToMeters(viewMin.x),
+                                PhysicsToMeters(viewMin.y) },
+        .upperBound = (b2Vec2){ PhysicsToMeters(viewMax.x),
+                                PhysicsToMeters(viewMax.y) },
+    };
+
+    // Text is queued on the font before it builds
+    debugDraw->font = context->font.isAvailable ? &context->font : NULL;
+    debugDraw->viewProjection = CameraViewProjection(&context->camera);
+
+    // The callbacks write straight into the mapped transfer buffer
+    debugDraw->vertices =
+      static_cast<PositionColorVertex*>(SDL_MapGPUTransferBuffer(
+        context->Renderer.Device, debugDraw->TransferBuffer, true));
+
+    b2World_Draw(context->worldId, &debugDraw->callbacks);
+
+    SDL_UnmapGPUTransferBuffer(context->Renderer.Device,
+                               debugDraw->TransferBuffer);
+    debugDraw->vertices = NULL;
+
+    debugDraw->stats.vertices = debugDraw->vertexCount;
+    debugDraw->requiredVertices =
+      debugDraw->vertexCount + debugDraw->stats.droppedVertices;
+}
+
+void
+DebugDrawUpload(Context* context, SDL_GPUCopyPass* copyPass)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+    if (debugDraw->vertexCount == 0)
+    {
+        return;
+    }
+
+    SDL_GPUTransferBufferLocation transferLocation = {
+        .transfer_buffer = debugDraw->TransferBuffer,
+        .offset = 0,
+    };
+    SDL_GPUBufferRegion vertexBufferRegion = {
+        .buffer = debugDraw->VertexBuffer,
+        .offset = 0,
+        .size = static_cast<Uint32>(sizeof(PositionColorVertex) *
+                                    debugDraw->vertexCount),
+    };
+    SDL_UploadToGPUBuffer(
+      copyPass, &transferLocation, &vertexBufferRegion, true);
+}
+
+void
+DebugDrawRender(Context* context, SDL_GPURenderPass* renderPass)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+    if (debugDraw->vertexCount == 0)
+    {
+        return;
+    }
+
+    SDL_BindGPUGraphicsPipeline(renderPass, debugDraw->Pipeline);
+
+    SDL_GPUBufferBinding vertexBufferBinding = {
+        .buffer = debugDraw->VertexBuffer,
+        .offset = 0,
+    };
+    SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
+
+    SDL_DrawGPUPrimitives(renderPass, debugDraw->vertexCount, 1, 0, 0);
+    RendererCountDraw(&context->Renderer);
+}
+
+void
+DebugDrawDestroy(Context* context)
+{
+    DebugDraw* debugDraw = &context->debugDraw;
+
+    if (debugDraw->Pipeline != nullptr)
+    {
+        SDL_ReleaseGPUGraphicsPipeline(context->Renderer.Device,
+                                       debugDraw->Pipeline);
+    }
+
+    if (debugDraw->VertexBuffer != nullptr)
+    {
+        SDL_ReleaseGPUBuffer(context->Renderer.Device, debugDraw->VertexBuffer);
+    }
+
+    if (debugDraw->TransferBuffer != nullptr)
+    {
+        SDL_ReleaseGPUTransferBuffer(context->Renderer.Device,
+                                     debugDraw->TransferBuffer);
+    }
+
+    *debugDraw = (DebugDraw){ 0 };
+}
@@ -0,0 +1,191 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "context.hpp"
+#include "dynamic_resolution.hpp"
+#include "includes.hpp"
+
+// -------------------------------------------------------------------------------
+// The window's integer scale, the resolution never goes above native
+internal float
+MaxScale(const Context* context)
+{
+    return SDL_max((float)context->scale, 1.0f);
+}
+
+internal float
+BudgetMs(const Context* context)
+{
+    const DynamicResolution* controller = &context->dynamicResolution;
+    if (controller->budgetMs > 0.0f)
+    {
+        return controller->budgetMs;
+    }
+
+    Uint64 frameNS = context->framePacer.frameNS;
+    return frameNS > 0 ? (float)(frameNS / 1e6) : 1000.0f / 60.0f;
+}
+
+internal float
+StepSize(float scale)
+{
+    float step = SDL_max(scale * DYNAMIC_RESOLUTION_STEP_FRACTION,
+                         DYNAMIC_RESOLUTION_STEP);
+    return SDL_ceilf(step / DYNAMIC_RESOLUTION_STEP) * DYNAMIC_RESOLUTION_STEP;
+}
+
+internal void
+SetScale(DynamicResolution* controller, float scale)
+{
+    controller->scale = scale;
+    controller->overFrames = 0;
+    controller->underFrames = 0;
+    controller->cooldownFrames = DYNAMIC_RESOLUTION_COOLDOWN_FRAMES;
+    controller->stats.minScale = SDL_min(controller->stats.minScale, scale);
+}
+
+// -------------------------------------------------------------------------------
+void
+DynamicResolutionInit(Context* context, float budgetMs)
+{
+    DynamicResolution* controller = &context->dynamicResolution;
+    *controller = (DynamicResolution){ 0 };
+    controller->isEnabled = budgetMs > 0.0f;
+    controller->budgetMs = budgetMs;
+    controller->scale = MaxScale(context);
+    controller->stats.minScale = controller->scale;
+}
+
+void
+DynamicResolutionToggle(Context* context)
+{
+    DynamicResolution* controller = &context->dynamicResolution;
+    if (!context->post.isAvailable)
+    {
+        return;
+    }
+
+    // Start from native, the first frames tell whether it is affordable
+    controller->isEnabled = !controller->isEnabled;
+    SetScale(controller, MaxScale(context));
+    controller->stats.minScale = controller->scale;
+    controller->smoothedMs = 0.0f;
+
+    SDL_Log("Dynamic resolution: %s, budget %.2f ms",
+            controller->isEnabled ? "on" : "off",
+            BudgetMs(context));
+}
+
+bool
+DynamicResolutionIsActive(const Context* context)
+{
+    // The upscale is the post chain's
+    return context->dynamicResolution.isEnabled && context->post.isAvailable;
+}
+
+void
+DynamicResolutionUpdate(Context* context, float deltaTime)
+{
+    DynamicResolution* controller = &context->dynamicResolution;
+    const FramePacerStats* pacer = &context->framePacer.stats;
+
+    // The pacer stats start over when its target changes
+    if (pacer->sleepNS + pacer->spinNS <
+        controller->lastPacer.sleepNS + controller->lastPacer.spinNS)
+    {
+        controller->lastPacer = (FramePacerStats){ 0 };
+    }
+    double waitMs = (pacer->sleepNS + pacer->spinNS -
+                     controller->lastPacer.sleepNS -
+                     controller->lastPacer.spinNS) /
+                    1e6;
+    controller->lastPacer = *pacer;
+
+    if (!DynamicResolutionIsActive(context))
+    {
+        return;
+    }
+
+    // A resize may have moved the ceiling
+    float maxScale = MaxScale(context);
+    if (controller->scale > maxScale)
+    {
+        SetScale(controller, maxScale);
+    }
+
+    float busyMs = SDL_max(deltaTime * 1000.0f - (float)waitMs, 0.0f);
+    controller->smoothedMs =
+      controller->smoothedMs > 0.0f
+        ? controller->smoothedMs +
+            (busyMs - controller->smoothedMs) * DYNAMIC_RESOLUTION_SMOOTHING
+        : busyMs;
+
+    if (controller->cooldownFrames > 0)
+    {
+        controller->cooldownFrames -= 1;
+        return;
+    }
+
+    float budgetMs = BudgetMs(context);
+    if (controller->smoothedMs > budgetMs * DYNAMIC_RESOLUTION_HIGH)
+    {
+        controller->overFrames += 1;
+        controller->underFrames = 0;
+    }
+    else if (controller->smoothedMs < budgetMs * DYNAMIC_RESOLUTION_LOW)
+    {
+        controller->underFrames += 1;
+        controller->overFrames = 0;
+    }
+    else
+    {
+        controller->overFrames = 0;
+        controller->underFrames = 0;
+    }
+
+    if (controller->overFrames >= DYNAMIC_RESOLUTION_DOWN_FRAMES &&
+        controller->scale > DYNAMIC_RESOLUTION_MIN_SCALE)
+    {
+        SetScale(controller,
+                 SDL_max(controller->scale - StepSize(controller->scale),
+                         DYNAMIC_RESOLUTION_MIN_SCALE));
+        controller->stats.stepsDown += 1;
+    }
+    else if (controller->underFrames >= DYNAMIC_RESOLUTION_UP_FRAMES &&
+             controller->scale < maxScale)
+    {
+        SetScale(controller,
+                 SDL_min(controller->scale + StepSize(controller->scale),
+                         maxScale));
+        controller->stats.stepsUp += 1;
+    }
+}
+
+void
+DynamicResolutionGetSize(const Context* context,
+                         Uint32* width,
+                         Uint32* height)
+{
+    float scale = DynamicResolutionIsActive(context)
+                    ? context->dynamicResolution.scale
+                    : 1.0f;
+    *width = (Uint32)(GAME_WIDTH * scale + 0.5f);
+    *height = (Uint32)(GAME_HEIGHT * scale + 0.5f);
+}
+
+void
+DynamicResolutionPrintStats(const DynamicResolution* controller)
+{
+    printf("Dynamic resolution: %s, scale %.3f (lowest %.3f), "
+           "%llu steps down, %llu up\n",
+           controller->isEnabled ? "on" : "off",
+           controller->scale,
+           controller->stats.minScale,
+           (unsigned long long)controller->stats.stepsDown,
+           (unsigned long long)controller->stats.stepsUp);
+}
@@ -0,0 +1,579 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "context.hpp"
+#include "font.hpp"
+#include "includes.hpp"
+#include "profiler.hpp"
+
+constexpr Uint32 FONT_COLOR = 0xffffffffu;  // RGBA8, white
+constexpr Uint32 FONT_SHADOW = 0xff000000u; // Opaque black
+
+// One byte per row, bit 0 is the leftmost column. Printable ASCII from
+// FONT_FIRST_CHAR.
+global_variable const Uint8 FontGlyphs[FONT_CHAR_COUNT][FONT_GLYPH_HEIGHT] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // Space
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 }, // !
+    { 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00 }, // "
+    { 0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a }, // #
+    { 0x04, 0x1e, 0x05, 0x0e, 0x14, 0x0f, 0x04 }, // $
+    { 0x03, 0x13, 0x08, 0x04, 0x02, 0x19, 0x18 }, // %
+    { 0x06, 0x09, 0x05, 0x02, 0x15, 0x09, 0x16 }, // &
+    { 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '
+    { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // (
+    { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // )
+    { 0x00, 0x04, 0x15, 0x0e, 0x15, 0x04, 0x00 }, // *
+    { 0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00 }, // +
+    { 0x00, 0x00, 0x00, 0x00, 0x06, 0x04, 0x02 }, // ,
+    { 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00 }, // -
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06 }, // .
+    { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 }, // /
+    { 0x0e, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0e }, // 0
+    { 0x04, 0x06, 0x04, 0x04, 0x04, 0x04, 0x0e }, // 1
+    { 0x0e, 0x11, 0x10, 0x08, 0x04, 0x02, 0x1f }, // 2
+    { 0x1f, 0x08, 0x04, 0x08, 0x10, 0x11, 0x0e }, // 3
+    { 0x08, 0x0c, 0x0a, 0x09, 0x1f, 0x08, 0x08 }, // 4
+    { 0x1f, 0x01, 0x0f, 0x10, 0x10, 0x11, 0x0e }, // 5
+    { 0x0c, 0x02, 0x01, 0x0f, 0x11, 0x11, 0x0e }, // 6
+    { 0x1f, 0x10, 0x08, 0x04, 0x02, 0x02, 0x02 }, // 7
+    { 0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e }, // 8
+    { 0x0e, 0x11, 0x11, 0x1e, 0x10, 0x08, 0x06 }, // 9
+    { 0x00, 0x06, 0x06, 0x00, 0x06, 0x06, 0x00 }, // :
+    { 0x00, 0x06, 0x06, 0x00, 0x06, 0x04, 0x02 }, // ;
+    { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // <
+    { 0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00 }, // =
+    { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // >
+    { 0x0e, 0x11, 0x10, 0x08, 0x04, 0x00, 0x04 }, // ?
+    { 0x0e, 0x11, 0x10, 0x16, 0x15, 0x15, 0x0e }, // @
+    { 0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 }, // A
+    { 0x0f, 0x11, 0x11, 0x0f, 0x11, 0x11, 0x0f }, // B
+    { 0x0e, 0x11, 0x01, 0x01, 0x01, 0x11, 0x0e }, // C
+    { 0x07, 0x09, 0x11, 0x11, 0x11, 0x09, 0x07 }, // D
+    { 0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x1f }, // E
+    { 0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x01 }, // F
+    { 0x0e, 0x11, 0x01, 0x1d, 0x11, 0x11, 0x1e }, // G
+    { 0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 }, // H
+    { 0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e }, // I
+    { 0x1c, 0x08, 0x08, 0x08, 0x08, 0x09, 0x06 }, // J
+    { 0x11, 0x09, 0x05, 0x03, 0x05, 0x09, 0x11 }, // K
+    { 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x1f }, // L
+    { 0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11 }, // M
+    { 0x11, 0x11, 0x13, 0x15, 0x19, 0x11, 0x11 }, // N
+    { 0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e }, // O
+    { 0x0f, 0x11, 0x11, 0x0f, 0x01, 0x01, 0x01 }, // P
+    { 0x0e, 0x11, 0x11, 0x11, 0x15, 0x09, 0x16 }, // Q
+    { 0x0f, 0x11, 0x11, 0x0f, 0x05, 0x09, 0x11 }, // R
+    { 0x1e, 0x01, 0x01, 0x0e, 0x10, 0x10, 0x0f }, // S
+    { 0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // T
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e }, // U
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04 }, // V
+    { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a }, // W
+    { 0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11 }, // X
+    { 0x11, 0x11, 0x11, 0x0a, 0x04, 0x04, 0x04 }, // Y
+    { 0x1f, 0x10, 0x08, 0x04, 0x02, 0x01, 0x1f }, // Z
+    { 0x0e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0e }, // [
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // Backslash
+    { 0x0e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0e }, // ]
+    { 0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00 }, // ^
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f }, // _
+    { 0x02, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 }, // `
+    { 0x00, 0x00, 0x0e, 0x10, 0x1e, 0x11, 0x1e }, // a
+    { 0x01, 0x01, 0x0d, 0x13, 0x11, 0x11, 0x0f }, // b
+    { 0x00, 0x00, 0x0e, 0x01, 0x01, 0x11, 0x0e }, // c
+    { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1e }, // d
+    { 0x00, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x0e }, // e
+    { 0x0c, 0x12, 0x02, 0x07, 0x02, 0x02, 0x02 }, // f
+    { 0x00, 0x1e, 0x11, 0x11, 0x1e, 0x10, 0x0e }, // g
+    { 0x01, 0x01, 0x0d, 0x13, 0x11, 0x11, 0x11 }, // h
+    { 0x04, 0x00, 0x06, 0x04, 0x04, 0x04, 0x0e }, // i
+    { 0x08, 0x00, 0x0c, 0x08, 0x08, 0x09, 0x06 }, // j
+    { 0x01, 0x01, 0x09, 0x05, 0x03, 0x05, 0x09 }, // k
+    { 0x06, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e }, // l
+    { 0x00, 0x00, 0x0b, 0x15, 0x15, 0x11, 0x11 }, // m
+    { 0x00, 0x00, 0x0d, 0x13, 0x11, 0x11, 0x11 }, // n
+    { 0x00, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e }, // o
+    { 0x00, 0x00, 0x0f, 0x11, 0x0f, 0x01, 0x01 }, // p
+    { 0x00, 0x00, 0x16, 0x19, 0x1e, 0x10, 0x10 }, // q
+    { 0x00, 0x00, 0x0d, 0x13, 0x01, 0x01, 0x01 }, // r
+    { 0x00, 0x00, 0x0e, 0x01, 0x0e, 0x10, 0x0f }, // s
+    { 0x02, 0x02, 0x07, 0x02, 0x02, 0x12, 0x0c }, // t
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x19, 0x16 }, // u
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x0a, 0x04 }, // v
+    { 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0a }, // w
+    { 0x00, 0x00, 0x11, 0x0a, 0x04, 0x0a, 0x11 }, // x
+    { 0x00, 0x00, 0x11, 0x11, 0x1e, 0x10, 0x0e }, // y
+    { 0x00, 0x00, 0x1f, 0x08, 0x04, 0x02, 0x1f }, // z
+    { 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 }, // {
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // |
+    { 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 }, // }
+    { 0x00, 0x00, 0x02, 0x15, 0x08, 0x00, 0x00 }, // ~
+};
+
+// -------------------------------------------------------------------------------
+internal void
+Unlink(Font* font, Sint16 slot)
+{
+    FontSlot* entry = &font->slots[slot];
+    if (entry->previous >= 0)
+    {
+        font->slots[entry->previous].next = entry->next;
+    }
+    else
+    {
+        font->head = entry->next;
+    }
+    if (entry->next >= 0)
+    {
+        font->slots[entry->next].previous = entry->previous;
+    }
+    else
+    {
+        font->tail = entry->previous;
+    }
+}
+
+internal void
+PushFront(Font* font, Sint16 slot)
+{
+    FontSlot* entry = &font->slots[slot];
+    entry->previous = -1;
+    entry->next = font->head;
+    if (font->head >= 0)
+    {
+        font->slots[font->head].previous = slot;
+    }
+    else
+    {
+        font->tail = slot;
+    }
+    font->head = slot;
+}
+
+internal void
+FillBlock(Uint32* pixels, int x, int y, int size, Uint32 color)
+{
+    for (int row = y; row < y + size; ++row)
+    {
+        for (int column = x; column < x + size; ++column)
+        {
+            pixels[row * FONT_SLOT_WIDTH + column] = color;
+        }
+    }
+}
+
+// Shadow first, one scaled pixel down and to the right, then the glyph
+internal void
+RasterizeGlyph(Uint32* pixels, int charIndex, int scale)
+{
+    SDL_memset(pixels, 0, sizeof(Uint32) * FONT_SLOT_PIXELS);
+
+    const Uint8* rows = FontGlyphs[charIndex];
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        int offset = pass == 0 ? scale : 0;
+        Uint32 color = pass == 0 ? FONT_SHADOW : FONT_COLOR;
+        for (int row = 0; row < FONT_GLYPH_HEIGHT; ++row)
+        {
+            for (int column = 0; column < FONT_GLYPH_WIDTH; ++column)
+            {
+                if (rows[row] & (1 << column))
+                {
+                    FillBlock(pixels,
+                              column * scale + offset,
+                              row * scale + offset,
+                              scale,
+                              color);
+                }
+            }
+        }
+    }
+}
+
+// Slot holding the glyph, rasterizing it on a miss. -1 if every slot is
+// already in use this frame.
+internal Sint16
+CacheGlyph(Font* font, int charIndex, int scale)
+{
+    int glyph = charIndex * FONT_MAX_SCALE + scale - 1;
+    Sint16 slot = font->slotFor[glyph];
+    if (slot >= 0)
+    {
+        font->current.hits += 1;
+    }
+    else
+    {
+        // The least recently used slot, unless this frame's quads point
+        // into it
+        slot = font->tail;
+        FontSlot* entry = &font->slots[slot];
+        if (entry->lastUsedFrame == font->frame)
+        {
+            return -1;
+        }
+
+        if (entry->glyph >= 0)
+        {
+            font->slotFor[entry->glyph] = -1;
+            font->current.evictions += 1;
+        }
+        entry->glyph = (Sint16)glyph;
+        font->slotFor[glyph] = slot;
+        font->current.misses += 1;
+
+        RasterizeGlyph(font->slotPixels[slot], charIndex, scale);
+        if (!font->isPending[slot])
+        {
+            font->isPending[slot] = 1;
+            font->pendingSlots[font->pendingCount++] = slot;
+        }
+    }
+
+    font->slots[slot].lastUsedFrame = font->frame;
+    if (font->head != slot)
+    {
+        Unlink(font, slot);
+        PushFront(font, slot);
+    }
+
+    return slot;
+}
+
+// -------------------------------------------------------------------------------
+int
+FontInit(Context* context)
+{
+    Font* font = &context->font;
+    SDL_GPUDevice* device = context->Renderer.Device;
+    FontInitCache(font);
+
+    SDL_GPUTextureCreateInfo atlasCreateInfo = {
+        .type = SDL_GPU_TEXTURETYPE_2D,
+        .format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
+        .usage = SDL_GPU_TEXTUREUSAGE_SAMPLER,
+        .width = FONT_ATLAS_SIZE,
+        .height = FONT_ATLAS_SIZE,
+        .layer_count_or_depth = 1,
+        .num_levels = 1,
+    };
+    font->Atlas = SDL_CreateGPUTexture(device, &atlasCreateInfo);
+    if (font->Atlas != NULL)
+    {
+        SDL_SetGPUTextureName(device, font->Atlas, "Font Atlas");
+    }
+
+    SDL_GPUTransferBufferCreateInfo transferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = static_cast<Uint32>(sizeof(PositionTextureVertex) * 4 *
+                                    FONT_MAX_GLYPHS),
+    };
+    font->TransferBuffer =
+      SDL_CreateGPUTransferBuffer(device, &transferBufferCreateInfo);
+
+    SDL_GPUTransferBufferCreateInfo atlasTransferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = static_cast<Uint32>(sizeof(font->slotPixels)),
+    };
+    font->AtlasTransferBuffer =
+      SDL_CreateGPUTransferBuffer(device, &atlasTransferBufferCreateInfo);
+
+    if (font->Atlas == NULL || font->TransferBuffer == NULL ||
+        font->AtlasTransferBuffer == NULL)
+    {
+        SDL_Log("Could not create the font resources: %s", SDL_GetError());
+        FontDestroy(context);
+        return -1;
+    }
+
+    font->isAvailable = true;
+
+    return 0;
+}
+
+void
+FontInitCache(Font* font)
+{
+    for (int i = 0; i < FONT_SLOT_COUNT; ++i)
+    {
+        font->slots[i] = (FontSlot){
+            .glyph = -1,
+            .previous = (Sint16)(i - 1),
+            .next = (Sint16)(i + 1 < FONT_SLOT_COUNT ? i + 1 : -1),
+            .lastUsedFrame = 0,
+        };
+    }
+    font->head = 0;
+    font->tail = FONT_SLOT_COUNT - 1;
+    font->frame = 1;
+
+    for (int i = 0; i < FONT_CHAR_COUNT * FONT_MAX_SCALE; ++i)
+    {
+        font->slotFor[i] = -1;
+    }
+
+    SDL_memset(font->isPending, 0, sizeof(font->isPending));
+    font->pendingCount = 0;
+    font->glyphCount = 0;
+    font->current = (FontStats){ 0 };
+}
+
+int
+FontDrawText(Font* font, int x, int y, int scale, const char* text)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    scale = SDL_clamp(scale, 1, FONT_MAX_SCALE);
+
+    const float texel = 1.0f / FONT_ATLAS_SIZE;
+    const float width = (float)(FONT_ADVANCE * scale);
+    const float height = (float)((FONT_GLYPH_HEIGHT + 1) * scale);
+
+    int lineX = x;
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        if (*c == '\n')
+        {
+            x = lineX;
+            y += FONT_LINE_HEIGHT * scale;
+            continue;
+        }
+
+        int charIndex = (unsigned char)*c - FONT_FIRST_CHAR;
+        if (charIndex < 0 || charIndex >= FONT_CHAR_COUNT)
+        {
+            charIndex = '?' - FONT_FIRST_CHAR;
+        }
+
+        int glyphX = x;
+        x += FONT_ADVANCE * scale;
+        if (charIndex == 0)
+        {
+            continue; // Space
+        }
+
+        Sint16 slot = -1;
+        if (font->glyphCount < FONT_MAX_GLYPHS)
+        {
+            slot = CacheGlyph(font, charIndex, scale);
+        }
+        if (slot < 0)
+        {
+            font->current.dropped += 1;
+            continue;
+        }
+
+        float u = (float)(slot % FONT_SLOTS_PER_ROW * FONT_SLOT_WIDTH) * texel;
+        float v = (float)(slot / FONT_SLOTS_PER_ROW * FONT_SLOT_HEIGHT) * texel;
+        float uEnd = u + width * texel;
+        float vEnd = v + height * texel;
+        float left = (float)glyphX;
+        float right = left + width;
+        float top = (float)y;
+        float bottom = top + height;
+
+        PositionTextureVertex* quad = &font->vertices[font->glyphCount * 4];
+        quad[0] = (PositionTextureVertex){ left, top, 0, u, v };
+        quad[1] = (PositionTextureVertex){ right, top, 0, uEnd, v };
+        quad[2] = (PositionTextureVertex){ right, bottom, 0, uEnd, vEnd };
+        quad[3] = (PositionTextureVertex){ left, bottom, 0, u, vEnd };
+        font->glyphCount += 1;
+    }
+
+    font->current.layoutSeconds += (SDL_GetPerformanceCounter() - start) /
+                                   (double)SDL_GetPerformanceFrequency();
+
+    return x;
+}
+
+int
+FontPrintf(Font* font, int x, int y, int scale, const char* format, ...)
+{
+    char text[FONT_PRINTF_MAX];
+    va_list args;
+    va_start(args, format);
+    SDL_vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    return FontDrawText(font, x, y, scale, text);
+}
+
+void
+FontBuild(Context* context)
+{
+    Font* font = &context->font;
+    if (!font->isAvailable)
+    {
+        return;
+    }
+
+    PROFILE_FUNCTION();
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    font->drawCount = 0;
+    if (font->glyphCount > 0)
+    {
+        PositionTextureVertex* vertices =
+          static_cast<PositionTextureVertex*>(
+            SDL_MapGPUTransferBuffer(device, font->TransferBuffer, true));
+        SDL_memcpy(vertices,
+                   font->vertices,
+                   sizeof(PositionTextureVertex) * font->glyphCount * 4);
+        SDL_UnmapGPUTransferBuffer(device, font->TransferBuffer);
+        font->drawCount = font->glyphCount;
+    }
+
+    // Everything still pending goes out, the last copy may not have
+    font->uploadSlotCount = 0;
+    if (font->pendingCount > 0)
+    {
+        Uint32* pixels = static_cast<Uint32*>(
+          SDL_MapGPUTransferBuffer(device, font->AtlasTransferBuffer, true));
+        for (int i = 0; i < font->pendingCount; ++i)
+        {
+            SDL_memcpy(&pixels[i * FONT_SLOT_PIXELS],
+                       font->slotPixels[font->pendingSlots[i]],
+                       sizeof(Uint32) * FONT_SLOT_PIXELS);
+        }
+        SDL_UnmapGPUTransferBuffer(device, font->AtlasTransferBuffer);
+        font->uploadSlotCount = font->pendingCount;
+    }
+
+    font->current.glyphs = font->drawCount;
+    font->stats = font->current;
+    font->current = (FontStats){ 0 };
+    font->glyphCount = 0;
+    font->frame += 1;
+}
+
+void
+FontUpload(Context* context, SDL_GPUCopyPass* copyPass)
+{
+    Font* font = &context->font;
+    GameRenderer* renderer = &context->Renderer;
+    if (!font->isAvailable)
+    {
+        return;
+    }
+
+    for (int i = 0; i < font->uploadSlotCount; ++i)
+    {
+        Sint16 slot = font->pendingSlots[i];
+        int slotX = slot % FONT_SLOTS_PER_ROW * FONT_SLOT_WIDTH;
+        int slotY = slot / FONT_SLOTS_PER_ROW * FONT_SLOT_HEIGHT;
+        SDL_GPUTextureTransferInfo transferInfo = {
+            .transfer_buffer = font->AtlasTransferBuffer,
+            .offset = static_cast<Uint32>(sizeof(Uint32) * FONT_SLOT_PIXELS) *
+                      (Uint32)i,
+            .pixels_per_row = FONT_SLOT_WIDTH,
+            .rows_per_layer = FONT_SLOT_HEIGHT,
+        };
+        SDL_GPUTextureRegion atlasRegion = {
+            .texture = font->Atlas,
+            .x = static_cast<Uint32>(slotX),
+            .y = static_cast<Uint32>(slotY),
+            .w = FONT_SLOT_WIDTH,
+            .h = FONT_SLOT_HEIGHT,
+            .d = 1,
+        };
+        SDL_UploadToGPUTexture(copyPass, &transferInfo, &atlasRegion, false);
+        font->isPending[slot] = 0;
+    }
+    font->stats.uploadedBytes =
+      sizeof(Uint32) * FONT_SLOT_PIXELS * font->uploadSlotCount;
+
+    // Anything rasterized after the build waits for the next one
+    font->pendingCount -= font->uploadSlotCount;
+    SDL_memmove(font->pendingSlots,
+                &font->pendingSlots[font->uploadSlotCount],
+                sizeof(Sint16) * font->pendingCount);
+    font->uploadSlotCount = 0;
+
+    if (font->drawCount > 0)
+    {
+        SDL_GPUTransferBufferLocation transferLocation = {
+            .transfer_buffer = font->TransferBuffer,
+            .offset = 0,
+        };
+        SDL_GPUBufferRegion vertexBufferRegion = {
+            .buffer = renderer->VertexBuffer,
+            .offset = static_cast<Uint32>(sizeof(PositionTextureVertex) * 4 *
+                                          RendererTextFirstSlot(renderer)),
+            .size = static_cast<Uint32>(sizeof(PositionTextureVertex) * 4 *
+                                        font->drawCount),
+        };
+        // Not cycled, the buffer also holds the sprites and particles
+        SDL_UploadToGPUBuffer(
+          copyPass, &transferLocation, &vertexBufferRegion, false);
+        font->stats.uploadedBytes += vertexBufferRegion.size;
+    }
+}
+
+void
+FontRender(Context* context, SDL_GPURenderPass* renderPass)
+{
+    Font* font = &context->font;
+    GameRenderer* renderer = &context->Renderer;
+    if (!font->isAvailable || font->drawCount == 0)
+    {
+        return;
+    }
+
+    SDL_BindGPUGraphicsPipeline(renderPass, renderer->Pipeline);
+
+    SDL_GPUBufferBinding vertexBufferBinding = {
+        .buffer = renderer->VertexBuffer,
+        .offset = 0,
+    };
+    SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
+
+    SDL_GPUBufferBinding indexBufferBinding = {
+        .buffer = renderer->IndexBuffer,
+        .offset = 0,
+    };
+    SDL_BindGPUIndexBuffer(
+      renderPass, &indexBufferBinding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+
+    // PointClamp keeps the glyphs crisp
+    SDL_GPUTextureSamplerBinding textureSamplerBinding = {
+        .texture = font->Atlas,
+        .sampler = renderer->Samplers[0],
+    };
+    SDL_BindGPUFragmentSamplers(renderPass, 0, &textureSamplerBinding, 1);
+
+    SDL_DrawGPUIndexedPrimitives(renderPass,
+                                 (Uint32)font->drawCount * 6,
+                                 1,
+                                 (Uint32)RendererTextFirstSlot(renderer) * 6,
+                                 0,
+                                 0);
+    RendererCountDraw(renderer);
+}
+
+void
+FontDestroy(Context* context)
+{
+    Font* font = &context->font;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    if (font->Atlas != NULL)
+    {
+        SDL_ReleaseGPUTexture(device, font->Atlas);
+    }
+    if (font->TransferBuffer != NULL)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, font->TransferBuffer);
+    }
+    if (font->AtlasTransferBuffer != NULL)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, font->AtlasTransferBuffer);
+    }
+
+    font->Atlas = NULL;
+    font->TransferBuffer = NULL;
+    font->AtlasTransferBuffer = NULL;
+    font->isAvailable = false;
+}
@@ -0,0 +1,96 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Our code
+#include "frame_pacer.hpp"
+#include "includes.hpp"
+
+// -------------------------------------------------------------------------------
+void
+FramePacerSetTarget(FramePacer* pacer, float targetFps)
+{
+    pacer->targetFps = SDL_max(targetFps, 0.0f);
+    pacer->frameNS =
+      pacer->targetFps > 0.0f ? (Uint64)(1e9 / pacer->targetFps) : 0;
+    pacer->nextDeadline = SDL_GetTicksNS() + pacer->frameNS;
+    pacer->stats = (FramePacerStats){ 0 };
+}
+
+void
+FramePacerInit(FramePacer* pacer, float targetFps)
+{
+    *pacer = (FramePacer){ 0 };
+    FramePacerSetTarget(pacer, targetFps);
+}
+
+void
+FramePacerWait(FramePacer* pacer)
+{
+    if (pacer->frameNS == 0)
+    {
+        return;
+    }
+
+    FramePacerStats* stats = &pacer->stats;
+    Uint64 deadline = pacer->nextDeadline;
+    Uint64 now = SDL_GetTicksNS();
+
+    if (now >= deadline)
+    {
+        // Late, start a new grid from here rather than rushing the next
+        // frames to catch up
+        stats->missedFrames += 1;
+        pacer->nextDeadline = now + pacer->frameNS;
+        return;
+    }
+
+    Uint64 remaining = deadline - now;
+    if (remaining > FRAME_PACER_SPIN_NS)
+    {
+        SDL_DelayPrecise(remaining - FRAME_PACER_SPIN_NS);
+    }
+
+    Uint64 spinStart = SDL_GetTicksNS();
+    stats->sleepNS += spinStart - now;
+
+    while (SDL_GetTicksNS() < deadline)
+    {
+        SDL_CPUPauseInstruction();
+    }
+
+    now = SDL_GetTicksNS();
+    stats->spinNS += now > spinStart ? now - spinStart : 0;
+
+    // The sleep can still overshoot when the scheduler is busy
+    pacer->lastError = now - deadline;
+    stats->pacedFrames += 1;
+    stats->errorSum += (double)pacer->lastError;
+    stats->errorMax = SDL_max(stats->errorMax, pacer->lastError);
+
+    pacer->nextDeadline = deadline + pacer->frameNS;
+}
+
+void
+FramePacerPrintStats(const FramePacer* pacer)
+{
+    const FramePacerStats* stats = &pacer->stats;
+    if (pacer->frameNS == 0 || stats->pacedFrames == 0)
+    {
+        return;
+    }
+
+    Uint64 frames = stats->pacedFrames + stats->missedFrames;
+    double waitNS = (double)SDL_max(stats->sleepNS + stats->spinNS, 1);
+    printf("Frame pacer: %.1f fps target, %llu/%llu frames paced, "
+           "error %.1f us mean %.1f us max, sleep %.1f%% spin %.1f%%\n",
+           pacer->targetFps,
+           (unsigned long long)stats->pacedFrames,
+           (unsigned long long)frames,
+           stats->errorSum / stats->pacedFrames / 1000.0,
+           stats->errorMax / 1000.0,
+           100.0 * stats->sleepNS / waitNS,
+           100.0 * stats->spinNS / waitNS);
+}
@@ -0,0 +1,137 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glm/glm.hpp>
+#include <glm/vec2.hpp>
+
+#include <box2d/box2d.h>
+
+// Our code
+#include "context.hpp"
+#include "frame_pipeline.hpp"
+#include "includes.hpp"
+#include "profiler.hpp"
+
+// -------------------------------------------------------------------------------
+internal double
+ElapsedSeconds(Uint64 start)
+{
+    return (SDL_GetPerformanceCounter() - start) /
+           (double)SDL_GetPerformanceFrequency();
+}
+
+void
+FramePipelineSimulate(FramePipeline* pipeline, float deltaTime)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    PROFILE_ZONE("Simulate");
+    pipeline->simulate(pipeline->context, deltaTime);
+    pipeline->stats.simulateSeconds += ElapsedSeconds(start);
+}
+
+internal int
+SimulationThread(void* data)
+{
+    FramePipeline* pipeline = (FramePipeline*)data;
+    ProfilerSetThreadName("Simulation");
+
+    while (true)
+    {
+        SDL_WaitSemaphore(pipeline->startSimulation);
+        if (pipeline->isQuitting)
+        {
+            break;
+        }
+
+        FramePipelineSimulate(pipeline, pipeline->deltaTime);
+        SDL_SignalSemaphore(pipeline->simulationDone);
+    }
+
+    return 0;
+}
+
+int
+FramePipelineInit(Context* context,
+                  FrameSimulateFunction* simulate,
+                  bool isEnabled)
+{
+    FramePipeline* pipeline = &context->framePipeline;
+    pipeline->context = context;
+    pipeline->simulate = simulate;
+    pipeline->isEnabled = isEnabled;
+
+    pipeline->startSimulation = SDL_CreateSemaphore(0);
+    pipeline->simulationDone = SDL_CreateSemaphore(0);
+    if (pipeline->startSimulation == NULL || pipeline->simulationDone == NULL)
+    {
+        SDL_Log("Failed to create the frame pipeline semaphores: %s",
+                SDL_GetError());
+        return -1;
+    }
+
+    // The thread is started even when disabled so the mode can be toggled
+    pipeline->thread =
+      SDL_CreateThread(SimulationThread, "Simulation", pipeline);
+    if (pipeline->thread == NULL)
+    {
+        SDL_Log("Failed to create the simulation thread: %s", SDL_GetError());
+        pipeline->isEnabled = false;
+    }
+
+    return 0;
+}
+
+void
+FramePipelineKick(FramePipeline* pipeline, float deltaTime)
+{
+    Assert(!pipeline->isSimulating);
+
+    pipeline->deltaTime = deltaTime;
+    pipeline->isSimulating = true;
+    SDL_SignalSemaphore(pipeline->startSimulation);
+}
+
+void
+FramePipelineWait(FramePipeline* pipeline)
+{
+    if (!pipeline->isSimulating)
+    {
+        return;
+    }
+
+    SDL_WaitSemaphore(pipeline->simulationDone);
+    pipeline->isSimulating = false;
+}
+
+void
+FramePipelineDestroy(Context* context)
+{
+    FramePipeline* pipeline = &context->framePipeline;
+    FramePipelineWait(pipeline);
+
+    if (pipeline->thread != NULL)
+    {
+        pipeline->isQuitting = true;
+        SDL_SignalSemaphore(pipeline->startSimulation);
+        SDL_WaitThread(pipeline->thread, NULL);
+        pipeline->thread = NULL;
+    }
+
+    SDL_DestroySemaphore(pipeline->startSimulation);
+    SDL_DestroySemaphore(pipeline->simulationDone);
+
+    const FramePipelineStats* stats = &pipeline->stats;
+    if (stats->frames > 0)
+    {
+        double toMs = 1000.0 / (double)stats->frames;
+        printf("Frame pipeline (%s): simulate %.3f ms, render %.3f ms, "
+               "frame %.3f ms\n",
+               pipeline->isEnabled ? "pipelined" : "single threaded",
+               stats->simulateSeconds * toMs,
+               stats->renderSeconds * toMs,
+               stats->frameSeconds * toMs);
+    }
+}
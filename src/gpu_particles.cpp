@@ -0,0 +1,637 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "context.hpp"
+#include "gpu_particles.hpp"
+#include "includes.hpp"
+#include "profiler.hpp"
+
+// Byte offset of the draw arguments in the argument buffer
+constexpr Uint32 DRAW_ARGUMENTS_OFFSET = 16;
+constexpr Uint32 ARGUMENT_BUFFER_SIZE =
+  DRAW_ARGUMENTS_OFFSET + sizeof(SDL_GPUIndirectDrawCommand);
+constexpr Uint32 COUNTER_BUFFER_SIZE = sizeof(Uint32) * 4;
+
+// -------------------------------------------------------------------------------
+internal int
+CreatePipelines(Context* context)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    // Particles in, particles out and counters, uniforms
+    SDL_GPUComputePipelineCreateInfo simulateInfo = {
+        .num_readonly_storage_buffers = 1,
+        .num_readwrite_storage_buffers = 2,
+        .num_uniform_buffers = 1,
+        .threadcount_x = GPU_PARTICLES_THREADS,
+        .threadcount_y = 1,
+        .threadcount_z = 1,
+    };
+    particles->SimulatePipeline = RendererLoadComputePipeline(
+      context, device, "ParticleSimulate.comp", &simulateInfo);
+
+    // Particles out and counters, uniforms
+    SDL_GPUComputePipelineCreateInfo emitInfo = {
+        .num_readwrite_storage_buffers = 2,
+        .num_uniform_buffers = 1,
+        .threadcount_x = GPU_PARTICLES_THREADS,
+        .threadcount_y = 1,
+        .threadcount_z = 1,
+    };
+    particles->EmitPipeline = RendererLoadComputePipeline(
+      context, device, "ParticleEmit.comp", &emitInfo);
+
+    // Counters and arguments, uniforms
+    SDL_GPUComputePipelineCreateInfo finalizeInfo = {
+        .num_readwrite_storage_buffers = 2,
+        .num_uniform_buffers = 1,
+        .threadcount_x = 1,
+        .threadcount_y = 1,
+        .threadcount_z = 1,
+    };
+    particles->FinalizePipeline = RendererLoadComputePipeline(
+      context, device, "ParticleFinalize.comp", &finalizeInfo);
+
+    if (particles->SimulatePipeline == NULL ||
+        particles->EmitPipeline == NULL || particles->FinalizePipeline == NULL)
+    {
+        SDL_Log("Failed to create particle compute pipelines!");
+        return -1;
+    }
+
+    SDL_GPUShader* vertexShader =
+      RendererLoadShader(context, device, "ParticleQuad.vert", 0, 2, 1, 0);
+    if (vertexShader == NULL)
+    {
+        SDL_Log("Failed to create particle vertex shader!");
+        return -1;
+    }
+
+    SDL_GPUShader* fragmentShader =
+      RendererLoadShader(context, device, "SolidColor.frag", 0, 0, 0, 0);
+    if (fragmentShader == NULL)
+    {
+        SDL_Log("Failed to create particle fragment shader!");
+        SDL_ReleaseGPUShader(device, vertexShader);
+        return -1;
+    }
+
+    SDL_GPUColorTargetDescription colorTargetDescriptions[] = {
+        {
+          .format = SDL_GetGPUSwapchainTextureFormat(device,
+                                                     context->Renderer.Window),
+          .blend_state =
+            (SDL_GPUColorTargetBlendState){
+              .src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA,
+              .dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+              .color_blend_op = SDL_GPU_BLENDOP_ADD,
+              .src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
+              .dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+              .alpha_blend_op = SDL_GPU_BLENDOP_ADD,
+              .enable_blend = true,
+            },
+        },
+    };
+
+    // No vertex buffers, the vertex shader pulls from the storage buffer
+    SDL_GPUGraphicsPipelineCreateInfo pipelineCreateInfo = {
+        .vertex_shader = vertexShader,
+        .fragment_shader = fragmentShader,
+        .primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
+        .rasterizer_state =
+          (SDL_GPURasterizerState){
+            .fill_mode = SDL_GPU_FILLMODE_FILL,
+            .cull_mode = SDL_GPU_CULLMODE_NONE,
+            .front_face = SDL_GPU_FRONTFACE_CLOCKWISE,
+          },
+        .target_info = {
+          .color_target_descriptions = colorTargetDescriptions,
+          .num_color_targets = 1,
+        },
+    };
+
+    particles->RenderPipeline =
+      SDL_CreateGPUGraphicsPipeline(device, &pipelineCreateInfo);
+
+    SDL_ReleaseGPUShader(device, vertexShader);
+    SDL_ReleaseGPUShader(device, fragmentShader);
+
+    if (particles->RenderPipeline == NULL)
+    {
+        SDL_Log("Failed to create particle render pipeline!");
+        return -1;
+    }
+
+    return 0;
+}
+
+internal int
+CreateBuffers(Context* context)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    SDL_GPUBufferCreateInfo particleBufferCreateInfo = {
+        .usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ |
+                 SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE |
+                 SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+        .size = static_cast<Uint32>(sizeof(GpuParticle) * particles->capacity),
+    };
+    for (int i = 0; i < 2; ++i)
+    {
+        particles->ParticleBuffers[i] =
+          SDL_CreateGPUBuffer(device, &particleBufferCreateInfo);
+        if (particles->ParticleBuffers[i] == NULL)
+        {
+            SDL_Log("Failed to create particle buffer: %s", SDL_GetError());
+            return -1;
+        }
+    }
+    SDL_SetGPUBufferName(
+      device, particles->ParticleBuffers[0], "GPU Particle Buffer 0");
+    SDL_SetGPUBufferName(
+      device, particles->ParticleBuffers[1], "GPU Particle Buffer 1");
+
+    SDL_GPUBufferCreateInfo counterBufferCreateInfo = {
+        .usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ |
+                 SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE,
+        .size = COUNTER_BUFFER_SIZE,
+    };
+    particles->CounterBuffer =
+      SDL_CreateGPUBuffer(device, &counterBufferCreateInfo);
+
+    SDL_GPUBufferCreateInfo argumentBufferCreateInfo = {
+        .usage = SDL_GPU_BUFFERUSAGE_INDIRECT |
+                 SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE,
+        .size = ARGUMENT_BUFFER_SIZE,
+    };
+    particles->ArgumentBuffer =
+      SDL_CreateGPUBuffer(device, &argumentBufferCreateInfo);
+
+    if (particles->CounterBuffer == NULL || particles->ArgumentBuffer == NULL)
+    {
+        SDL_Log("Failed to create particle counters: %s", SDL_GetError());
+        return -1;
+    }
+
+    return 0;
+}
+
+// Empties the system, submitted on its own ahead of the next update
+internal int
+ClearCounters(Context* context)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    SDL_GPUTransferBufferCreateInfo transferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = COUNTER_BUFFER_SIZE + ARGUMENT_BUFFER_SIZE,
+    };
+    SDL_GPUTransferBuffer* transferBuffer =
+      SDL_CreateGPUTransferBuffer(device, &transferBufferCreateInfo);
+    if (transferBuffer == NULL)
+    {
+        return -1;
+    }
+
+    void* data = SDL_MapGPUTransferBuffer(device, transferBuffer, false);
+    SDL_memset(data, 0, transferBufferCreateInfo.size);
+    SDL_UnmapGPUTransferBuffer(device, transferBuffer);
+
+    SDL_GPUCommandBuffer* cmdbuf = SDL_AcquireGPUCommandBuffer(device);
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(cmdbuf);
+
+    SDL_GPUTransferBufferLocation counterLocation = {
+        .transfer_buffer = transferBuffer,
+        .offset = 0,
+    };
+    SDL_GPUBufferRegion counterRegion = {
+        .buffer = particles->CounterBuffer,
+        .offset = 0,
+        .size = COUNTER_BUFFER_SIZE,
+    };
+    SDL_UploadToGPUBuffer(copyPass, &counterLocation, &counterRegion, false);
+
+    SDL_GPUTransferBufferLocation argumentLocation = {
+        .transfer_buffer = transferBuffer,
+        .offset = COUNTER_BUFFER_SIZE,
+    };
+    SDL_GPUBufferRegion argumentRegion = {
+        .buffer = particles->ArgumentBuffer,
+        .offset = 0,
+        .size = ARGUMENT_BUFFER_SIZE,
+    };
+    SDL_UploadToGPUBuffer(copyPass, &argumentLocation, &argumentRegion, false);
+
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_SubmitGPUCommandBuffer(cmdbuf);
+    SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+
+    particles->current = 0;
+    particles->nextId = 0;
+    particles->emitRemainder = 0.0f;
+
+    return 0;
+}
+
+internal GpuParticleUniforms
+MakeUniforms(GpuParticles* particles, float deltaTime, Uint32 emitCount)
+{
+    GpuParticleUniforms uniforms = {
+        .deltaTime = deltaTime,
+        .damping = 1.0f - GPU_PARTICLES_DRAG * deltaTime,
+        .gravity = GPU_PARTICLES_GRAVITY,
+        .restitution = GPU_PARTICLES_RESTITUTION,
+        .bounds = glm::vec2((float)GAME_WIDTH, (float)GAME_HEIGHT),
+        .capacity = particles->capacity,
+        .emitCount = SDL_min(emitCount, particles->capacity),
+        .emitter = glm::vec2(GAME_WIDTH * 0.5f, GAME_HEIGHT * 0.2f),
+        .firstId = particles->nextId,
+        .spread = GPU_PARTICLES_SPREAD,
+        .speedMin = GPU_PARTICLES_SPEED_MIN,
+        .speedMax = GPU_PARTICLES_SPEED_MAX,
+        .lifeMin = GPU_PARTICLES_LIFE_MIN,
+        .lifeMax = GPU_PARTICLES_LIFE_MAX,
+    };
+    particles->nextId += uniforms.emitCount;
+
+    return uniforms;
+}
+
+// Simulate, emit and finalize each get their own pass, writes are only
+// guaranteed to be visible to the next pass
+internal void
+RecordUpdate(Context* context,
+             SDL_GPUCommandBuffer* cmdbuf,
+             const GpuParticleUniforms* uniforms)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    SDL_GPUBuffer* source = particles->ParticleBuffers[particles->current];
+    SDL_GPUBuffer* target = particles->ParticleBuffers[particles->current ^ 1];
+
+    SDL_PushGPUComputeUniformData(
+      cmdbuf, 0, uniforms, sizeof(GpuParticleUniforms));
+
+    SDL_GPUStorageBufferReadWriteBinding targetBindings[] = {
+        { .buffer = target, .cycle = false },
+        { .buffer = particles->CounterBuffer, .cycle = false },
+    };
+
+    // Survivors, one thread per live particle of the last update
+    SDL_GPUComputePass* computePass =
+      SDL_BeginGPUComputePass(cmdbuf, NULL, 0, targetBindings, 2);
+    SDL_BindGPUComputePipeline(computePass, particles->SimulatePipeline);
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, &source, 1);
+    SDL_DispatchGPUComputeIndirect(computePass, particles->ArgumentBuffer, 0);
+    SDL_EndGPUComputePass(computePass);
+
+    if (uniforms->emitCount > 0)
+    {
+        computePass =
+          SDL_BeginGPUComputePass(cmdbuf, NULL, 0, targetBindings, 2);
+        SDL_BindGPUComputePipeline(computePass, particles->EmitPipeline);
+        SDL_DispatchGPUCompute(
+          computePass,
+          (uniforms->emitCount + GPU_PARTICLES_THREADS - 1) /
+            GPU_PARTICLES_THREADS,
+          1,
+          1);
+        SDL_EndGPUComputePass(computePass);
+    }
+
+    SDL_GPUStorageBufferReadWriteBinding counterBindings[] = {
+        { .buffer = particles->CounterBuffer, .cycle = false },
+        { .buffer = particles->ArgumentBuffer, .cycle = false },
+    };
+    computePass = SDL_BeginGPUComputePass(cmdbuf, NULL, 0, counterBindings, 2);
+    SDL_BindGPUComputePipeline(computePass, particles->FinalizePipeline);
+    SDL_DispatchGPUCompute(computePass, 1, 1, 1);
+    SDL_EndGPUComputePass(computePass);
+
+    particles->current ^= 1;
+    particles->uniforms = *uniforms;
+}
+
+internal int
+CompareParticleIds(const void* a, const void* b)
+{
+    Uint32 left = ((const GpuParticle*)a)->id;
+    Uint32 right = ((const GpuParticle*)b)->id;
+    return (left > right) - (left < right);
+}
+
+// -------------------------------------------------------------------------------
+int
+GpuParticlesInit(Context* context, Uint32 capacity, float emitRate)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    SDL_memset(particles, 0, sizeof(GpuParticles));
+
+    if (capacity == 0 || capacity > GPU_PARTICLES_MAX_CAPACITY)
+    {
+        SDL_Log("Invalid GPU particle capacity: %u", capacity);
+        return -1;
+    }
+
+    particles->capacity = capacity;
+    particles->emitRate =
+      emitRate > 0.0f
+        ? emitRate
+        : capacity / ((GPU_PARTICLES_LIFE_MIN + GPU_PARTICLES_LIFE_MAX) * 0.5f);
+
+    if (CreatePipelines(context) < 0 || CreateBuffers(context) < 0 ||
+        ClearCounters(context) < 0)
+    {
+        GpuParticlesDestroy(context);
+        return -1;
+    }
+
+    particles->isAvailable = true;
+    SDL_Log("GPU particles: %u capacity, %.0f per second",
+            particles->capacity,
+            particles->emitRate);
+
+    return 0;
+}
+
+void
+GpuParticlesDispatch(Context* context, SDL_GPUCommandBuffer* cmdbuf)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    if (!particles->isAvailable)
+    {
+        return;
+    }
+
+    PROFILE_FUNCTION();
+
+    // Render side wall time, the simulation does not know about particles
+    Uint64 counter = SDL_GetPerformanceCounter();
+    float deltaTime = 0.0f;
+    if (particles->lastCounter != 0)
+    {
+        deltaTime = (counter - particles->lastCounter) /
+                    (float)SDL_GetPerformanceFrequency();
+        deltaTime = SDL_min(deltaTime, GPU_PARTICLES_MAX_DELTA_TIME);
+    }
+    particles->lastCounter = counter;
+
+    float emit = particles->emitRate * deltaTime + particles->emitRemainder;
+    Uint32 emitCount = (Uint32)emit;
+    particles->emitRemainder = emit - emitCount;
+
+    GpuParticleUniforms uniforms =
+      MakeUniforms(particles, deltaTime, emitCount);
+    RecordUpdate(context, cmdbuf, &uniforms);
+}
+
+void
+GpuParticlesRender(Context* context,
+                   SDL_GPUCommandBuffer* cmdbuf,
+                   SDL_GPURenderPass* renderPass)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    if (!particles->isAvailable)
+    {
+        return;
+    }
+
+    SDL_BindGPUGraphicsPipeline(renderPass, particles->RenderPipeline);
+    SDL_BindGPUVertexStorageBuffers(
+      renderPass, 0, &particles->ParticleBuffers[particles->current], 1);
+    SDL_PushGPUVertexUniformData(cmdbuf,
+                                 RENDERER_CAMERA_UNIFORM_SLOT + 1,
+                                 &particles->uniforms,
+                                 sizeof(GpuParticleUniforms));
+
+    // Six vertices per live particle, written by the finalize pass
+    SDL_DrawGPUPrimitivesIndirect(
+      renderPass, particles->ArgumentBuffer, DRAW_ARGUMENTS_OFFSET, 1);
+    RendererCountDraw(&context->Renderer);
+}
+
+Uint32
+GpuParticlesReferenceStep(const GpuParticleUniforms* uniforms,
+                          const GpuParticle* in,
+                          Uint32 inCount,
+                          GpuParticle* out)
+{
+    Uint32 count = 0;
+    for (Uint32 i = 0; i < inCount; ++i)
+    {
+        GpuParticle particle = in[i];
+        if (GpuParticleSimulate(uniforms, &particle))
+        {
+            out[count++] = particle;
+        }
+    }
+
+    // Emitted past the capacity are dropped, same as the emit kernel
+    Uint32 emitCount =
+      SDL_min(uniforms->emitCount, uniforms->capacity - count);
+    for (Uint32 i = 0; i < emitCount; ++i)
+    {
+        out[count++] = GpuParticleEmit(uniforms, i);
+    }
+
+    return count;
+}
+
+int
+GpuParticlesValidate(Context* context, int frameCount)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    SDL_GPUDevice* device = context->Renderer.Device;
+    if (!particles->isAvailable || frameCount <= 0)
+    {
+        return -1;
+    }
+
+    if (ClearCounters(context) < 0)
+    {
+        return -1;
+    }
+
+    Uint32 particleDataSize = sizeof(GpuParticle) * particles->capacity;
+    SDL_GPUTransferBufferCreateInfo downloadBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD,
+        .size = COUNTER_BUFFER_SIZE + particleDataSize,
+    };
+    SDL_GPUTransferBuffer* downloadBuffer =
+      SDL_CreateGPUTransferBuffer(device, &downloadBufferCreateInfo);
+
+    GpuParticle* reference[2];
+    reference[0] = (GpuParticle*)SDL_malloc(particleDataSize);
+    reference[1] = (GpuParticle*)SDL_malloc(particleDataSize);
+    if (downloadBuffer == NULL || reference[0] == NULL || reference[1] == NULL)
+    {
+        SDL_Log("Out of memory for GPU particle validation");
+        SDL_ReleaseGPUTransferBuffer(device, downloadBuffer);
+        SDL_free(reference[0]);
+        SDL_free(reference[1]);
+        return -1;
+    }
+
+    // Fixed steps so both sides see identical uniforms
+    const float deltaTime = 1.0f / 60.0f;
+    const Uint32 emitCount = (Uint32)(particles->emitRate * deltaTime);
+
+    Uint32 referenceCount = 0;
+    int referenceIndex = 0;
+    SDL_GPUFence* fence = NULL;
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        GpuParticleUniforms uniforms =
+          MakeUniforms(particles, deltaTime, emitCount);
+
+        const GpuParticle* in = reference[referenceIndex];
+        GpuParticle* out = reference[referenceIndex ^ 1];
+        referenceCount =
+          GpuParticlesReferenceStep(&uniforms, in, referenceCount, out);
+        referenceIndex ^= 1;
+
+        SDL_GPUCommandBuffer* cmdbuf = SDL_AcquireGPUCommandBuffer(device);
+        RecordUpdate(context, cmdbuf, &uniforms);
+
+        if (frame < frameCount - 1)
+        {
+            SDL_SubmitGPUCommandBuffer(cmdbuf);
+            continue;
+        }
+
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(cmdbuf);
+        SDL_GPUBufferRegion counterRegion = {
+            .buffer = particles->CounterBuffer,
+            .offset = 0,
+            .size = COUNTER_BUFFER_SIZE,
+        };
+        SDL_GPUTransferBufferLocation counterLocation = {
+            .transfer_buffer = downloadBuffer,
+            .offset = 0,
+        };
+        SDL_DownloadFromGPUBuffer(copyPass, &counterRegion, &counterLocation);
+
+        SDL_GPUBufferRegion particleRegion = {
+            .buffer = particles->ParticleBuffers[particles->current],
+            .offset = 0,
+            .size = particleDataSize,
+        };
+        SDL_GPUTransferBufferLocation particleLocation = {
+            .transfer_buffer = downloadBuffer,
+            .offset = COUNTER_BUFFER_SIZE,
+        };
+        SDL_DownloadFromGPUBuffer(copyPass, &particleRegion, &particleLocation);
+        SDL_EndGPUCopyPass(copyPass);
+
+        fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmdbuf);
+    }
+
+    SDL_WaitForGPUFences(device, true, &fence, 1);
+    SDL_ReleaseGPUFence(device, fence);
+
+    Uint8* data =
+      (Uint8*)SDL_MapGPUTransferBuffer(device, downloadBuffer, false);
+    Uint32 gpuCount = SDL_min(((Uint32*)data)[0], particles->capacity);
+    GpuParticle* gpu = (GpuParticle*)(data + COUNTER_BUFFER_SIZE);
+    GpuParticle* cpu = reference[referenceIndex];
+
+    // The append counter hands out slots in any order
+    SDL_qsort(gpu, gpuCount, sizeof(GpuParticle), CompareParticleIds);
+    SDL_qsort(cpu, referenceCount, sizeof(GpuParticle), CompareParticleIds);
+
+    Uint32 mismatches = 0;
+    float maxPositionError = 0.0f;
+    float maxLifeError = 0.0f;
+    Uint32 count = SDL_min(gpuCount, referenceCount);
+    for (Uint32 i = 0; i < count; ++i)
+    {
+        if (gpu[i].id != cpu[i].id)
+        {
+            mismatches += 1;
+            continue;
+        }
+
+        float positionError = glm::length(gpu[i].position - cpu[i].position);
+        maxPositionError = SDL_max(maxPositionError, positionError);
+        maxLifeError =
+          SDL_max(maxLifeError, SDL_fabsf(gpu[i].life - cpu[i].life));
+    }
+
+    SDL_UnmapGPUTransferBuffer(device, downloadBuffer);
+    SDL_ReleaseGPUTransferBuffer(device, downloadBuffer);
+    SDL_free(reference[0]);
+    SDL_free(reference[1]);
+
+    bool isMatching = gpuCount == referenceCount && mismatches == 0 &&
+                      maxPositionError <= GPU_PARTICLES_VALIDATE_TOLERANCE;
+    printf("GPU particles after %d frames: %u alive (CPU %u), %u id "
+           "mismatches, max position error %.5f px, max life error %.6f s: "
+           "%s\n",
+           frameCount,
+           gpuCount,
+           referenceCount,
+           mismatches,
+           maxPositionError,
+           maxLifeError,
+           isMatching ? "OK" : "MISMATCH");
+
+    // Start over for the frames that follow
+    ClearCounters(context);
+
+    return isMatching ? 0 : -1;
+}
+
+void
+GpuParticlesDestroy(Context* context)
+{
+    GpuParticles* particles = &context->gpuParticles;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    if (particles->SimulatePipeline != nullptr)
+    {
+        SDL_ReleaseGPUComputePipeline(device, particles->SimulatePipeline);
+    }
+
+    if (particles->EmitPipeline != nullptr)
+    {
+        SDL_ReleaseGPUComputePipeline(device, particles->EmitPipeline);
+    }
+
+    if (particles->FinalizePipeline != nullptr)
+    {
+        SDL_ReleaseGPUComputePipeline(device, particles->FinalizePipeline);
+    }
+
+    if (particles->RenderPipeline != nullptr)
+    {
+        SDL_ReleaseGPUGraphicsPipeline(device, particles->RenderPipeline);
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (particles->ParticleBuffers[i] != nullptr)
+        {
+            SDL_ReleaseGPUBuffer(device, particles->ParticleBuffers[i]);
+        }
+    }
+
+    if (particles->CounterBuffer != nullptr)
+    {
+        SDL_ReleaseGPUBuffer(device, particles->CounterBuffer);
+    }
+
+    if (particles->ArgumentBuffer != nullptr)
+    {
+        SDL_ReleaseGPUBuffer(device, particles->ArgumentBuffer);
+    }
+
+    *particles = (GpuParticles){ 0 };
+}
@@ -0,0 +1,143 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Our code
+#include "includes.hpp"
+#include "input.hpp"
+#include "renderer.hpp"
+
+// -------------------------------------------------------------------------------
+bool
+InputRecordEvent(InputState* input, const SDL_Event* event)
+{
+    Uint32 code = 0;
+    switch (event->type)
+    {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+        {
+            if (event->key.repeat)
+            {
+                return false;
+            }
+            code = event->key.key;
+        }
+        break;
+
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+        {
+            code = event->button.button;
+        }
+        break;
+
+        default:
+        {
+            return false;
+        }
+    }
+
+    InputEvent* entry = &input->ring[input->eventCount % INPUT_RING_SIZE];
+    entry->timestamp = event->common.timestamp;
+    entry->type = event->type;
+    entry->code = code;
+    input->eventCount += 1;
+
+    input->pendingTimestamp =
+      SDL_max(input->pendingTimestamp, event->common.timestamp);
+
+    return true;
+}
+
+Uint64
+InputTakeTimestamp(InputState* input)
+{
+    Uint64 timestamp = input->pendingTimestamp;
+    input->pendingTimestamp = 0;
+    return timestamp;
+}
+
+void
+InputRecordLatency(InputState* input,
+                   SDL_GPUPresentMode presentMode,
+                   Uint64 inputTimestamp)
+{
+    Uint64 now = SDL_GetTicksNS();
+    if (inputTimestamp == 0 || inputTimestamp > now ||
+        (int)presentMode >= INPUT_PRESENT_MODE_COUNT)
+    {
+        return;
+    }
+
+    double latencyMs = (now - inputTimestamp) / 1e6;
+    int bucket = (int)(latencyMs / INPUT_LATENCY_BUCKET_MS);
+    bucket = SDL_min(bucket, INPUT_LATENCY_BUCKETS - 1);
+
+    InputLatencyHistogram* histogram = &input->latency[presentMode];
+    histogram->buckets[bucket] += 1;
+    histogram->count += 1;
+    histogram->sumMs += latencyMs;
+    histogram->maxMs = SDL_max(histogram->maxMs, latencyMs);
+}
+
+// Upper edge of the bucket holding the given fraction of the samples
+internal double
+HistogramPercentile(const InputLatencyHistogram* histogram, double fraction)
+{
+    Uint64 target = (Uint64)(fraction * (histogram->count - 1)) + 1;
+    Uint64 seen = 0;
+    for (int i = 0; i < INPUT_LATENCY_BUCKETS; ++i)
+    {
+        seen += histogram->buckets[i];
+        if (seen >= target)
+        {
+            return SDL_min((i + 1) * INPUT_LATENCY_BUCKET_MS, histogram->maxMs);
+        }
+    }
+
+    return histogram->maxMs;
+}
+
+void
+InputPrintLatency(const InputState* input)
+{
+    for (int mode = 0; mode < INPUT_PRESENT_MODE_COUNT; ++mode)
+    {
+        const InputLatencyHistogram* histogram = &input->latency[mode];
+        if (histogram->count == 0)
+        {
+            continue;
+        }
+
+        printf("Input to submit latency (%s): %llu samples, mean %.2f ms, "
+               "p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, max %.2f ms\n",
+               PresentModeNames[mode],
+               (unsigned long long)histogram->count,
+               histogram->sumMs / histogram->count,
+               HistogramPercentile(histogram, 0.50),
+               HistogramPercentile(histogram, 0.95),
+               HistogramPercentile(histogram, 0.99),
+               histogram->maxMs);
+
+        // One row per bucket that saw any samples
+        for (int i = 0; i < INPUT_LATENCY_BUCKETS; ++i)
+        {
+            if (histogram->buckets[i] == 0)
+            {
+                continue;
+            }
+
+            int barLength =
+              (int)(40 * histogram->buckets[i] / histogram->count);
+            printf("  %5.1f ms %6u %.*s\n",
+                   i * INPUT_LATENCY_BUCKET_MS,
+                   histogram->buckets[i],
+                   SDL_max(barLength, 1),
+                   "########################################");
+        }
+    }
+}
@@ -0,0 +1,412 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+
+// Our code
+#include "includes.hpp"
+#include "jobs.hpp"
+#include "profiler.hpp"
+
+constexpr Sint64 JOBS_QUEUE_MASK = JOBS_QUEUE_SIZE - 1;
+constexpr int JOBS_SPIN_COUNT = 256; // Failed steal attempts before sleeping
+constexpr int JOBS_CHUNKS_PER_WORKER = 4;
+
+thread_local int CurrentWorkerIndex = 0;
+
+// -------------------------------------------------------------------------------
+// Chase-Lev deque, following "Correct and Efficient Work-Stealing for Weak
+// Memory Models" (Le, Pop, Cohen, Zappa Nardelli 2013)
+internal bool
+DequePush(JobDeque* deque, Job* job)
+{
+    Sint64 bottom = deque->bottom.load(std::memory_order_relaxed);
+    Sint64 top = deque->top.load(std::memory_order_acquire);
+    if (bottom - top >= JOBS_QUEUE_SIZE)
+    {
+        return false;
+    }
+
+    deque->buffer[bottom & JOBS_QUEUE_MASK].store(job,
+                                                  std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+// Owner only
+internal Job*
+DequePop(JobDeque* deque)
+{
+    Sint64 bottom = deque->bottom.load(std::memory_order_relaxed) - 1;
+    deque->bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Sint64 top = deque->top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        // Empty
+        deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    Job* job =
+      deque->buffer[bottom & JOBS_QUEUE_MASK].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+        // Last job, race the thieves for it
+        if (!deque->top.compare_exchange_strong(top,
+                                                top + 1,
+                                                std::memory_order_seq_cst,
+                                                std::memory_order_relaxed))
+        {
+            job = NULL;
+        }
+        deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return job;
+}
+
+// Any thread. The record is copied out before the job is claimed, once
+// top moves past it the owner may reuse it for the next push. A copy taken
+// with a stale top can be torn, but then the claim fails and it is dropped.
+internal bool
+DequeSteal(JobDeque* deque, Job* result)
+{
+    Sint64 top = deque->top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Sint64 bottom = deque->bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+    {
+        return false;
+    }
+
+    Job* job =
+      deque->buffer[top & JOBS_QUEUE_MASK].load(std::memory_order_acquire);
+    *result = *job;
+    if (!deque->top.compare_exchange_strong(
+          top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+internal void
+Execute(JobWorker* worker, Job* job)
+{
+    PROFILE_ZONE("Job");
+    job->function(job->data, job->start, job->end, worker->index);
+    worker->stats.executed += 1;
+
+    if (job->counter != NULL)
+    {
+        job->counter->value.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+internal bool
+FindJob(JobWorker* worker, Job* result)
+{
+    Job* job = DequePop(&worker->deque);
+    if (job != NULL)
+    {
+        *result = *job;
+        return true;
+    }
+
+    JobSystem* jobs = worker->system;
+    if (jobs->workerCount < 2)
+    {
+        return false;
+    }
+
+    // xorshift32 for the first victim, then walk the rest in order
+    worker->randomState ^= worker->randomState << 13;
+    worker->randomState ^= worker->randomState >> 17;
+    worker->randomState ^= worker->randomState << 5;
+
+    int first = (int)(worker->randomState % (Uint32)jobs->workerCount);
+    for (int i = 0; i < jobs->workerCount; ++i)
+    {
+        int victim = (first + i) % jobs->workerCount;
+        if (victim == worker->index)
+        {
+            continue;
+        }
+
+        if (DequeSteal(&jobs->workers[victim].deque, result))
+        {
+            worker->stats.stolen += 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+internal int
+WorkerThread(void* data)
+{
+    JobWorker* worker = (JobWorker*)data;
+    JobSystem* jobs = worker->system;
+    CurrentWorkerIndex = worker->index;
+
+    char name[32];
+    SDL_snprintf(name, sizeof(name), "JobWorker%d", worker->index);
+    ProfilerSetThreadName(name);
+
+    int idleSpins = 0;
+    while (jobs->isRunning.load(std::memory_order_acquire))
+    {
+        Job job;
+        if (FindJob(worker, &job))
+        {
+            Execute(worker, &job);
+            idleSpins = 0;
+            continue;
+        }
+
+        // Spin briefly since work usually arrives in bursts, then sleep
+        if (++idleSpins < JOBS_SPIN_COUNT)
+        {
+            SDL_CPUPauseInstruction();
+        }
+        else
+        {
+            SDL_WaitSemaphoreTimeout(jobs->wakeup, 1);
+            idleSpins = 0;
+        }
+    }
+
+    return 0;
+}
+
+internal void
+WakeWorkers(JobSystem* jobs, int jobCount)
+{
+    int count = SDL_min(jobCount, jobs->workerCount - 1);
+    for (int i = 0; i < count; ++i)
+    {
+        SDL_SignalSemaphore(jobs->wakeup);
+    }
+}
+
+// Queues one job on the calling worker, or runs it right away when the
+// queue is full
+internal void
+Submit(JobSystem* jobs,
+       JobFunction* function,
+       void* data,
+       int start,
+       int end,
+       JobCounter* counter)
+{
+    JobWorker* worker = &jobs->workers[CurrentWorkerIndex];
+    JobDeque* deque = &worker->deque;
+    Job job = {
+        .function = function,
+        .data = data,
+        .start = start,
+        .end = end,
+        .counter = counter,
+    };
+
+    // The record of the slot bottom lands in is free once there is room,
+    // top only moves forward so the push below cannot fail
+    Sint64 bottom = deque->bottom.load(std::memory_order_relaxed);
+    Sint64 top = deque->top.load(std::memory_order_acquire);
+    if (bottom - top >= JOBS_QUEUE_SIZE)
+    {
+        worker->stats.inlined += 1;
+        Execute(worker, &job);
+        return;
+    }
+
+    Job* record = &worker->pool[bottom & JOBS_QUEUE_MASK];
+    *record = job;
+    DequePush(deque, record);
+}
+
+// -------------------------------------------------------------------------------
+int
+JobsInit(JobSystem* jobs, int workerCount)
+{
+    if (workerCount <= 0)
+    {
+        workerCount = SDL_GetNumLogicalCPUCores();
+    }
+    workerCount = SDL_clamp(workerCount, 1, JOBS_MAX_WORKERS);
+
+    jobs->workers = (JobWorker*)SDL_aligned_alloc(
+      alignof(JobWorker), sizeof(JobWorker) * workerCount);
+    if (jobs->workers == NULL)
+    {
+        SDL_Log("Could not allocate the job workers!");
+        return -1;
+    }
+    SDL_memset(jobs->workers, 0, sizeof(JobWorker) * workerCount);
+
+    jobs->workerCount = workerCount;
+    jobs->wakeup = SDL_CreateSemaphore(0);
+    jobs->isRunning.store(true, std::memory_order_release);
+
+    CurrentWorkerIndex = 0;
+    for (int i = 0; i < workerCount; ++i)
+    {
+        JobWorker* worker = &jobs->workers[i];
+        worker->system = jobs;
+        worker->index = i;
+        worker->randomState = 0x9E3779B9u * (Uint32)(i + 1);
+
+        // Worker 0 is the thread that called JobsInit
+        if (i == 0)
+        {
+            continue;
+        }
+
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "JobWorker%d", i);
+        worker->thread = SDL_CreateThread(WorkerThread, name, worker);
+        if (worker->thread == NULL)
+        {
+            SDL_Log("Failed to create job worker thread: %s", SDL_GetError());
+            jobs->workerCount = i;
+            break;
+        }
+    }
+
+    printf("Job system: %d workers\n", jobs->workerCount);
+
+    return 0;
+}
+
+void
+JobsShutdown(JobSystem* jobs)
+{
+    if (jobs->workers == NULL)
+    {
+        return;
+    }
+
+    jobs->isRunning.store(false, std::memory_order_release);
+    WakeWorkers(jobs, jobs->workerCount);
+
+    for (int i = 1; i < jobs->workerCount; ++i)
+    {
+        SDL_WaitThread(jobs->workers[i].thread, NULL);
+    }
+
+    SDL_DestroySemaphore(jobs->wakeup);
+    SDL_aligned_free(jobs->workers);
+    jobs->workers = NULL;
+    jobs->workerCount = 0;
+}
+
+void
+JobsRun(JobSystem* jobs,
+        JobFunction* function,
+        void* data,
+        int start,
+        int end,
+        JobCounter* counter)
+{
+    if (counter != NULL)
+    {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Submit(jobs, function, data, start, end, counter);
+    WakeWorkers(jobs, 1);
+}
+
+void
+JobsParallelFor(JobSystem* jobs,
+                JobFunction* function,
+                void* data,
+                int count,
+                int minChunk,
+                JobCounter* counter)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    // Without a counter the caller gets a blocking loop
+    JobCounter localCounter;
+    localCounter.value.store(0, std::memory_order_relaxed);
+    JobCounter* waitCounter = counter != NULL ? counter : &localCounter;
+
+    int chunk = count / (jobs->workerCount * JOBS_CHUNKS_PER_WORKER);
+    chunk = SDL_max(chunk, SDL_max(minChunk, 1));
+    int chunkCount = (count + chunk - 1) / chunk;
+
+    // Small loops are not worth the queue round trip
+    if (chunkCount == 1)
+    {
+        function(data, 0, count, CurrentWorkerIndex);
+        return;
+    }
+
+    waitCounter->value.fetch_add(chunkCount, std::memory_order_relaxed);
+    for (int start = 0; start < count; start += chunk)
+    {
+        int end = SDL_min(start + chunk, count);
+        Submit(jobs, function, data, start, end, waitCounter);
+    }
+
+    WakeWorkers(jobs, chunkCount);
+
+    if (counter == NULL)
+    {
+        JobsWait(jobs, waitCounter);
+    }
+}
+
+void
+JobsWait(JobSystem* jobs, JobCounter* counter)
+{
+    JobWorker* worker = &jobs->workers[CurrentWorkerIndex];
+
+    while (counter->value.load(std::memory_order_acquire) > 0)
+    {
+        Job job;
+        if (FindJob(worker, &job))
+        {
+            Execute(worker, &job);
+        }
+        else
+        {
+            SDL_CPUPauseInstruction();
+        }
+    }
+}
+
+int
+JobsCurrentWorker(void)
+{
+    return CurrentWorkerIndex;
+}
+
+JobStats
+JobsGetStats(JobSystem* jobs)
+{
+    JobStats result = { 0 };
+    for (int i = 0; i < jobs->workerCount; ++i)
+    {
+        result.executed += jobs->workers[i].stats.executed;
+        result.stolen += jobs->workers[i].stats.stolen;
+        result.inlined += jobs->workers[i].stats.inlined;
+    }
+
+    return result;
+}
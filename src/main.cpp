@@ -13,15 +13,20 @@
 
 #include <box2d/box2d.h>
 
+#include "memory_tracker.hpp"
+
 #define STB_IMAGE_IMPLEMENTATION
-#define STBI_MALLOC SDL_malloc
-#define STBI_REALLOC SDL_realloc
+#define STBI_MALLOC(size) MemoryTaggedMalloc(MEMORY_TAG_STB, size)
+#define STBI_REALLOC(mem, size) MemoryTaggedRealloc(MEMORY_TAG_STB, mem, size)
 #define STBI_FREE SDL_free
 #include <stb_image.h>
 
 // Our code
 #include "context.hpp"
 #include "includes.hpp"
+#include "profiler.hpp"
+
+const Uint64 GAME_RANDOM_SEED = 0x853c49e6748fea9bULL;
 
 // -------------------------------------------------------------------------------
 internal void
@@ -30,15 +35,18 @@ InitializeAssetLoader(Context* context)
     context->BasePath = SDL_GetBasePath();
 }
 
+// Switches memory tags as it goes, the caller restores its own afterwards
 internal int
 Init(Context* context)
 {
+    MemoryPushTag(MEMORY_TAG_SDL);
     int result = RendererInitSDL(context, SDL_WINDOW_RESIZABLE);
     if (result < 0)
     {
         return result;
     }
 
+    MemoryPushTag(MEMORY_TAG_ASSETS);
     InitializeAssetLoader(context);
 
     RendererInitShaders(context);
@@ -58,39 +66,144 @@ Init(Context* context)
         return -1;
     }
 
+    MemoryPushTag(MEMORY_TAG_RENDERER);
     RendererInitPipeline(context);
     RendererCreateSamplers(context);
     RendererCreateTexture(context);
     context->Renderer.isInitialized = true;
 
-    // Physics init
-    context->worldDef = b2DefaultWorldDef();
-    context->worldDef.gravity = (b2Vec2){ 0.0f, 0.0f };
-    context->worldId = b2CreateWorld(&context->worldDef);
+    if (DebugDrawInit(context) < 0)
+    {
+        SDL_Log("Physics debug drawing is not available");
+    }
+
+    if (context->scenario.tilemapChunks > 0 &&
+        TilemapInit(context,
+                    context->scenario.tilemapChunks,
+                    context->scenario.tileEditsPerFrame) < 0)
+    {
+        SDL_Log("Tilemap is not available");
+    }
+
+    // The balls fall back to sprites without it
+    int worldScreens = context->scenario.worldScreens;
+    if (ShapesInit(context,
+                   context->scenario.shapeCount,
+                   glm::vec2((float)(GAME_WIDTH * worldScreens),
+                             (float)(GAME_HEIGHT * worldScreens))) < 0)
+    {
+        SDL_Log("SDF shapes are not available");
+    }
+
+    if (FontInit(context) < 0)
+    {
+        SDL_Log("Text is not available");
+    }
 
-    // ------------------------------------------------------------
+    if (PerfHudInit(context) < 0)
+    {
+        SDL_Log("Perf HUD is not available");
+    }
 
-    // Create the surrounding walls
-    context->bodyDefTop = b2DefaultBodyDef();
-    context->bodyDefTop.position = (b2Vec2){ 0.0f, 0.0f };
-    context->bodyDefTop.type = b2_staticBody;
-    context->topBoxId = b2CreateBody(context->worldId, &context->bodyDefTop);
-    context->topBoxPolygon = b2MakeBox(GAME_WIDTH, 1.0f);
-    context->groundShapeDef = b2DefaultShapeDef();
-    b2CreatePolygonShape(
-      context->topBoxId, &context->groundShapeDef, &context->topBoxPolygon);
+    if (PostInit(context, context->scenario.postEffects) < 0)
+    {
+        SDL_Log("Post effects are not available");
+    }
+    DynamicResolutionInit(context,
+                          context->scenario.dynamicResolutionBudgetMs);
 
-    printf("Top wall created\n");
+    if (context->scenario.particleCapacity > 0 &&
+        ParticlesInit(context,
+                      context->scenario.particleCapacity,
+                      (float)context->scenario.particleRate) < 0)
+    {
+        SDL_Log("CPU particles are not available");
+    }
+
+    if (context->scenario.gpuParticleCapacity > 0 &&
+        GpuParticlesInit(context,
+                         (Uint32)context->scenario.gpuParticleCapacity,
+                         (float)context->scenario.gpuParticleRate) < 0)
+    {
+        SDL_Log("GPU particles are not available");
+    }
+
+    MemoryPushTag(MEMORY_TAG_GAME);
+    result = ArenaInit(
+      &context->frameArenas[0], "Frame0", FRAME_ARENA_CAPACITY);
+    result |= ArenaInit(
+      &context->frameArenas[1], "Frame1", FRAME_ARENA_CAPACITY);
+    result |= ArenaInit(
+      &context->scratchArena, "Scratch", SCRATCH_ARENA_CAPACITY);
+    if (result < 0)
+    {
+        return -1;
+    }
+    context->frameArena = &context->frameArenas[0];
+
+    // Before physics, Box2D runs its solver stages on the workers
+    result = JobsInit(&context->jobs, 0);
+    if (result < 0)
+    {
+        return result;
+    }
+
+    // Physics init
+    MemoryPushTag(MEMORY_TAG_PHYSICS);
+    result = PhysicsInit(context);
+    if (result < 0)
+    {
+        return result;
+    }
+
+    MemoryPushTag(MEMORY_TAG_GAME);
+    context->snapshot = SnapshotCreate();
+    if (context->snapshot == NULL)
+    {
+        return -1;
+    }
 
     return 0;
 }
 
+// Live events first, then during playback the frame's recorded input
+internal bool
+PollEvent(Context* context, SDL_Event* event)
+{
+    ReplayState* replay = &context->replay;
+    while (SDL_PollEvent(event))
+    {
+        // The log stands in for the player
+        if (replay->mode == REPLAY_MODE_PLAYBACK && ReplayIsPlayerInput(event))
+        {
+            continue;
+        }
+
+        ReplayRecordEvent(replay, event);
+        return true;
+    }
+
+    return ReplayNextEvent(replay, event);
+}
+
 internal int
 Input(Context* context)
 {
+    PROFILE_FUNCTION();
     SDL_Event event;
-    while (SDL_PollEvent(&event))
+    while (PollEvent(context, &event))
     {
+        InputRecordEvent(&context->input, &event);
+        CameraHandleEvent(&context->camera, &event);
+
+        // Anything the player does may legitimately grow Box2D, the
+        // swapchain or SDL's own tables
+        if (event.type == SDL_EVENT_KEY_DOWN ||
+            event.type == SDL_EVENT_WINDOW_RESIZED)
+        {
+            MemoryTrackerRestartWarmup();
+        }
+
         if (event.type == SDL_EVENT_QUIT)
         {
             context->isRunning = false;
@@ -110,6 +223,78 @@ Input(Context* context)
             {
                 context->isFullscreen = !context->isFullscreen;
             }
+
+            if (event.key.key == SDLK_F12 && context->perfHud.isAvailable)
+            {
+                context->perfHud.isEnabled = !context->perfHud.isEnabled;
+                SDL_Log("Perf HUD: %s",
+                        context->perfHud.isEnabled ? "on" : "off");
+            }
+
+            if (event.key.key == SDLK_F6)
+            {
+                FramePipeline* pipeline = &context->framePipeline;
+                pipeline->isEnabled =
+                  !pipeline->isEnabled && pipeline->thread != NULL;
+                pipeline->stats = (FramePipelineStats){ 0 };
+
+                // A built but never rendered snapshot may get skipped on the
+                // switch, resend every sprite
+                EntityMarkAllDirty(&context->entities);
+                SDL_Log("Frame pipeline: %s",
+                        pipeline->isEnabled ? "pipelined" : "single threaded");
+            }
+
+            if (event.key.key == SDLK_F7)
+            {
+                // Next mode the window supports, vsync always is
+                SDL_GPUPresentMode mode = context->Renderer.PresentMode;
+                for (int i = 0; i < INPUT_PRESENT_MODE_COUNT; ++i)
+                {
+                    mode = (SDL_GPUPresentMode)((mode + 1) %
+                                                INPUT_PRESENT_MODE_COUNT);
+                    if (RendererSetPresentMode(context, mode) == 0)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (event.key.key == SDLK_F8)
+            {
+                MemoryTrackerPrint();
+            }
+
+            if (event.key.key == SDLK_F10)
+            {
+                local_persist int traceIndex = 0;
+                char tracePath[64];
+                SDL_snprintf(tracePath,
+                             sizeof(tracePath),
+                             "profile_%03d.json",
+                             traceIndex++);
+                ProfilerWriteTrace(tracePath);
+            }
+
+            if (event.key.key == SDLK_F1)
+            {
+                PostToggleEffect(context, POST_EFFECT_BLOOM);
+            }
+
+            if (event.key.key == SDLK_F2)
+            {
+                PostToggleEffect(context, POST_EFFECT_GRADE);
+            }
+
+            if (event.key.key == SDLK_F4)
+            {
+                PostToggleEffect(context, POST_EFFECT_SCANLINES);
+            }
+
+            if (event.key.key == SDLK_F3)
+            {
+                DebugDrawToggle(context);
+            }
         }
 
         // User keyboard input
@@ -134,6 +319,22 @@ Input(Context* context)
                 SDL_Log("Setting sampler state to: %s",
                         SamplerNames[context->Renderer.CurrentSamplerIndex]);
             }
+            if (event.key.key == SDLK_SPACE)
+            {
+                ScenarioSpawnRandomBall(context);
+            }
+            if (event.key.key == SDLK_F5)
+            {
+                SnapshotCapture(context, context->snapshot);
+            }
+            if (event.key.key == SDLK_F9)
+            {
+                SnapshotRestore(context, context->snapshot);
+            }
+            if (event.key.key == SDLK_V)
+            {
+                DynamicResolutionToggle(context);
+            }
         }
     }
 
@@ -141,108 +342,368 @@ Input(Context* context)
 }
 
 internal void
-UpdateBall(float deltaTime, Context* context)
+UpdateBall(Ball* ball, const PhysicsEvent* event)
 {
-    // Update the ball's position
-    context->ball.position.x += context->ball.velocity.x * deltaTime;
-    context->ball.position.y += context->ball.velocity.y * deltaTime;
-
-    // Check for collisions with the left and right edges using game dimensions
-    if (context->ball.position.x - context->ball.radius <
-        0.0f) // Ball hits left edge
-    {
-        context->ball.position.x =
-          context->ball.radius; // Prevent the ball from going out of bounds
-        context->ball.velocity.x =
-          -context->ball.velocity.x; // Reverse the horizontal velocity
-    }
-    else if (context->ball.position.x + context->ball.radius >
-             GAME_WIDTH) // Ball hits right edge
+    PROFILE_FUNCTION();
+    if (event->type != PHYSICS_EVENT_CONTACT_HIT)
     {
-        context->ball.position.x =
-          GAME_WIDTH -
-          context->ball.radius; // Prevent the ball from going out of bounds
-        context->ball.velocity.x =
-          -context->ball.velocity.x; // Reverse the horizontal velocity
+        return;
     }
 
-    // Check for collisions with the top and bottom edges using game dimensions
-    if (context->ball.position.y - context->ball.radius <
-        0.0f) // Ball hits top edge
+    if (BallKeepSpeed(ball))
     {
-        context->ball.position.y =
-          context->ball.radius; // Prevent the ball from going out of bounds
-        context->ball.velocity.y =
-          -context->ball.velocity.y; // Reverse the vertical velocity
+        b2Body_SetLinearVelocity(
+          ball->bodyId,
+          (b2Vec2){ PhysicsToMeters(ball->velocity.x),
+                    PhysicsToMeters(ball->velocity.y) });
     }
-    else if (context->ball.position.y + context->ball.radius >
-             GAME_HEIGHT) // Ball hits bottom edge
+}
+
+// Gameplay reactions, driven by the events Box2D reported this frame
+internal void
+ProcessPhysicsEvents(Context* context)
+{
+    const EntityTable* entities = &context->entities;
+
+    for (int i = 0; i < context->physics.eventCount; ++i)
     {
-        context->ball.position.y =
-          GAME_HEIGHT -
-          context->ball.radius; // Prevent the ball from going out of bounds
-        context->ball.velocity.y =
-          -context->ball.velocity.y; // Reverse the vertical velocity
+        const PhysicsEvent* event = &context->physics.events[i];
+
+        if (entities->kind[event->entityA] == ENTITY_KIND_BALL)
+        {
+            UpdateBall(&context->balls[entities->index[event->entityA]],
+                       event);
+        }
+
+        if (entities->kind[event->entityB] == ENTITY_KIND_BALL)
+        {
+            UpdateBall(&context->balls[entities->index[event->entityB]],
+                       event);
+        }
     }
 }
 
 internal void
 Update(float deltaTime, Context* context)
 {
-    UpdateBall(deltaTime, context);
+    PROFILE_FUNCTION();
+    CameraUpdate(&context->camera, deltaTime);
+    PhysicsStep(context, deltaTime);
+    ProcessPhysicsEvents(context);
+    ParticlesUpdate(context, deltaTime);
+    TilemapUpdate(context);
+
+    context->simulationTime += deltaTime;
+    context->frameIndex += 1;
+}
+
+// Switches to the other frame arena. The one being left may still back
+// the snapshot that is rendered this iteration.
+internal void
+BeginFrameArena(Context* context)
+{
+    context->frameArenaIndex = (context->frameArenaIndex + 1) % 2;
+    context->frameArena = &context->frameArenas[context->frameArenaIndex];
+    ArenaReset(context->frameArena);
+}
+
+// Runs on the simulation thread when the frame pipeline is enabled
+internal void
+Simulate(Context* context, float deltaTime)
+{
+    Update(deltaTime, context);
+    context->renderSnapshot = RendererBuildSnapshot(context);
 }
 
 internal int
-Render(Context* context)
+Render(Context* context, const RenderSnapshot* snapshot)
 {
-    return RendererRenderFrame(context);
+    FramePipelineStats* stats = &context->framePipeline.stats;
+
+    MemoryTag previousTag = MemoryPushTag(MEMORY_TAG_RENDERER);
+    Uint64 start = SDL_GetPerformanceCounter();
+    int result = RendererRenderFrame(context, snapshot);
+    MemoryPopTag(previousTag);
+    stats->renderSeconds += (SDL_GetPerformanceCounter() - start) /
+                            (double)SDL_GetPerformanceFrequency();
+
+    return result;
+}
+
+// Everything that reads the newest snapshot or Box2D on the main thread
+internal void
+BuildAtRest(Context* context)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    DebugDrawBuild(context);
+    ParticlesBuild(context);
+    TilemapBuild(context);
+    ShapesBuild(context);
+    PerfHudBuild(context);
+    FontBuild(context);
+
+    context->framePipeline.stats.buildSeconds +=
+      (SDL_GetPerformanceCounter() - start) /
+      (double)SDL_GetPerformanceFrequency();
+}
+
+internal void
+RunFrame(Context* context, float deltaTime)
+{
+    FramePipeline* pipeline = &context->framePipeline;
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    if (pipeline->isEnabled)
+    {
+        // Frame N+1 simulates while frame N is recorded and submitted
+        const RenderSnapshot* snapshot = context->renderSnapshot;
+        FramePipelineKick(pipeline, deltaTime);
+        Render(context, snapshot);
+        FramePipelineWait(pipeline);
+
+        // Box2D is at rest again, the debug geometry goes out with the
+        // snapshot that was just built
+        BuildAtRest(context);
+    }
+    else
+    {
+        FramePipelineSimulate(pipeline, deltaTime);
+        BuildAtRest(context);
+        Render(context, context->renderSnapshot);
+    }
+
+    pipeline->stats.frames += 1;
+    pipeline->stats.frameSeconds += (SDL_GetPerformanceCounter() - start) /
+                                    (double)SDL_GetPerformanceFrequency();
 }
 
 int
 main(int argc, char** argv)
 {
-    (void)argc;
-    (void)argv;
+    bool isPipelined = true;
+    bool isStrictMemory = false;
+    bool isProfileDumped = false;
+    bool isValidatingGpuParticles = false;
+    const char* recordPath = NULL;
+    const char* replayPath = NULL;
+
+    // Before SDL allocates anything, the scenario loading and logging below
+    // may already allocate
+    for (int i = 1; i < argc; ++i)
+    {
+        if (SDL_strcmp(argv[i], "--strict-memory") == 0)
+        {
+            isStrictMemory = true;
+        }
+    }
+    if (!MemoryTrackerInstall(isStrictMemory))
+    {
+        SDL_Log("Could not install the memory tracker");
+    }
 
-    Context* context = (Context*)calloc(1, sizeof(Context));
+    Scenario scenario;
+    ScenarioInit(&scenario);
+    float targetFps = -1.0f; // Follow the display unless given
+    for (int i = 1; i < argc; ++i)
+    {
+        if (SDL_strcmp(argv[i], "--single-threaded") == 0)
+        {
+            isPipelined = false;
+        }
+        else if (SDL_strcmp(argv[i], "--strict-memory") == 0)
+        {
+            continue; // Already installed
+        }
+        else if (SDL_strcmp(argv[i], "--profile") == 0)
+        {
+            isProfileDumped = true;
+        }
+        else if (SDL_strcmp(argv[i], "--validate-gpu-particles") == 0)
+        {
+            isValidatingGpuParticles = true;
+        }
+        else if (SDL_strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+        {
+            recordPath = argv[++i];
+        }
+        else if (SDL_strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+        {
+            replayPath = argv[++i];
+        }
+        else if (SDL_strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+        {
+            targetFps = (float)SDL_strtod(argv[++i], NULL);
+        }
+        else if (SDL_strcmp(argv[i], "--scenario") == 0 && i + 1 < argc)
+        {
+            if (ScenarioLoad(&scenario, argv[++i]) < 0)
+            {
+                return -1;
+            }
+        }
+        else if (SDL_strncmp(argv[i], "--", 2) == 0 && i + 1 < argc &&
+                 ScenarioSet(&scenario, argv[i] + 2, argv[i + 1]) == 0)
+        {
+            i += 1;
+        }
+    }
+
+    MemoryTag previousTag = MemoryPushTag(MEMORY_TAG_GAME);
+    if (ProfilerInit() < 0)
+    {
+        SDL_Log("Profiler is not available");
+    }
+
+    Context* context = (Context*)SDL_calloc(1, sizeof(Context));
     context->GameName = "SDL2 Playground";
     context->BasePath = SDL_GetBasePath();
     context->DeltaTime = 0.0f;
-    context->ball.position = glm::vec2(320.0f, 180.0f);
-    context->ball.velocity = glm::vec2(100.0f, 150.0f);
-    context->ball.radius = 64.0f;
     context->windowWidth = GAME_WIDTH;
     context->windowHeight = GAME_HEIGHT;
     context->Renderer.isInitialized = false;
     context->Renderer = { 0 };
+    context->Renderer.spriteTextureCount = scenario.textureCount;
+    context->Renderer.particleSlotCount =
+      ParticlesRoundCapacity(scenario.particleCapacity);
+    context->scenario = scenario;
+
+    // A replay brings its own seed
+    Uint64 seed = GAME_RANDOM_SEED;
+    int replayResult = 0;
+    if (replayPath != NULL)
+    {
+        replayResult = ReplayStartPlayback(&context->replay, replayPath, &seed);
+    }
+    else if (recordPath != NULL)
+    {
+        replayResult =
+          ReplayStartRecording(&context->replay, recordPath, seed);
+    }
+    if (replayResult < 0)
+    {
+        return -1;
+    }
+    RandomSeed(&context->random, seed);
+    CameraInit(&context->camera);
+
+    SpatialGridInit(&context->spatialGrid,
+                    glm::vec2((float)(GAME_WIDTH * scenario.worldScreens),
+                              (float)(GAME_HEIGHT * scenario.worldScreens)));
 
     int initSuccess = Init(context);
+    MemoryPopTag(previousTag);
     if (initSuccess > 0)
     {
         return initSuccess;
     }
 
+    if (ScenarioSpawn(context) < 0)
+    {
+        return -1;
+    }
+
+    if (FramePipelineInit(context, Simulate, isPipelined) < 0)
+    {
+        return -1;
+    }
+    context->renderSnapshot = RendererBuildSnapshot(context);
+
+    if (targetFps < 0.0f)
+    {
+        const SDL_DisplayMode* displayMode = SDL_GetCurrentDisplayMode(
+          SDL_GetDisplayForWindow(context->Renderer.Window));
+        targetFps = displayMode != NULL && displayMode->refresh_rate > 0.0f
+                      ? displayMode->refresh_rate
+                      : FRAME_PACER_DEFAULT_FPS;
+    }
+    FramePacerInit(&context->framePacer, targetFps);
+
     Uint64 lastTime = SDL_GetPerformanceCounter();
     context->isRunning = true;
 
+    // Checks the compute shaders against the CPU reference, then quits
+    int exitCode = 0;
+    if (isValidatingGpuParticles)
+    {
+        if (!context->gpuParticles.isAvailable)
+        {
+            GpuParticlesInit(context, GPU_PARTICLES_VALIDATE_CAPACITY, 0.0f);
+        }
+        if (GpuParticlesValidate(context, GPU_PARTICLES_VALIDATE_FRAMES) < 0)
+        {
+            exitCode = 1;
+        }
+        context->isRunning = false;
+    }
+
     // Game loop
     while (context->isRunning)
     {
         Uint64 currentTime = SDL_GetPerformanceCounter();
-        const float deltaTime =
-          (currentTime - lastTime) /
-          static_cast<float>(SDL_GetPerformanceFrequency());
+        float deltaTime = (currentTime - lastTime) /
+                          static_cast<float>(SDL_GetPerformanceFrequency());
         lastTime = currentTime;
 
+        // Wall time of the previous frame, whatever a replay says
+        ScenarioEndFrame(context, deltaTime);
+        PerfHudRecordFrame(context, deltaTime);
+        DynamicResolutionUpdate(context, deltaTime);
+
+        if (!ReplayBeginFrame(&context->replay, &deltaTime))
+        {
+            break;
+        }
+
+        BeginFrameArena(context);
+        Uint64 inputStart = SDL_GetPerformanceCounter();
         Input(context);
-        Update(deltaTime, context);
-        Render(context);
-    }
+        context->framePipeline.stats.inputSeconds +=
+          (SDL_GetPerformanceCounter() - inputStart) /
+          (double)SDL_GetPerformanceFrequency();
+        ReplayEndFrame(&context->replay, deltaTime);
 
-    RendererDestroy(context);
+        MemoryTrackerBeginFrame();
+        RunFrame(context, deltaTime);
+        MemoryTrackerEndFrame();
+
+        FramePacerWait(&context->framePacer);
+    }
 
     // Clean up
-    b2DestroyWorld(context->worldId);
+    ReplayStop(context);
+    if (isProfileDumped)
+    {
+        ProfilerWriteTrace("profile_exit.json");
+    }
+    FramePacerPrintStats(&context->framePacer);
+    InputPrintLatency(&context->input);
+    MemoryTrackerPrint();
+    FramePipelineDestroy(context);
+    SnapshotDestroy(context->snapshot);
+    PhysicsDestroy(context);
+    JobsShutdown(&context->jobs);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        ArenaPrintStats(&context->frameArenas[i]);
+        ArenaDestroy(&context->frameArenas[i]);
+    }
+    ArenaPrintStats(&context->scratchArena);
+    RenderTargetPoolPrintStats(&context->Renderer.targetPool);
+    DynamicResolutionPrintStats(&context->dynamicResolution);
+    ArenaDestroy(&context->scratchArena);
+
+    DebugDrawDestroy(context);
+    ParticlesDestroy(context);
+    TilemapDestroy(context);
+    ShapesDestroy(context);
+    FontDestroy(context);
+    PerfHudDestroy(context);
+    PostDestroy(context);
+    GpuParticlesDestroy(context);
+    RendererDestroy(context);
+    ProfilerShutdown();
 
-    return 0;
+    return exitCode;
 }
@@ -0,0 +1,292 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+
+// Our code
+#include "includes.hpp"
+#include "memory_tracker.hpp"
+
+const char* MemoryTagNames[] = {
+    "SDL", "Game", "Renderer", "Assets", "Physics", "stb",
+};
+
+// Sits in front of every block, 16 bytes keeps SDL's alignment guarantee
+typedef struct MemoryHeader
+{
+    Uint64 size;
+    Uint32 tag;
+    Uint32 magic;
+} MemoryHeader;
+
+const Uint32 MEMORY_HEADER_MAGIC = 0x4D454D54; // "MEMT"
+
+global_variable MemoryTracker Tracker;
+global_variable SDL_malloc_func OriginalMalloc;
+global_variable SDL_calloc_func OriginalCalloc;
+global_variable SDL_realloc_func OriginalRealloc;
+global_variable SDL_free_func OriginalFree;
+
+thread_local MemoryTag CurrentTag = MEMORY_TAG_SDL;
+
+// -------------------------------------------------------------------------------
+internal void
+CheckSteadyState(MemoryTag tag, size_t size)
+{
+    if (!Tracker.isStrict || Tracker.warmupFrames > 0 ||
+        !Tracker.isInFrame.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // SDL_Log could allocate and land back here
+    fprintf(stderr,
+            "Strict memory: %zu byte %s allocation in the frame loop\n",
+            size,
+            MemoryTagNames[tag]);
+    Assert(false);
+}
+
+internal void
+AddLiveBytes(std::atomic<Sint64>* liveBytes,
+             std::atomic<Sint64>* peakBytes,
+             Sint64 size)
+{
+    Sint64 live = liveBytes->fetch_add(size, std::memory_order_relaxed) + size;
+
+    Sint64 peak = peakBytes->load(std::memory_order_relaxed);
+    while (live > peak &&
+           !peakBytes->compare_exchange_weak(
+             peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+internal void
+TrackAllocation(MemoryTag tag, Sint64 size)
+{
+    MemoryTagStats* stats = &Tracker.tags[tag];
+    AddLiveBytes(&stats->liveBytes, &stats->peakBytes, size);
+    AddLiveBytes(&Tracker.liveBytes, &Tracker.peakBytes, size);
+
+    stats->allocations.fetch_add(1, std::memory_order_relaxed);
+    stats->allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+internal void*
+FinishBlock(MemoryHeader* header, MemoryTag tag, size_t size)
+{
+    if (header == NULL)
+    {
+        return NULL;
+    }
+
+    header->size = size;
+    header->tag = tag;
+    header->magic = MEMORY_HEADER_MAGIC;
+    TrackAllocation(tag, (Sint64)size);
+
+    return header + 1;
+}
+
+internal MemoryHeader*
+HeaderOf(void* mem)
+{
+    MemoryHeader* header = (MemoryHeader*)mem - 1;
+    Assert(header->magic == MEMORY_HEADER_MAGIC);
+    return header;
+}
+
+internal void*
+TrackedMalloc(size_t size)
+{
+    MemoryTag tag = CurrentTag;
+    CheckSteadyState(tag, size);
+
+    MemoryHeader* header =
+      (MemoryHeader*)OriginalMalloc(sizeof(MemoryHeader) + size);
+    return FinishBlock(header, tag, size);
+}
+
+internal void*
+TrackedCalloc(size_t count, size_t size)
+{
+    if (size != 0 && count > (SIZE_MAX - sizeof(MemoryHeader)) / size)
+    {
+        return NULL;
+    }
+
+    MemoryTag tag = CurrentTag;
+    CheckSteadyState(tag, count * size);
+
+    MemoryHeader* header =
+      (MemoryHeader*)OriginalCalloc(1, sizeof(MemoryHeader) + count * size);
+    return FinishBlock(header, tag, count * size);
+}
+
+internal void*
+TrackedRealloc(void* mem, size_t size)
+{
+    if (mem == NULL)
+    {
+        return TrackedMalloc(size);
+    }
+
+    MemoryHeader* header = HeaderOf(mem);
+    MemoryTag tag = (MemoryTag)header->tag;
+    Sint64 oldSize = (Sint64)header->size;
+    CheckSteadyState(tag, size);
+
+    header =
+      (MemoryHeader*)OriginalRealloc(header, sizeof(MemoryHeader) + size);
+    if (header == NULL)
+    {
+        return NULL;
+    }
+
+    // Charged to the tag that made the original block
+    Tracker.tags[tag].liveBytes.fetch_sub(oldSize, std::memory_order_relaxed);
+    Tracker.liveBytes.fetch_sub(oldSize, std::memory_order_relaxed);
+    return FinishBlock(header, tag, size);
+}
+
+internal void
+TrackedFree(void* mem)
+{
+    if (mem == NULL)
+    {
+        return;
+    }
+
+    MemoryHeader* header = HeaderOf(mem);
+    Tracker.tags[header->tag].liveBytes.fetch_sub((Sint64)header->size,
+                                                 std::memory_order_relaxed);
+    Tracker.liveBytes.fetch_sub((Sint64)header->size,
+                                std::memory_order_relaxed);
+    header->magic = 0;
+    OriginalFree(header);
+}
+
+// -------------------------------------------------------------------------------
+bool
+MemoryTrackerInstall(bool isStrict)
+{
+    SDL_GetOriginalMemoryFunctions(
+      &OriginalMalloc, &OriginalCalloc, &OriginalRealloc, &OriginalFree);
+
+    if (!SDL_SetMemoryFunctions(
+          TrackedMalloc, TrackedCalloc, TrackedRealloc, TrackedFree))
+    {
+        return false;
+    }
+
+    Tracker.isInstalled = true;
+    Tracker.isStrict = isStrict;
+    Tracker.warmupFrames = MEMORY_WARMUP_FRAMES;
+
+    return true;
+}
+
+MemoryTag
+MemoryPushTag(MemoryTag tag)
+{
+    MemoryTag previous = CurrentTag;
+    CurrentTag = tag;
+    return previous;
+}
+
+void
+MemoryPopTag(MemoryTag previous)
+{
+    CurrentTag = previous;
+}
+
+void*
+MemoryTaggedMalloc(MemoryTag tag, size_t size)
+{
+    MemoryTag previous = MemoryPushTag(tag);
+    void* result = SDL_malloc(size);
+    MemoryPopTag(previous);
+    return result;
+}
+
+void*
+MemoryTaggedRealloc(MemoryTag tag, void* mem, size_t size)
+{
+    MemoryTag previous = MemoryPushTag(tag);
+    void* result = SDL_realloc(mem, size);
+    MemoryPopTag(previous);
+    return result;
+}
+
+void
+MemoryTrackerBeginFrame(void)
+{
+    Tracker.isInFrame.store(true, std::memory_order_relaxed);
+}
+
+void
+MemoryTrackerEndFrame(void)
+{
+    Tracker.isInFrame.store(false, std::memory_order_relaxed);
+
+    for (int i = 0; i < MEMORY_TAG_COUNT; ++i)
+    {
+        MemoryTagStats* stats = &Tracker.tags[i];
+        Uint64 allocations = stats->allocations.load(std::memory_order_relaxed);
+        stats->lastFrameAllocations =
+          allocations - stats->frameStartAllocations;
+        stats->frameStartAllocations = allocations;
+    }
+
+    Tracker.frames += 1;
+    if (Tracker.warmupFrames > 0)
+    {
+        Tracker.warmupFrames -= 1;
+    }
+}
+
+void
+MemoryTrackerRestartWarmup(void)
+{
+    Tracker.warmupFrames = MEMORY_WARMUP_FRAMES;
+}
+
+const MemoryTracker*
+MemoryTrackerGet(void)
+{
+    return &Tracker;
+}
+
+void
+MemoryTrackerPrint(void)
+{
+    if (!Tracker.isInstalled)
+    {
+        return;
+    }
+
+    printf("Memory after %llu frames%s:\n",
+           (unsigned long long)Tracker.frames,
+           Tracker.isStrict ? " (strict)" : "");
+    for (int i = 0; i < MEMORY_TAG_COUNT; ++i)
+    {
+        const MemoryTagStats* stats = &Tracker.tags[i];
+        Uint64 allocations = stats->allocations.load();
+        printf("  %-9s live %9.1f KB  peak %9.1f KB  %8llu allocs  "
+               "%.2f allocs/frame  %llu last frame\n",
+               MemoryTagNames[i],
+               stats->liveBytes.load() / 1024.0,
+               stats->peakBytes.load() / 1024.0,
+               (unsigned long long)allocations,
+               Tracker.frames > 0 ? allocations / (double)Tracker.frames : 0.0,
+               (unsigned long long)stats->lastFrameAllocations);
+    }
+    printf("  %-9s live %9.1f KB  peak %9.1f KB\n",
+           "total",
+           Tracker.liveBytes.load() / 1024.0,
+           Tracker.peakBytes.load() / 1024.0);
+}
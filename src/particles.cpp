@@ -0,0 +1,479 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <glm/glm.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PARTICLES_AVX2 1
+#else
+#define PARTICLES_AVX2 0
+#endif
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "particles.hpp"
+#include "profiler.hpp"
+
+typedef struct ParticleStep
+{
+    float deltaTime;
+    float gravity; // Velocity change this step
+    float damping;
+    float restitution;
+} ParticleStep;
+
+typedef struct UpdateChunksJob
+{
+    ParticleSystem* system;
+    ParticleStep step;
+} UpdateChunksJob;
+
+// -------------------------------------------------------------------------------
+internal void
+UpdateScalar(ParticleSystem* system,
+             const ParticleStep* step,
+             int first,
+             int count)
+{
+    const float bounds[2] = { (float)GAME_WIDTH, (float)GAME_HEIGHT };
+    for (int i = first; i < first + count; ++i)
+    {
+        system->life[i] -= step->deltaTime;
+
+        float velocity[2] = { system->velocityX[i] * step->damping,
+                              (system->velocityY[i] + step->gravity) *
+                                step->damping };
+        float position[2] = {
+            system->positionX[i] + velocity[0] * step->deltaTime,
+            system->positionY[i] + velocity[1] * step->deltaTime,
+        };
+
+        // Reflect off the edges of the game area
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if (position[axis] < 0.0f)
+            {
+                position[axis] = -position[axis];
+                velocity[axis] *= -step->restitution;
+            }
+            else if (position[axis] > bounds[axis])
+            {
+                position[axis] = 2.0f * bounds[axis] - position[axis];
+                velocity[axis] *= -step->restitution;
+            }
+        }
+
+        system->positionX[i] = position[0];
+        system->positionY[i] = position[1];
+        system->velocityX[i] = velocity[0];
+        system->velocityY[i] = velocity[1];
+    }
+}
+
+#if PARTICLES_AVX2
+// position and velocity of one axis, eight lanes
+__attribute__((target("avx2"))) internal inline void
+BounceAvx2(__m256* position,
+           __m256* velocity,
+           __m256 bound,
+           __m256 restitution)
+{
+    __m256 zero = _mm256_setzero_ps();
+    __m256 below = _mm256_cmp_ps(*position, zero, _CMP_LT_OQ);
+    __m256 above = _mm256_cmp_ps(*position, bound, _CMP_GT_OQ);
+
+    __m256 reflectedBelow = _mm256_sub_ps(zero, *position);
+    __m256 reflectedAbove =
+      _mm256_sub_ps(_mm256_add_ps(bound, bound), *position);
+    *position = _mm256_blendv_ps(*position, reflectedBelow, below);
+    *position = _mm256_blendv_ps(*position, reflectedAbove, above);
+
+    __m256 bounced = _mm256_mul_ps(*velocity, restitution);
+    __m256 isBounced = _mm256_or_ps(below, above);
+    *velocity = _mm256_blendv_ps(*velocity, bounced, isBounced);
+}
+
+// Same math as UpdateScalar. count is rounded up to whole lanes, the arrays
+// are padded for it.
+__attribute__((target("avx2"))) internal void
+UpdateAvx2(ParticleSystem* system,
+           const ParticleStep* step,
+           int first,
+           int count)
+{
+    const __m256 deltaTime = _mm256_set1_ps(step->deltaTime);
+    const __m256 gravity = _mm256_set1_ps(step->gravity);
+    const __m256 damping = _mm256_set1_ps(step->damping);
+    const __m256 restitution = _mm256_set1_ps(-step->restitution);
+    const __m256 width = _mm256_set1_ps((float)GAME_WIDTH);
+    const __m256 height = _mm256_set1_ps((float)GAME_HEIGHT);
+
+    for (int i = first; i < first + count; i += 8)
+    {
+        __m256 life = _mm256_load_ps(&system->life[i]);
+        _mm256_store_ps(&system->life[i], _mm256_sub_ps(life, deltaTime));
+
+        __m256 velocityX =
+          _mm256_mul_ps(_mm256_load_ps(&system->velocityX[i]), damping);
+        __m256 velocityY = _mm256_mul_ps(
+          _mm256_add_ps(_mm256_load_ps(&system->velocityY[i]), gravity),
+          damping);
+        __m256 positionX =
+          _mm256_add_ps(_mm256_load_ps(&system->positionX[i]),
+                        _mm256_mul_ps(velocityX, deltaTime));
+        __m256 positionY =
+          _mm256_add_ps(_mm256_load_ps(&system->positionY[i]),
+                        _mm256_mul_ps(velocityY, deltaTime));
+
+        BounceAvx2(&positionX, &velocityX, width, restitution);
+        BounceAvx2(&positionY, &velocityY, height, restitution);
+
+        _mm256_store_ps(&system->positionX[i], positionX);
+        _mm256_store_ps(&system->positionY[i], positionY);
+        _mm256_store_ps(&system->velocityX[i], velocityX);
+        _mm256_store_ps(&system->velocityY[i], velocityY);
+    }
+}
+#endif
+
+internal void
+MoveParticle(ParticleSystem* system, int from, int to)
+{
+    system->positionX[to] = system->positionX[from];
+    system->positionY[to] = system->positionY[from];
+    system->velocityX[to] = system->velocityX[from];
+    system->velocityY[to] = system->velocityY[from];
+    system->life[to] = system->life[from];
+}
+
+// Swap-removes the dead particles of one chunk, returns the survivors
+internal int
+CompactChunk(ParticleSystem* system, int first, int count)
+{
+    int alive = count;
+    int i = first;
+    while (i < first + alive)
+    {
+        if (system->life[i] <= 0.0f)
+        {
+            alive -= 1;
+            MoveParticle(system, first + alive, i);
+        }
+        else
+        {
+            i += 1;
+        }
+    }
+
+    return alive;
+}
+
+internal void
+UpdateChunks(void* data, int start, int end, int workerIndex)
+{
+    (void)workerIndex;
+    UpdateChunksJob* job = (UpdateChunksJob*)data;
+    ParticleSystem* system = job->system;
+
+    for (int chunk = start; chunk < end; ++chunk)
+    {
+        int first = chunk * PARTICLES_CHUNK_SIZE;
+        int count = SDL_min(PARTICLES_CHUNK_SIZE, system->count - first);
+
+#if PARTICLES_AVX2
+        if (system->hasAvx2)
+        {
+            UpdateAvx2(system, &job->step, first, (count + 7) & ~7);
+        }
+        else
+#endif
+        {
+            UpdateScalar(system, &job->step, first, count);
+        }
+
+        system->chunkAlive[chunk] = CompactChunk(system, first, count);
+    }
+}
+
+// Fills the holes the chunks left below the new count with the last live
+// particles above it
+internal void
+CompactChunks(ParticleSystem* system, int chunkCount)
+{
+    int alive = 0;
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        alive += system->chunkAlive[chunk];
+    }
+
+    int source = chunkCount - 1;
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        int first = chunk * PARTICLES_CHUNK_SIZE;
+        int end = SDL_min(first + PARTICLES_CHUNK_SIZE, alive);
+        for (int hole = first + system->chunkAlive[chunk]; hole < end; ++hole)
+        {
+            int last = source * PARTICLES_CHUNK_SIZE +
+                       system->chunkAlive[source] - 1;
+            while (system->chunkAlive[source] == 0 || last < alive)
+            {
+                source -= 1;
+                last = source * PARTICLES_CHUNK_SIZE +
+                       system->chunkAlive[source] - 1;
+            }
+
+            MoveParticle(system, last, hole);
+            system->chunkAlive[source] -= 1;
+            system->stats.moved += 1;
+        }
+    }
+
+    system->stats.died = system->count - alive;
+    system->count = alive;
+}
+
+internal void
+Emit(Context* context, int emitCount)
+{
+    ParticleSystem* system = &context->particles;
+    RandomState* random = &context->random;
+
+    emitCount = SDL_min(emitCount, system->capacity - system->count);
+    for (int i = system->count; i < system->count + emitCount; ++i)
+    {
+        float angle = RandomRange(random, 0.0f, 2.0f * (float)PI);
+        float speed =
+          RandomRange(random, PARTICLES_SPEED_MIN, PARTICLES_SPEED_MAX);
+        system->positionX[i] = system->emitter.x;
+        system->positionY[i] = system->emitter.y;
+        system->velocityX[i] = SDL_cosf(angle) * speed;
+        system->velocityY[i] = SDL_sinf(angle) * speed;
+        system->life[i] =
+          RandomRange(random, PARTICLES_LIFE_MIN, PARTICLES_LIFE_MAX);
+    }
+
+    system->count += emitCount;
+    system->stats.emitted = emitCount;
+}
+
+typedef struct WriteQuadsJob
+{
+    const ParticleSystem* system;
+    PositionTextureVertex* vertices;
+} WriteQuadsJob;
+
+// The texture coordinate picks a single texel, so the color follows the
+// age of the particle across the sprite texture
+internal void
+WriteQuads(void* data, int start, int end, int workerIndex)
+{
+    (void)workerIndex;
+    WriteQuadsJob* job = (WriteQuadsJob*)data;
+    const ParticleSystem* system = job->system;
+
+    const glm::vec2 halfExtents = glm::vec2(PARTICLES_HALF_SIZE);
+    for (int i = start; i < end; ++i)
+    {
+        glm::vec2 center =
+          glm::vec2(system->positionX[i], system->positionY[i]);
+        float age = SDL_min(system->life[i] / PARTICLES_LIFE_MAX, 1.0f);
+
+        // World pixels like the sprites, the camera is applied in the
+        // vertex shader
+        PositionTextureVertex* quad = &job->vertices[i * 4];
+        RendererWriteSpriteQuad(quad, center, halfExtents);
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            quad[corner].u = age;
+            quad[corner].v = age;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+int
+ParticlesInit(Context* context, int capacity, float emitRate)
+{
+    ParticleSystem* system = &context->particles;
+    SDL_memset(system, 0, sizeof(ParticleSystem));
+
+    // Emit fills the rounded capacity, every quad needs a slot of its own
+    if (capacity <= 0 || capacity > PARTICLES_MAX_CAPACITY ||
+        ParticlesRoundCapacity(capacity) >
+          context->Renderer.particleSlotCount)
+    {
+        SDL_Log("Invalid particle capacity: %d", capacity);
+        return -1;
+    }
+
+    system->capacity = ParticlesRoundCapacity(capacity);
+    int chunkCount =
+      (system->capacity + PARTICLES_CHUNK_SIZE - 1) / PARTICLES_CHUNK_SIZE;
+
+    // Five float arrays and the chunk counts, 32 byte aligned for AVX2
+    size_t arraySize = sizeof(float) * system->capacity;
+    size_t size = arraySize * 5 + sizeof(int) * chunkCount;
+    Uint8* block = (Uint8*)SDL_aligned_alloc(64, size);
+    if (block == NULL)
+    {
+        SDL_Log("Could not allocate %d particles!", capacity);
+        return -1;
+    }
+    SDL_memset(block, 0, size);
+    system->positionX = (float*)(block + arraySize * 0);
+    system->positionY = (float*)(block + arraySize * 1);
+    system->velocityX = (float*)(block + arraySize * 2);
+    system->velocityY = (float*)(block + arraySize * 3);
+    system->life = (float*)(block + arraySize * 4);
+    system->chunkAlive = (int*)(block + arraySize * 5);
+
+    SDL_GPUTransferBufferCreateInfo transferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = static_cast<Uint32>(sizeof(PositionTextureVertex) * 4 *
+                                    system->capacity),
+    };
+    system->TransferBuffer = SDL_CreateGPUTransferBuffer(
+      context->Renderer.Device, &transferBufferCreateInfo);
+    if (system->TransferBuffer == NULL)
+    {
+        SDL_Log("Could not create the particle transfer buffer: %s",
+                SDL_GetError());
+        ParticlesDestroy(context);
+        return -1;
+    }
+
+    system->hasAvx2 = PARTICLES_AVX2 && SDL_HasAVX2();
+    system->emitter = glm::vec2(GAME_WIDTH * 0.5f, GAME_HEIGHT * 0.5f);
+    system->emitRate =
+      emitRate > 0.0f
+        ? emitRate
+        : capacity / ((PARTICLES_LIFE_MIN + PARTICLES_LIFE_MAX) * 0.5f);
+    system->isEnabled = true;
+
+    SDL_Log("CPU particles: %d capacity, %.0f per second, %s update",
+            system->capacity,
+            system->emitRate,
+            system->hasAvx2 ? "AVX2" : "scalar");
+
+    return 0;
+}
+
+void
+ParticlesUpdate(Context* context, float deltaTime)
+{
+    ParticleSystem* system = &context->particles;
+    if (!system->isEnabled)
+    {
+        return;
+    }
+
+    PROFILE_FUNCTION();
+    Uint64 start = SDL_GetPerformanceCounter();
+    system->stats.moved = 0;
+    system->stats.died = 0;
+
+    int chunkCount =
+      (system->count + PARTICLES_CHUNK_SIZE - 1) / PARTICLES_CHUNK_SIZE;
+    if (chunkCount > 0)
+    {
+        UpdateChunksJob job = {
+            .system = system,
+            .step = {
+              .deltaTime = deltaTime,
+              .gravity = PARTICLES_GRAVITY * deltaTime,
+              .damping = 1.0f - PARTICLES_DRAG * deltaTime,
+              .restitution = PARTICLES_RESTITUTION,
+            },
+        };
+        JobsParallelFor(
+          &context->jobs, UpdateChunks, &job, chunkCount, 1, NULL);
+
+        CompactChunks(system, chunkCount);
+    }
+
+    float emit = system->emitRate * deltaTime + system->emitRemainder;
+    int emitCount = (int)emit;
+    system->emitRemainder = emit - emitCount;
+    Emit(context, emitCount);
+
+    system->stats.alive = system->count;
+    system->stats.updateSeconds = (SDL_GetPerformanceCounter() - start) /
+                                  (double)SDL_GetPerformanceFrequency();
+}
+
+void
+ParticlesBuild(Context* context)
+{
+    ParticleSystem* system = &context->particles;
+    system->drawCount = 0;
+    if (!system->isEnabled || system->count == 0)
+    {
+        return;
+    }
+
+    PROFILE_FUNCTION();
+
+    // Straight into the mapped transfer buffer, cycled because the last
+    // frame may still be uploading from it
+    void* vertices = SDL_MapGPUTransferBuffer(
+      context->Renderer.Device, system->TransferBuffer, true);
+    WriteQuadsJob job = {
+        .system = system,
+        .vertices = static_cast<PositionTextureVertex*>(vertices),
+    };
+    JobsParallelFor(&context->jobs,
+                    WriteQuads,
+                    &job,
+                    system->count,
+                    PARTICLES_QUAD_MIN_CHUNK,
+                    NULL);
+    SDL_UnmapGPUTransferBuffer(context->Renderer.Device,
+                               system->TransferBuffer);
+
+    system->drawCount = system->count;
+}
+
+void
+ParticlesUpload(Context* context, SDL_GPUCopyPass* copyPass)
+{
+    ParticleSystem* system = &context->particles;
+    if (system->drawCount == 0)
+    {
+        return;
+    }
+
+    SDL_GPUTransferBufferLocation transferLocation = {
+        .transfer_buffer = system->TransferBuffer,
+        .offset = 0,
+    };
+    SDL_GPUBufferRegion vertexBufferRegion = {
+        .buffer = context->Renderer.VertexBuffer,
+        .offset = static_cast<Uint32>(sizeof(PositionTextureVertex) *
+                                      MAX_SPRITES * 4),
+        .size = static_cast<Uint32>(sizeof(PositionTextureVertex) * 4 *
+                                    system->drawCount),
+    };
+    SDL_UploadToGPUBuffer(
+      copyPass, &transferLocation, &vertexBufferRegion, false);
+}
+
+void
+ParticlesDestroy(Context* context)
+{
+    ParticleSystem* system = &context->particles;
+
+    if (system->TransferBuffer != nullptr)
+    {
+        SDL_ReleaseGPUTransferBuffer(context->Renderer.Device,
+                                     system->TransferBuffer);
+    }
+
+    SDL_aligned_free(system->positionX);
+
+    *system = (ParticleSystem){ 0 };
+}
@@ -0,0 +1,452 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "memory_tracker.hpp"
+#include "perf_hud.hpp"
+#include "profiler.hpp"
+
+// Screen pixels
+constexpr int PERF_HUD_X = 4;
+constexpr int PERF_HUD_Y = 4;
+constexpr int PERF_HUD_WIDTH = 312;
+constexpr int PERF_HUD_HEIGHT = 146;
+constexpr int PERF_HUD_PADDING = 4;
+constexpr int PERF_HUD_BAR_X = 120; // Phase bars, after the labels
+const float PERF_HUD_BAR_MAX = 184.0f;
+
+typedef struct HudColor
+{
+    Uint8 r, g, b, a;
+} HudColor;
+
+const char* PerfHudPhaseNames[] = {
+    "Input", "Simulate", "Render", "Build", "Wait",
+};
+
+global_variable const HudColor PhaseColors[] = {
+    { 80, 160, 255, 255 }, // Input
+    { 255, 160, 64, 255 }, // Simulate
+    { 96, 220, 96, 255 },  // Render
+    { 220, 96, 220, 255 }, // Build
+    { 128, 128, 128, 255 }, // Wait
+};
+
+global_variable const HudColor PanelColor = { 0, 0, 0, 176 };
+global_variable const HudColor BudgetColor = { 255, 255, 255, 128 };
+global_variable const HudColor UnderBudgetColor = { 96, 220, 96, 255 };
+global_variable const HudColor OverBudgetColor = { 240, 200, 48, 255 };
+global_variable const HudColor FarOverBudgetColor = { 240, 64, 48, 255 };
+
+static_assert(SDL_arraysize(PhaseColors) == PERF_HUD_PHASE_COUNT,
+              "One color per phase");
+
+typedef struct HudBatch
+{
+    PositionColorVertex* vertices;
+    Uint32 count;
+} HudBatch;
+
+// -------------------------------------------------------------------------------
+internal double
+ToMs(double seconds)
+{
+    return seconds * 1000.0;
+}
+
+// Two triangles, dropped once the batch is full
+internal void
+PushRect(HudBatch* batch,
+         float x,
+         float y,
+         float width,
+         float height,
+         HudColor color)
+{
+    if (batch->count + 6 > PERF_HUD_MAX_QUADS * 6)
+    {
+        return;
+    }
+
+    const float xs[6] = { x, x + width, x + width, x, x + width, x };
+    const float ys[6] = { y, y, y + height, y, y + height, y + height };
+    for (int i = 0; i < 6; ++i)
+    {
+        batch->vertices[batch->count++] = (PositionColorVertex){
+            xs[i], ys[i], 0.0f, color.r, color.g, color.b, color.a,
+        };
+    }
+}
+
+internal float
+BudgetMs(const Context* context)
+{
+    Uint64 frameNS = context->framePacer.frameNS;
+    return frameNS > 0 ? (float)(frameNS / 1e6) : 1000.0f / 60.0f;
+}
+
+internal void
+BuildGraph(Context* context, HudBatch* batch, int x, int y)
+{
+    const PerfHud* hud = &context->perfHud;
+    const float budgetMs = BudgetMs(context);
+    const float topMs = budgetMs * PERF_HUD_GRAPH_BUDGETS;
+    const float pixelsPerMs = PERF_HUD_GRAPH_HEIGHT / topMs;
+    const float bottom = (float)(y + PERF_HUD_GRAPH_HEIGHT);
+
+    // Oldest frame on the left
+    int first = PERF_HUD_HISTORY - hud->sampleCount;
+    for (int i = 0; i < hud->sampleCount; ++i)
+    {
+        int index = (hud->cursor - hud->sampleCount + i + PERF_HUD_HISTORY) %
+                    PERF_HUD_HISTORY;
+        float ms = hud->frameMs[index];
+        HudColor color = ms <= budgetMs ? UnderBudgetColor
+                         : ms <= topMs  ? OverBudgetColor
+                                        : FarOverBudgetColor;
+        float height = SDL_min(ms * pixelsPerMs, (float)PERF_HUD_GRAPH_HEIGHT);
+        PushRect(batch,
+                 (float)(x + first + i),
+                 bottom - height,
+                 1.0f,
+                 height,
+                 color);
+    }
+
+    PushRect(batch,
+             (float)x,
+             bottom - budgetMs * pixelsPerMs,
+             (float)PERF_HUD_HISTORY,
+             1.0f,
+             BudgetColor);
+}
+
+internal void
+BuildPhases(Context* context, HudBatch* batch, int x, int y)
+{
+    PerfHud* hud = &context->perfHud;
+    Font* font = &context->font;
+    const float pixelsPerMs =
+      PERF_HUD_BAR_MAX / (BudgetMs(context) * PERF_HUD_GRAPH_BUDGETS);
+
+    for (int phase = 0; phase < PERF_HUD_PHASE_COUNT; ++phase)
+    {
+        int lineY = y + phase * FONT_LINE_HEIGHT;
+        float ms = hud->phaseMs[phase];
+        PushRect(batch,
+                 (float)x,
+                 (float)(lineY + 1),
+                 5.0f,
+                 5.0f,
+                 PhaseColors[phase]);
+        FontPrintf(font,
+                   x + 8,
+                   lineY,
+                   1,
+                   "%-8s %6.2f ms",
+                   PerfHudPhaseNames[phase],
+                   ms);
+        PushRect(batch,
+                 (float)(x + PERF_HUD_BAR_X),
+                 (float)(lineY + 1),
+                 SDL_min(ms * pixelsPerMs, PERF_HUD_BAR_MAX),
+                 5.0f,
+                 PhaseColors[phase]);
+    }
+}
+
+// What the last frame drew and sent to the GPU
+internal void
+BuildCounters(Context* context, int x, int y)
+{
+    const PerfHud* hud = &context->perfHud;
+    const GameRenderer* renderer = &context->Renderer;
+    Font* font = &context->font;
+
+    Uint32 particleVertices = (Uint32)context->particles.drawCount * 4;
+    Uint32 textVertices = (Uint32)context->font.stats.glyphs * 4;
+    Uint32 vertices = (Uint32)renderer->spriteStats.dirtySprites * 4 +
+                      particleVertices + textVertices +
+                      context->debugDraw.stats.vertices + hud->vertexCount;
+    Uint64 uploadedBytes =
+      renderer->spriteStats.uploadedBytes +
+      context->tilemap.stats.uploadedBytes +
+      context->shapes.stats.uploadedBytes + context->font.stats.uploadedBytes +
+      sizeof(PositionTextureVertex) * particleVertices +
+      sizeof(PositionColorVertex) *
+        (context->debugDraw.stats.vertices + hud->vertexCount);
+
+    FontPrintf(font,
+               x,
+               y,
+               1,
+               "Draws %d  Verts %u  Upload %.1f kB  RT %.1f MB",
+               renderer->drawCalls,
+               vertices,
+               uploadedBytes / 1024.0,
+               renderer->targetPool.stats.liveBytes / (1024.0 * 1024.0));
+
+    const MemoryTracker* tracker = MemoryTrackerGet();
+    if (tracker->isInstalled)
+    {
+        Sint64 liveBytes = tracker->liveBytes.load();
+        Sint64 peakBytes = tracker->peakBytes.load();
+        FontPrintf(font,
+                   x,
+                   y + FONT_LINE_HEIGHT,
+                   1,
+                   "Memory %.1f MB  Peak %.1f MB  HUD %.3f ms",
+                   liveBytes / (1024.0 * 1024.0),
+                   peakBytes / (1024.0 * 1024.0),
+                   ToMs(hud->buildSeconds));
+    }
+    else
+    {
+        FontPrintf(font,
+                   x,
+                   y + FONT_LINE_HEIGHT,
+                   1,
+                   "Memory n/a  HUD %.3f ms",
+                   ToMs(hud->buildSeconds));
+    }
+
+    // CPU cost of recording each effect
+    const PostStats* post = &context->post.stats;
+    if (PostIsActive(context))
+    {
+        FontPrintf(font,
+                   x,
+                   y + FONT_LINE_HEIGHT * 2,
+                   1,
+                   "Post %d passes  Bloom %.3f  Grade %.3f  Scan %.3f",
+                   post->passes,
+                   ToMs(post->effectSeconds[POST_EFFECT_BLOOM]),
+                   ToMs(post->effectSeconds[POST_EFFECT_GRADE]),
+                   ToMs(post->effectSeconds[POST_EFFECT_SCANLINES]));
+    }
+
+    const DynamicResolution* controller = &context->dynamicResolution;
+    if (DynamicResolutionIsActive(context))
+    {
+        FontPrintf(font,
+                   x,
+                   y + FONT_LINE_HEIGHT * 3,
+                   1,
+                   "Res %ux%u  Scale %.3f  Busy %.2f ms",
+                   renderer->renderWidth,
+                   renderer->renderHeight,
+                   controller->scale,
+                   controller->smoothedMs);
+    }
+}
+
+// -------------------------------------------------------------------------------
+int
+PerfHudInit(Context* context)
+{
+    PerfHud* hud = &context->perfHud;
+    SDL_GPUDevice* device = context->Renderer.Device;
+    if (!context->debugDraw.isAvailable || !context->font.isAvailable)
+    {
+        return -1;
+    }
+
+    SDL_GPUBufferCreateInfo vertexBufferCreateInfo = {
+        .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
+        .size = sizeof(PositionColorVertex) * PERF_HUD_MAX_QUADS * 6,
+    };
+    hud->VertexBuffer = SDL_CreateGPUBuffer(device, &vertexBufferCreateInfo);
+    SDL_SetGPUBufferName(device, hud->VertexBuffer, "Perf HUD Vertex Buffer");
+
+    SDL_GPUTransferBufferCreateInfo transferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = sizeof(PositionColorVertex) * PERF_HUD_MAX_QUADS * 6,
+    };
+    hud->TransferBuffer =
+      SDL_CreateGPUTransferBuffer(device, &transferBufferCreateInfo);
+
+    if (hud->VertexBuffer == NULL || hud->TransferBuffer == NULL)
+    {
+        SDL_Log("Could not create the HUD buffers: %s", SDL_GetError());
+        PerfHudDestroy(context);
+        return -1;
+    }
+
+    hud->isAvailable = true;
+
+    return 0;
+}
+
+void
+PerfHudRecordFrame(Context* context, float deltaTime)
+{
+    PerfHud* hud = &context->perfHud;
+    const FramePipelineStats* pipeline = &context->framePipeline.stats;
+    const FramePacerStats* pacer = &context->framePacer.stats;
+
+    hud->frameMs[hud->cursor] = (float)ToMs(deltaTime);
+    hud->cursor = (hud->cursor + 1) % PERF_HUD_HISTORY;
+    hud->sampleCount = SDL_min(hud->sampleCount + 1, PERF_HUD_HISTORY);
+
+    // The pipeline stats start over when F6 switches modes
+    if (pipeline->frames < hud->lastPipeline.frames)
+    {
+        hud->lastPipeline = (FramePipelineStats){ 0 };
+    }
+
+    double phaseSeconds[PERF_HUD_PHASE_COUNT] = {
+        pipeline->inputSeconds - hud->lastPipeline.inputSeconds,
+        pipeline->simulateSeconds - hud->lastPipeline.simulateSeconds,
+        pipeline->renderSeconds - hud->lastPipeline.renderSeconds,
+        pipeline->buildSeconds - hud->lastPipeline.buildSeconds,
+        (pacer->sleepNS + pacer->spinNS - hud->lastPacer.sleepNS -
+         hud->lastPacer.spinNS) /
+          1e9,
+    };
+    for (int phase = 0; phase < PERF_HUD_PHASE_COUNT; ++phase)
+    {
+        hud->phaseMs[phase] +=
+          ((float)ToMs(phaseSeconds[phase]) - hud->phaseMs[phase]) *
+          PERF_HUD_SMOOTHING;
+    }
+
+    hud->lastPipeline = *pipeline;
+    hud->lastPacer = *pacer;
+}
+
+void
+PerfHudBuild(Context* context)
+{
+    PerfHud* hud = &context->perfHud;
+    hud->vertexCount = 0;
+    if (!hud->isAvailable || !hud->isEnabled)
+    {
+        return;
+    }
+
+    PROFILE_FUNCTION();
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    HudBatch batch = {
+        .vertices = static_cast<PositionColorVertex*>(SDL_MapGPUTransferBuffer(
+          context->Renderer.Device, hud->TransferBuffer, true)),
+        .count = 0,
+    };
+
+    PushRect(&batch,
+             (float)PERF_HUD_X,
+             (float)PERF_HUD_Y,
+             (float)PERF_HUD_WIDTH,
+             (float)PERF_HUD_HEIGHT,
+             PanelColor);
+
+    // Frame time over the history
+    float sum = 0.0f;
+    float max = 0.0f;
+    for (int i = 0; i < hud->sampleCount; ++i)
+    {
+        sum += hud->frameMs[i];
+        max = SDL_max(max, hud->frameMs[i]);
+    }
+    float last =
+      hud->frameMs[(hud->cursor + PERF_HUD_HISTORY - 1) % PERF_HUD_HISTORY];
+    float mean = hud->sampleCount > 0 ? sum / hud->sampleCount : 0.0f;
+
+    int x = PERF_HUD_X + PERF_HUD_PADDING;
+    int y = PERF_HUD_Y + PERF_HUD_PADDING;
+    FontPrintf(&context->font,
+               x,
+               y,
+               1,
+               "Frame %6.2f ms  Mean %6.2f  Max %6.2f  %5.1f fps",
+               last,
+               mean,
+               max,
+               mean > 0.0f ? 1000.0f / mean : 0.0f);
+
+    y += FONT_LINE_HEIGHT + 2;
+    BuildGraph(context, &batch, x, y);
+
+    y += PERF_HUD_GRAPH_HEIGHT + 3;
+    BuildPhases(context, &batch, x, y);
+
+    y += PERF_HUD_PHASE_COUNT * FONT_LINE_HEIGHT + 2;
+    BuildCounters(context, x, y);
+
+    SDL_UnmapGPUTransferBuffer(context->Renderer.Device, hud->TransferBuffer);
+    hud->vertexCount = batch.count;
+
+    hud->buildSeconds = (SDL_GetPerformanceCounter() - start) /
+                        (double)SDL_GetPerformanceFrequency();
+}
+
+void
+PerfHudUpload(Context* context, SDL_GPUCopyPass* copyPass)
+{
+    PerfHud* hud = &context->perfHud;
+    if (hud->vertexCount == 0)
+    {
+        return;
+    }
+
+    SDL_GPUTransferBufferLocation transferLocation = {
+        .transfer_buffer = hud->TransferBuffer,
+        .offset = 0,
+    };
+    SDL_GPUBufferRegion vertexBufferRegion = {
+        .buffer = hud->VertexBuffer,
+        .offset = 0,
+        .size =
+          static_cast<Uint32>(sizeof(PositionColorVertex) * hud->vertexCount),
+    };
+    SDL_UploadToGPUBuffer(
+      copyPass, &transferLocation, &vertexBufferRegion, true);
+}
+
+void
+PerfHudRender(Context* context, SDL_GPURenderPass* renderPass)
+{
+    PerfHud* hud = &context->perfHud;
+    if (hud->vertexCount == 0)
+    {
+        return;
+    }
+
+    SDL_BindGPUGraphicsPipeline(renderPass, context->debugDraw.Pipeline);
+
+    SDL_GPUBufferBinding vertexBufferBinding = {
+        .buffer = hud->VertexBuffer,
+        .offset = 0,
+    };
+    SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
+
+    SDL_DrawGPUPrimitives(renderPass, hud->vertexCount, 1, 0, 0);
+    RendererCountDraw(&context->Renderer);
+}
+
+void
+PerfHudDestroy(Context* context)
+{
+    PerfHud* hud = &context->perfHud;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    if (hud->VertexBuffer != NULL)
+    {
+        SDL_ReleaseGPUBuffer(device, hud->VertexBuffer);
+    }
+    if (hud->TransferBuffer != NULL)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, hud->TransferBuffer);
+    }
+
+    hud->VertexBuffer = NULL;
+    hud->TransferBuffer = NULL;
+    hud->isAvailable = false;
+}
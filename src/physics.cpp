@@ -0,0 +1,613 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glm/glm.hpp>
+#include <glm/vec2.hpp>
+
+#include <box2d/box2d.h>
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "memory_tracker.hpp"
+#include "physics.hpp"
+#include "profiler.hpp"
+
+constexpr int PHYSICS_SYNC_MIN_CHUNK = 512; // Move events per job
+
+const char* PhysicsEventNames[] = {
+    "ContactBegin", "ContactEnd", "ContactHit", "SensorBegin", "SensorEnd",
+};
+
+// -------------------------------------------------------------------------------
+internal b2BodyId*
+WallBodyId(Context* context, Uint32 wallIndex)
+{
+    b2BodyId* walls[PHYSICS_WALL_COUNT] = {
+        &context->topBoxId,
+        &context->bottomBoxId,
+        &context->leftBoxId,
+        &context->rightBoxId,
+    };
+    return walls[wallIndex];
+}
+
+internal b2BodyDef*
+WallBodyDef(Context* context, Uint32 wallIndex)
+{
+    b2BodyDef* defs[PHYSICS_WALL_COUNT] = {
+        &context->bodyDefTop,
+        &context->bodyDefBottom,
+        &context->bodyDefLeft,
+        &context->bodyDefRight,
+    };
+    return defs[wallIndex];
+}
+
+// Box2D task hooks, each parallel loop becomes a job system parallel-for
+internal void
+RunPhysicsTask(void* data, int start, int end, int workerIndex)
+{
+    PhysicsTask* task = (PhysicsTask*)data;
+    task->callback(start, end, (uint32_t)workerIndex, task->taskContext);
+}
+
+internal void*
+EnqueuePhysicsTask(b2TaskCallback* callback,
+                   int itemCount,
+                   int minRange,
+                   void* taskContext,
+                   void* userContext)
+{
+    Context* context = (Context*)userContext;
+    PhysicsState* physics = &context->physics;
+
+    if (physics->taskCount == PHYSICS_MAX_TASKS)
+    {
+        // Returning NULL tells Box2D the work already ran serially
+        callback(0, itemCount, (uint32_t)JobsCurrentWorker(), taskContext);
+        return NULL;
+    }
+
+    PhysicsTask* task = &physics->tasks[physics->taskCount++];
+    task->callback = callback;
+    task->taskContext = taskContext;
+    task->counter.value.store(0, std::memory_order_relaxed);
+
+    JobsParallelFor(&context->jobs,
+                    RunPhysicsTask,
+                    task,
+                    itemCount,
+                    minRange,
+                    &task->counter);
+
+    return task;
+}
+
+internal void
+FinishPhysicsTask(void* userTask, void* userContext)
+{
+    Context* context = (Context*)userContext;
+    PhysicsTask* task = (PhysicsTask*)userTask;
+    JobsWait(&context->jobs, &task->counter);
+}
+
+internal void
+CreateWorld(Context* context)
+{
+    context->worldDef = b2DefaultWorldDef();
+    context->worldDef.gravity = (b2Vec2){ 0.0f, 0.0f };
+    if (context->jobs.workerCount > 1)
+    {
+        context->worldDef.workerCount = context->jobs.workerCount;
+        context->worldDef.enqueueTask = EnqueuePhysicsTask;
+        context->worldDef.finishTask = FinishPhysicsTask;
+        context->worldDef.userTaskContext = context;
+    }
+    context->worldId = b2CreateWorld(&context->worldDef);
+
+    context->groundShapeDef = b2DefaultShapeDef();
+    context->groundShapeDef.material.friction = 0.0f;
+    context->groundShapeDef.material.restitution = 1.0f;
+}
+
+b2BodyId
+PhysicsCreateBody(Context* context, const PhysicsBodyDesc* desc)
+{
+    const EntityTable* entities = &context->entities;
+    Uint8 kind = entities->kind[desc->entity];
+    Uint32 index = entities->index[desc->entity];
+
+    b2BodyDef localBodyDef = b2DefaultBodyDef();
+    b2BodyDef* bodyDef =
+      kind == ENTITY_KIND_WALL ? WallBodyDef(context, index) : &localBodyDef;
+    *bodyDef = b2DefaultBodyDef();
+    bodyDef->type = (b2BodyType)desc->type;
+    bodyDef->position = (b2Vec2){ PhysicsToMeters(desc->position.x),
+                                  PhysicsToMeters(desc->position.y) };
+    bodyDef->rotation = desc->rotation;
+    bodyDef->linearVelocity = (b2Vec2){ PhysicsToMeters(desc->velocity.x),
+                                        PhysicsToMeters(desc->velocity.y) };
+    bodyDef->angularVelocity = desc->angularVelocity;
+    bodyDef->isAwake = desc->isAwake;
+    bodyDef->fixedRotation = kind != ENTITY_KIND_WALL; // Sprites stay upright
+    bodyDef->userData = EntityToUserData(desc->entity);
+
+    b2BodyId bodyId = b2CreateBody(context->worldId, bodyDef);
+
+    if (kind == ENTITY_KIND_BALL)
+    {
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        shapeDef.userData = EntityToUserData(desc->entity);
+        shapeDef.material.friction = 0.0f;
+        shapeDef.material.restitution = 1.0f;
+        shapeDef.enableContactEvents = true;
+        shapeDef.enableSensorEvents = true;
+        shapeDef.enableHitEvents = true;
+
+        b2Circle circle = { .center = (b2Vec2){ 0.0f, 0.0f },
+                            .radius = PhysicsToMeters(desc->halfExtents.x) };
+        b2CreateCircleShape(bodyId, &shapeDef, &circle);
+
+        context->balls[index].bodyId = bodyId;
+    }
+    else if (kind == ENTITY_KIND_WALL)
+    {
+        b2Polygon box = b2MakeBox(PhysicsToMeters(desc->halfExtents.x),
+                                  PhysicsToMeters(desc->halfExtents.y));
+
+        context->groundShapeDef.userData = EntityToUserData(desc->entity);
+        b2CreatePolygonShape(bodyId, &context->groundShapeDef, &box);
+
+        *WallBodyId(context, index) = bodyId;
+        context->physics.wallCenters[index] = desc->position;
+        context->physics.wallHalfExtents[index] = desc->halfExtents;
+    }
+    else if (kind == ENTITY_KIND_BOX)
+    {
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        shapeDef.userData = EntityToUserData(desc->entity);
+        shapeDef.material.friction = 0.2f;
+        shapeDef.material.restitution = 0.5f;
+
+        b2Polygon box = b2MakeBox(PhysicsToMeters(desc->halfExtents.x),
+                                  PhysicsToMeters(desc->halfExtents.y));
+        b2CreatePolygonShape(bodyId, &shapeDef, &box);
+
+        Prop* prop = &context->props[index];
+        prop->bodyId = bodyId;
+        prop->position = desc->position;
+        prop->halfExtents = desc->halfExtents;
+    }
+
+    EntityMarkDirty(&context->entities, desc->entity);
+
+    return bodyId;
+}
+
+bool
+PhysicsDescribeBody(Context* context, EntityId entity, PhysicsBodyDesc* desc)
+{
+    const EntityTable* entities = &context->entities;
+    Uint8 kind = entities->kind[entity];
+    Uint32 index = entities->index[entity];
+
+    b2BodyId bodyId;
+    if (kind == ENTITY_KIND_BALL)
+    {
+        bodyId = context->balls[index].bodyId;
+        desc->halfExtents = glm::vec2(context->balls[index].radius);
+    }
+    else if (kind == ENTITY_KIND_WALL)
+    {
+        bodyId = *WallBodyId(context, index);
+        desc->halfExtents = context->physics.wallHalfExtents[index];
+    }
+    else if (kind == ENTITY_KIND_BOX)
+    {
+        bodyId = context->props[index].bodyId;
+        desc->halfExtents = context->props[index].halfExtents;
+    }
+    else
+    {
+        return false;
+    }
+
+    b2Transform transform = b2Body_GetTransform(bodyId);
+    b2Vec2 velocity = b2Body_GetLinearVelocity(bodyId);
+
+    desc->entity = entity;
+    desc->type = (Uint8)b2Body_GetType(bodyId);
+    desc->isAwake = b2Body_IsAwake(bodyId);
+    desc->position = glm::vec2(PhysicsToPixels(transform.p.x),
+                               PhysicsToPixels(transform.p.y));
+    desc->velocity =
+      glm::vec2(PhysicsToPixels(velocity.x), PhysicsToPixels(velocity.y));
+    desc->rotation = transform.q;
+    desc->angularVelocity = b2Body_GetAngularVelocity(bodyId);
+
+    return true;
+}
+
+void
+PhysicsRebuildWorld(Context* context,
+                    const PhysicsBodyDesc* bodies,
+                    int bodyCount)
+{
+    if (b2World_IsValid(context->worldId))
+    {
+        b2DestroyWorld(context->worldId);
+    }
+
+    // A fresh world has no cached contacts, so rebuilding from the same
+    // descriptions always continues the simulation identically
+    CreateWorld(context);
+    for (int i = 0; i < bodyCount; ++i)
+    {
+        PhysicsCreateBody(context, &bodies[i]);
+    }
+}
+
+internal void
+CreateWall(Context* context,
+           Uint32 wallIndex,
+           float centerX,
+           float centerY,
+           float halfWidth,
+           float halfHeight)
+{
+    PhysicsBodyDesc desc = { 0 };
+    desc.entity =
+      EntityCreate(&context->entities, ENTITY_KIND_WALL, wallIndex);
+    desc.type = b2_staticBody;
+    desc.isAwake = true;
+    desc.position = glm::vec2(centerX, centerY);
+    desc.rotation = (b2Rot){ 1.0f, 0.0f };
+    desc.halfExtents = glm::vec2(halfWidth, halfHeight);
+
+    PhysicsCreateBody(context, &desc);
+}
+
+// Box2D allocates through SDL so the memory tracker sees it
+internal void*
+PhysicsAlloc(unsigned int size, int alignment)
+{
+    MemoryTag previous = MemoryPushTag(MEMORY_TAG_PHYSICS);
+    void* result = SDL_aligned_alloc((size_t)alignment, size);
+    MemoryPopTag(previous);
+    return result;
+}
+
+internal void
+PhysicsFree(void* mem)
+{
+    SDL_aligned_free(mem);
+}
+
+int
+PhysicsInit(Context* context)
+{
+    b2SetAllocator(PhysicsAlloc, PhysicsFree);
+    CreateWorld(context);
+
+    // Create the surrounding walls, just outside of the visible area
+    const float halfThickness = PHYSICS_WALL_THICKNESS * 0.5f;
+    const float halfWidth = GAME_WIDTH * 0.5f + PHYSICS_WALL_THICKNESS;
+    const float halfHeight = GAME_HEIGHT * 0.5f + PHYSICS_WALL_THICKNESS;
+
+    CreateWall(context,
+               PHYSICS_WALL_TOP,
+               GAME_WIDTH * 0.5f,
+               -halfThickness,
+               halfWidth,
+               halfThickness);
+    CreateWall(context,
+               PHYSICS_WALL_BOTTOM,
+               GAME_WIDTH * 0.5f,
+               GAME_HEIGHT + halfThickness,
+               halfWidth,
+               halfThickness);
+    CreateWall(context,
+               PHYSICS_WALL_LEFT,
+               -halfThickness,
+               GAME_HEIGHT * 0.5f,
+               halfThickness,
+               halfHeight);
+    CreateWall(context,
+               PHYSICS_WALL_RIGHT,
+               GAME_WIDTH + halfThickness,
+               GAME_HEIGHT * 0.5f,
+               halfThickness,
+               halfHeight);
+
+    printf("Walls created\n");
+
+    return 0;
+}
+
+int
+PhysicsCreateBall(Context* context, Ball* ball)
+{
+    Uint32 ballIndex = (Uint32)(ball - context->balls);
+    ball->entity =
+      EntityCreate(&context->entities, ENTITY_KIND_BALL, ballIndex);
+    if (ball->entity == 0)
+    {
+        return -1;
+    }
+
+    PhysicsBodyDesc desc = { 0 };
+    desc.entity = ball->entity;
+    desc.type = b2_dynamicBody;
+    desc.isAwake = true;
+    desc.position = ball->position;
+    desc.velocity = ball->velocity;
+    desc.rotation = (b2Rot){ 1.0f, 0.0f };
+    desc.halfExtents = glm::vec2(ball->radius);
+
+    PhysicsCreateBody(context, &desc);
+
+    ball->speed = glm::length(ball->velocity);
+
+    return 0;
+}
+
+int
+PhysicsCreateBox(Context* context, Prop* prop, glm::vec2 velocity)
+{
+    if (prop->entity == 0)
+    {
+        return -1;
+    }
+
+    PhysicsBodyDesc desc = { 0 };
+    desc.entity = prop->entity;
+    desc.type = b2_dynamicBody;
+    desc.isAwake = true;
+    desc.position = prop->position;
+    desc.velocity = velocity;
+    desc.rotation = (b2Rot){ 1.0f, 0.0f };
+    desc.halfExtents = prop->halfExtents;
+
+    PhysicsCreateBody(context, &desc);
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------------
+internal EntityId
+ShapeEntity(b2ShapeId shapeId)
+{
+    // End events can reference shapes that were destroyed during the step
+    if (!b2Shape_IsValid(shapeId))
+    {
+        return 0;
+    }
+
+    return EntityFromUserData(b2Shape_GetUserData(shapeId));
+}
+
+internal void
+PushEvent(PhysicsState* physics,
+          PhysicsEventType type,
+          EntityId entityA,
+          EntityId entityB,
+          float approachSpeed)
+{
+    physics->lastStep.counts[type] += 1;
+    physics->lastStep.total += 1;
+
+    if (physics->eventCount >= physics->eventCapacity)
+    {
+        physics->lastStep.dropped += 1;
+        return;
+    }
+
+    PhysicsEvent* event = &physics->events[physics->eventCount++];
+    event->type = type;
+    event->entityA = entityA;
+    event->entityB = entityB;
+    event->approachSpeed = approachSpeed;
+}
+
+internal void
+AccumulateCounters(PhysicsEventCounters* dest,
+                   const PhysicsEventCounters* source)
+{
+    for (int i = 0; i < PHYSICS_EVENT_TYPE_COUNT; ++i)
+    {
+        dest->counts[i] += source->counts[i];
+    }
+    dest->total += source->total;
+    dest->dropped += source->dropped;
+}
+
+// Copies this step's contact and sensor events into the compact array
+internal void
+GatherEvents(Context* context)
+{
+    PhysicsState* physics = &context->physics;
+    physics->lastStep = (PhysicsEventCounters){ 0 };
+
+    b2ContactEvents contactEvents = b2World_GetContactEvents(context->worldId);
+    for (int i = 0; i < contactEvents.beginCount; ++i)
+    {
+        const b2ContactBeginTouchEvent* e = &contactEvents.beginEvents[i];
+        PushEvent(physics,
+                  PHYSICS_EVENT_CONTACT_BEGIN,
+                  ShapeEntity(e->shapeIdA),
+                  ShapeEntity(e->shapeIdB),
+                  0.0f);
+    }
+
+    for (int i = 0; i < contactEvents.endCount; ++i)
+    {
+        const b2ContactEndTouchEvent* e = &contactEvents.endEvents[i];
+        PushEvent(physics,
+                  PHYSICS_EVENT_CONTACT_END,
+                  ShapeEntity(e->shapeIdA),
+                  ShapeEntity(e->shapeIdB),
+                  0.0f);
+    }
+
+    for (int i = 0; i < contactEvents.hitCount; ++i)
+    {
+        const b2ContactHitEvent* e = &contactEvents.hitEvents[i];
+        PushEvent(physics,
+                  PHYSICS_EVENT_CONTACT_HIT,
+                  ShapeEntity(e->shapeIdA),
+                  ShapeEntity(e->shapeIdB),
+                  PhysicsToPixels(e->approachSpeed));
+    }
+
+    b2SensorEvents sensorEvents = b2World_GetSensorEvents(context->worldId);
+    for (int i = 0; i < sensorEvents.beginCount; ++i)
+    {
+        const b2SensorBeginTouchEvent* e = &sensorEvents.beginEvents[i];
+        PushEvent(physics,
+                  PHYSICS_EVENT_SENSOR_BEGIN,
+                  ShapeEntity(e->sensorShapeId),
+                  ShapeEntity(e->visitorShapeId),
+                  0.0f);
+    }
+
+    for (int i = 0; i < sensorEvents.endCount; ++i)
+    {
+        const b2SensorEndTouchEvent* e = &sensorEvents.endEvents[i];
+        PushEvent(physics,
+                  PHYSICS_EVENT_SENSOR_END,
+                  ShapeEntity(e->sensorShapeId),
+                  ShapeEntity(e->visitorShapeId),
+                  0.0f);
+    }
+
+    AccumulateCounters(&physics->lastFrame, &physics->lastStep);
+    AccumulateCounters(&physics->total, &physics->lastStep);
+}
+
+// Copies the transforms of every body that moved this step back into the
+// game data. Sleeping and static bodies are not reported, so they never
+// get marked dirty for the renderer.
+typedef struct SyncMovedBodiesJob
+{
+    Context* context;
+    const b2BodyMoveEvent* moveEvents;
+} SyncMovedBodiesJob;
+
+// Every move event names a different body, so balls and boxes can be
+// written in parallel. Box2D is only read here, the world is not stepping.
+internal void
+SyncMovedBodiesRange(void* data, int start, int end, int workerIndex)
+{
+    (void)workerIndex;
+    SyncMovedBodiesJob* job = (SyncMovedBodiesJob*)data;
+    Context* context = job->context;
+
+    for (int i = start; i < end; ++i)
+    {
+        const b2BodyMoveEvent* e = &job->moveEvents[i];
+        EntityId entity = EntityFromUserData(e->userData);
+        Uint32 index = context->entities.index[entity];
+        glm::vec2 position = glm::vec2(PhysicsToPixels(e->transform.p.x),
+                                       PhysicsToPixels(e->transform.p.y));
+
+        if (context->entities.kind[entity] == ENTITY_KIND_BOX)
+        {
+            context->props[index].position = position;
+            continue;
+        }
+
+        if (context->entities.kind[entity] != ENTITY_KIND_BALL)
+        {
+            continue;
+        }
+
+        Ball* ball = &context->balls[index];
+        ball->position = position;
+
+        b2Vec2 velocity = b2Body_GetLinearVelocity(ball->bodyId);
+        ball->velocity =
+          glm::vec2(PhysicsToPixels(velocity.x), PhysicsToPixels(velocity.y));
+    }
+}
+
+internal void
+SyncMovedBodies(Context* context)
+{
+    b2BodyEvents bodyEvents = b2World_GetBodyEvents(context->worldId);
+
+    SyncMovedBodiesJob job = {
+        .context = context,
+        .moveEvents = bodyEvents.moveEvents,
+    };
+    JobsParallelFor(&context->jobs,
+                    SyncMovedBodiesRange,
+                    &job,
+                    bodyEvents.moveCount,
+                    PHYSICS_SYNC_MIN_CHUNK,
+                    NULL);
+
+    // The dirty list is shared, fill it serially
+    for (int i = 0; i < bodyEvents.moveCount; ++i)
+    {
+        EntityId entity = EntityFromUserData(bodyEvents.moveEvents[i].userData);
+        EntityMarkDirty(&context->entities, entity);
+    }
+}
+
+void
+PhysicsStep(Context* context, float deltaTime)
+{
+    PROFILE_FUNCTION();
+    PhysicsState* physics = &context->physics;
+    physics->events =
+      ArenaPushArray(context->frameArena, PhysicsEvent, PHYSICS_MAX_EVENTS);
+    physics->eventCapacity = physics->events != NULL ? PHYSICS_MAX_EVENTS : 0;
+    physics->eventCount = 0;
+    physics->stepsThisFrame = 0;
+    physics->lastFrame = (PhysicsEventCounters){ 0 };
+
+    // Fixed timestep, dropping time instead of spiraling after long stalls
+    physics->accumulator += deltaTime;
+    while (physics->accumulator >= PHYSICS_TIMESTEP)
+    {
+        if (physics->stepsThisFrame == PHYSICS_MAX_STEPS_PER_FRAME)
+        {
+            physics->accumulator = 0.0f;
+            break;
+        }
+
+        physics->taskCount = 0;
+        {
+            PROFILE_ZONE("b2World_Step");
+            b2World_Step(context->worldId, PHYSICS_TIMESTEP, PHYSICS_SUBSTEPS);
+        }
+        GatherEvents(context);
+        SyncMovedBodies(context);
+
+        physics->accumulator -= PHYSICS_TIMESTEP;
+        physics->stepsThisFrame += 1;
+        physics->stepCount += 1;
+    }
+}
+
+void
+PhysicsDestroy(Context* context)
+{
+    if (b2World_IsValid(context->worldId))
+    {
+        b2DestroyWorld(context->worldId);
+    }
+
+    const PhysicsEventCounters* total = &context->physics.total;
+    if (context->physics.stepCount > 0)
+    {
+        printf("Physics: %llu steps, %.2f events per step (%d dropped)\n",
+               (unsigned long long)context->physics.stepCount,
+               total->total / (double)context->physics.stepCount,
+               total->dropped);
+    }
+}
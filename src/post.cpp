@@ -0,0 +1,536 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "post.hpp"
+#include "profiler.hpp"
+
+// Indices into GameRenderer.Samplers
+constexpr int POST_SAMPLER_POINT = 0;  // PointClamp
+constexpr int POST_SAMPLER_LINEAR = 2; // LinearClamp
+
+// The fragment uniform of every post shader, the last two floats depend on
+// the effect
+typedef struct PostUniforms
+{
+    float texelX;
+    float texelY;
+    float a;
+    float b;
+} PostUniforms;
+
+const char* PostEffectNames[] = {
+    "bloom",
+    "grade",
+    "scanlines",
+};
+
+static_assert(SDL_arraysize(PostEffectNames) == POST_EFFECT_COUNT,
+              "One name per effect");
+
+// -------------------------------------------------------------------------------
+internal double
+SecondsSince(Uint64 start)
+{
+    return (SDL_GetPerformanceCounter() - start) /
+           (double)SDL_GetPerformanceFrequency();
+}
+
+// Fullscreen triangle, no vertex input and no blending
+internal SDL_GPUGraphicsPipeline*
+CreatePipeline(Context* context,
+               SDL_GPUShader* vertexShader,
+               const char* fragmentShaderName,
+               Uint32 samplerCount)
+{
+    SDL_GPUDevice* device = context->Renderer.Device;
+    SDL_GPUShader* fragmentShader = RendererLoadShader(
+      context, device, fragmentShaderName, samplerCount, 1, 0, 0);
+    if (fragmentShader == NULL)
+    {
+        SDL_Log("Failed to create %s shader!", fragmentShaderName);
+        return NULL;
+    }
+
+    SDL_GPUColorTargetDescription colorTargetDescriptions[] = {
+        {
+          .format = SDL_GetGPUSwapchainTextureFormat(device,
+                                                     context->Renderer.Window),
+        },
+    };
+
+    SDL_GPUGraphicsPipelineCreateInfo pipelineCreateInfo = {
+        .vertex_shader = vertexShader,
+        .fragment_shader = fragmentShader,
+        .primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
+        .rasterizer_state =
+          (SDL_GPURasterizerState){
+            .fill_mode = SDL_GPU_FILLMODE_FILL,
+            .cull_mode = SDL_GPU_CULLMODE_NONE,
+            .front_face = SDL_GPU_FRONTFACE_CLOCKWISE,
+          },
+        .target_info = {
+          .color_target_descriptions = colorTargetDescriptions,
+          .num_color_targets = 1,
+        },
+    };
+
+    SDL_GPUGraphicsPipeline* pipeline =
+      SDL_CreateGPUGraphicsPipeline(device, &pipelineCreateInfo);
+    SDL_ReleaseGPUShader(device, fragmentShader);
+
+    if (pipeline == NULL)
+    {
+        SDL_Log("Failed to create %s pipeline!", fragmentShaderName);
+    }
+
+    return pipeline;
+}
+
+internal Uint8
+ToUnorm8(float value)
+{
+    return (Uint8)(SDL_clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// A mild S curve, a little more saturation, shadows pushed towards blue
+// and highlights towards orange
+internal glm::vec3
+Grade(glm::vec3 color)
+{
+    glm::vec3 curved = color * color * (3.0f - 2.0f * color);
+    color = glm::mix(color, curved, 0.5f);
+
+    float luma = glm::dot(color, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+    color = glm::vec3(luma) + (color - glm::vec3(luma)) * 1.15f;
+    color += (luma - 0.5f) * glm::vec3(0.06f, 0.02f, -0.06f);
+
+    return color;
+}
+
+// Builds the LUT on the CPU and uploads it with a command buffer of its own
+internal int
+CreateLut(Context* context)
+{
+    PostChain* post = &context->post;
+    SDL_GPUDevice* device = context->Renderer.Device;
+    const Uint32 width = POST_LUT_SIZE * POST_LUT_SIZE;
+    const Uint32 height = POST_LUT_SIZE;
+
+    SDL_GPUTextureCreateInfo lutCreateInfo = {
+        .type = SDL_GPU_TEXTURETYPE_2D,
+        .format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
+        .usage = SDL_GPU_TEXTUREUSAGE_SAMPLER,
+        .width = width,
+        .height = height,
+        .layer_count_or_depth = 1,
+        .num_levels = 1,
+    };
+    post->Lut = SDL_CreateGPUTexture(device, &lutCreateInfo);
+    if (post->Lut == NULL)
+    {
+        return -1;
+    }
+    SDL_SetGPUTextureName(device, post->Lut, "Color Grading LUT");
+
+    SDL_GPUTransferBufferCreateInfo transferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = width * height * 4,
+    };
+    SDL_GPUTransferBuffer* transferBuffer =
+      SDL_CreateGPUTransferBuffer(device, &transferBufferCreateInfo);
+    if (transferBuffer == NULL)
+    {
+        return -1;
+    }
+
+    Uint8* pixels = static_cast<Uint8*>(
+      SDL_MapGPUTransferBuffer(device, transferBuffer, false));
+    const float step = 1.0f / (POST_LUT_SIZE - 1);
+    for (int b = 0; b < POST_LUT_SIZE; ++b)
+    {
+        for (int g = 0; g < POST_LUT_SIZE; ++g)
+        {
+            for (int r = 0; r < POST_LUT_SIZE; ++r)
+            {
+                glm::vec3 color =
+                  Grade(glm::vec3(r * step, g * step, b * step));
+                Uint8* pixel = &pixels[(g * width + b * POST_LUT_SIZE + r) * 4];
+                pixel[0] = ToUnorm8(color.r);
+                pixel[1] = ToUnorm8(color.g);
+                pixel[2] = ToUnorm8(color.b);
+                pixel[3] = 255;
+            }
+        }
+    }
+    SDL_UnmapGPUTransferBuffer(device, transferBuffer);
+
+    SDL_GPUCommandBuffer* cmdbuf = SDL_AcquireGPUCommandBuffer(device);
+    if (cmdbuf == NULL)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        return -1;
+    }
+
+    SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(cmdbuf);
+    SDL_GPUTextureTransferInfo transferInfo = {
+        .transfer_buffer = transferBuffer,
+        .offset = 0,
+    };
+    SDL_GPUTextureRegion lutRegion = {
+        .texture = post->Lut,
+        .w = width,
+        .h = height,
+        .d = 1,
+    };
+    SDL_UploadToGPUTexture(copyPass, &transferInfo, &lutRegion, false);
+    SDL_EndGPUCopyPass(copyPass);
+    SDL_SubmitGPUCommandBuffer(cmdbuf);
+
+    // Kept alive by the submitted command buffer
+    SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+
+    return 0;
+}
+
+// One full screen pass writing every pixel of target
+internal void
+RunPass(Context* context,
+        SDL_GPUCommandBuffer* cmdbuf,
+        SDL_GPUGraphicsPipeline* pipeline,
+        SDL_GPUTexture* target,
+        const SDL_GPUTextureSamplerBinding* bindings,
+        Uint32 bindingCount,
+        const PostUniforms* uniforms)
+{
+    SDL_GPUColorTargetInfo colorTargetInfo = { 0 };
+    colorTargetInfo.texture = target;
+    colorTargetInfo.load_op = SDL_GPU_LOADOP_DONT_CARE;
+    colorTargetInfo.store_op = SDL_GPU_STOREOP_STORE;
+
+    SDL_GPURenderPass* renderPass =
+      SDL_BeginGPURenderPass(cmdbuf, &colorTargetInfo, 1, NULL);
+    SDL_BindGPUGraphicsPipeline(renderPass, pipeline);
+    SDL_BindGPUFragmentSamplers(renderPass, 0, bindings, bindingCount);
+    SDL_PushGPUFragmentUniformData(
+      cmdbuf, 0, uniforms, sizeof(PostUniforms));
+    SDL_DrawGPUPrimitives(renderPass, 3, 1, 0, 0);
+    RendererCountDraw(&context->Renderer);
+    SDL_EndGPURenderPass(renderPass);
+
+    context->post.stats.passes += 1;
+}
+
+// Bright pass into a half size target, blurred there across and down, then
+// added back over the image. Returns NULL if a target is missing.
+internal SDL_GPUTexture*
+RenderBloom(Context* context,
+            SDL_GPUCommandBuffer* cmdbuf,
+            SDL_GPUTexture* image,
+            const RenderTargetDesc* desc)
+{
+    PostChain* post = &context->post;
+    RenderTargetPool* pool = &context->Renderer.targetPool;
+    SDL_GPUSampler* linear = context->Renderer.Samplers[POST_SAMPLER_LINEAR];
+
+    RenderTargetDesc halfDesc = *desc;
+    halfDesc.width = SDL_max(desc->width / 2, 1u);
+    halfDesc.height = SDL_max(desc->height / 2, 1u);
+    SDL_GPUTexture* bloom = RenderTargetPoolAcquire(pool, &halfDesc);
+    SDL_GPUTexture* scratch = RenderTargetPoolAcquire(pool, &halfDesc);
+    SDL_GPUTexture* output = RenderTargetPoolAcquire(pool, desc);
+    if (bloom == NULL || scratch == NULL || output == NULL)
+    {
+        RenderTargetPoolRelease(pool, bloom);
+        RenderTargetPoolRelease(pool, scratch);
+        RenderTargetPoolRelease(pool, output);
+        return NULL;
+    }
+
+    const float texelX = 1.0f / halfDesc.width;
+    const float texelY = 1.0f / halfDesc.height;
+
+    SDL_GPUTextureSamplerBinding imageBinding = { image, linear };
+    PostUniforms brightUniforms = {
+        1.0f / desc->width, 1.0f / desc->height, POST_BLOOM_THRESHOLD, 0.0f
+    };
+    RunPass(context,
+            cmdbuf,
+            post->BrightPipeline,
+            bloom,
+            &imageBinding,
+            1,
+            &brightUniforms);
+
+    SDL_GPUTextureSamplerBinding bloomBinding = { bloom, linear };
+    PostUniforms acrossUniforms = { texelX, 0.0f, 0.0f, 0.0f };
+    RunPass(context,
+            cmdbuf,
+            post->BlurPipeline,
+            scratch,
+            &bloomBinding,
+            1,
+            &acrossUniforms);
+
+    SDL_GPUTextureSamplerBinding scratchBinding = { scratch, linear };
+    PostUniforms downUniforms = { 0.0f, texelY, 0.0f, 0.0f };
+    RunPass(context,
+            cmdbuf,
+            post->BlurPipeline,
+            bloom,
+            &scratchBinding,
+            1,
+            &downUniforms);
+    RenderTargetPoolRelease(pool, scratch);
+
+    SDL_GPUTextureSamplerBinding compositeBindings[] = {
+        { image, context->Renderer.Samplers[POST_SAMPLER_POINT] },
+        { bloom, linear },
+    };
+    PostUniforms bloomUniforms = {
+        1.0f / desc->width, 1.0f / desc->height, POST_BLOOM_STRENGTH, 0.0f
+    };
+    RunPass(context,
+            cmdbuf,
+            post->BloomPipeline,
+            output,
+            compositeBindings,
+            2,
+            &bloomUniforms);
+    RenderTargetPoolRelease(pool, bloom);
+
+    return output;
+}
+
+// -------------------------------------------------------------------------------
+int
+PostInit(Context* context, Uint32 enabledEffects)
+{
+    PostChain* post = &context->post;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    SDL_GPUShader* vertexShader =
+      RendererLoadShader(context, device, "Fullscreen.vert", 0, 0, 0, 0);
+    if (vertexShader == NULL)
+    {
+        SDL_Log("Failed to create full screen vertex shader!");
+        return -1;
+    }
+
+    post->CopyPipeline =
+      CreatePipeline(context, vertexShader, "PostCopy.frag", 1);
+    post->BrightPipeline =
+      CreatePipeline(context, vertexShader, "PostBright.frag", 1);
+    post->BlurPipeline =
+      CreatePipeline(context, vertexShader, "PostBlur.frag", 1);
+    post->BloomPipeline =
+      CreatePipeline(context, vertexShader, "PostBloom.frag", 2);
+    post->GradePipeline =
+      CreatePipeline(context, vertexShader, "PostGrade.frag", 2);
+    post->ScanlinePipeline =
+      CreatePipeline(context, vertexShader, "PostScanlines.frag", 1);
+    SDL_ReleaseGPUShader(device, vertexShader);
+
+    if (post->CopyPipeline == NULL || post->BrightPipeline == NULL ||
+        post->BlurPipeline == NULL || post->BloomPipeline == NULL ||
+        post->GradePipeline == NULL || post->ScanlinePipeline == NULL)
+    {
+        PostDestroy(context);
+        return -1;
+    }
+
+    if (CreateLut(context) < 0)
+    {
+        SDL_Log("Could not create the grading LUT: %s", SDL_GetError());
+        PostDestroy(context);
+        return -1;
+    }
+
+    for (int effect = 0; effect < POST_EFFECT_COUNT; ++effect)
+    {
+        post->isEffectEnabled[effect] = (enabledEffects >> effect) & 1;
+    }
+    post->isAvailable = true;
+
+    return 0;
+}
+
+bool
+PostIsActive(const Context* context)
+{
+    const PostChain* post = &context->post;
+    if (!post->isAvailable)
+    {
+        return false;
+    }
+
+    for (int effect = 0; effect < POST_EFFECT_COUNT; ++effect)
+    {
+        if (post->isEffectEnabled[effect])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+PostToggleEffect(Context* context, PostEffect effect)
+{
+    PostChain* post = &context->post;
+    if (!post->isAvailable)
+    {
+        return;
+    }
+
+    post->isEffectEnabled[effect] = !post->isEffectEnabled[effect];
+    post->stats.effectSeconds[effect] = 0.0;
+    SDL_Log("Post %s: %s",
+            PostEffectNames[effect],
+            post->isEffectEnabled[effect] ? "on" : "off");
+}
+
+SDL_GPUTexture*
+PostRender(Context* context,
+           SDL_GPUCommandBuffer* cmdbuf,
+           SDL_GPUTexture* image,
+           Uint32 width,
+           Uint32 height)
+{
+    PROFILE_FUNCTION();
+    PostChain* post = &context->post;
+    RenderTargetPool* pool = &context->Renderer.targetPool;
+    SDL_GPUSampler* point = context->Renderer.Samplers[POST_SAMPLER_POINT];
+
+    const RenderTargetDesc desc = {
+        .width = width,
+        .height = height,
+        .format = SDL_GetGPUSwapchainTextureFormat(context->Renderer.Device,
+                                                   context->Renderer.Window),
+        .usage =
+          SDL_GPU_TEXTUREUSAGE_COLOR_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER,
+    };
+    const float texelX = 1.0f / width;
+    const float texelY = 1.0f / height;
+    post->stats.passes = 0;
+
+    for (int effect = 0; effect < POST_EFFECT_COUNT; ++effect)
+    {
+        post->stats.effectSeconds[effect] = 0.0;
+        if (!post->isEffectEnabled[effect])
+        {
+            continue;
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        SDL_GPUTexture* output = NULL;
+        if (effect == POST_EFFECT_BLOOM)
+        {
+            output = RenderBloom(context, cmdbuf, image, &desc);
+        }
+        else if ((output = RenderTargetPoolAcquire(pool, &desc)) != NULL)
+        {
+            SDL_GPUTextureSamplerBinding bindings[] = {
+                { image, point },
+                { post->Lut, context->Renderer.Samplers[POST_SAMPLER_LINEAR] },
+            };
+
+            if (effect == POST_EFFECT_GRADE)
+            {
+                PostUniforms uniforms = {
+                    texelX, texelY, (float)POST_LUT_SIZE, POST_GRADE_AMOUNT
+                };
+                RunPass(context,
+                        cmdbuf,
+                        post->GradePipeline,
+                        output,
+                        bindings,
+                        2,
+                        &uniforms);
+            }
+            else
+            {
+                // One line per game row, whatever the internal resolution
+                PostUniforms uniforms = { 1.0f / GAME_WIDTH,
+                                          1.0f / GAME_HEIGHT,
+                                          POST_SCANLINE_STRENGTH,
+                                          POST_VIGNETTE };
+                RunPass(context,
+                        cmdbuf,
+                        post->ScanlinePipeline,
+                        output,
+                        bindings,
+                        1,
+                        &uniforms);
+            }
+        }
+
+        // Out of targets, the effect is skipped this frame
+        if (output != NULL)
+        {
+            RenderTargetPoolRelease(pool, image);
+            image = output;
+        }
+        post->stats.effectSeconds[effect] = SecondsSince(start);
+    }
+
+    return image;
+}
+
+void
+PostUpscale(Context* context,
+            SDL_GPURenderPass* renderPass,
+            SDL_GPUTexture* image,
+            bool isFiltered)
+{
+    PostChain* post = &context->post;
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    SDL_GPUTextureSamplerBinding binding = {
+        .texture = image,
+        .sampler = context->Renderer.Samplers[isFiltered ? POST_SAMPLER_LINEAR
+                                                         : POST_SAMPLER_POINT],
+    };
+    SDL_BindGPUGraphicsPipeline(renderPass, post->CopyPipeline);
+    SDL_BindGPUFragmentSamplers(renderPass, 0, &binding, 1);
+    SDL_DrawGPUPrimitives(renderPass, 3, 1, 0, 0);
+    RendererCountDraw(&context->Renderer);
+
+    post->stats.upscaleSeconds = SecondsSince(start);
+}
+
+void
+PostDestroy(Context* context)
+{
+    PostChain* post = &context->post;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    SDL_GPUGraphicsPipeline** pipelines[] = {
+        &post->CopyPipeline,  &post->BrightPipeline, &post->BlurPipeline,
+        &post->BloomPipeline, &post->GradePipeline,  &post->ScanlinePipeline,
+    };
+    for (size_t i = 0; i < SDL_arraysize(pipelines); ++i)
+    {
+        if (*pipelines[i] != NULL)
+        {
+            SDL_ReleaseGPUGraphicsPipeline(device, *pipelines[i]);
+            *pipelines[i] = NULL;
+        }
+    }
+
+    if (post->Lut != NULL)
+    {
+        SDL_ReleaseGPUTexture(device, post->Lut);
+        post->Lut = NULL;
+    }
+
+    post->isAvailable = false;
+}
@@ -0,0 +1,204 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+
+// Our code
+#include "includes.hpp"
+#include "profiler.hpp"
+
+const Uint32 PROFILER_CALIBRATION_MS = 20;
+const int PROFILER_OVERHEAD_ZONES = 100000;
+
+std::atomic<bool> ProfilerIsEnabled;
+thread_local ProfileThread* ProfilerCurrentThread;
+
+global_variable ProfileThread* Threads[PROFILER_MAX_THREADS];
+global_variable std::atomic<int> ThreadCount;
+global_variable double TicksPerMicrosecond;
+global_variable Uint64 StartTicks;
+
+// -------------------------------------------------------------------------------
+internal double
+CalibrateTicks(void)
+{
+#if PROFILER_USE_TSC
+    Uint64 counterStart = SDL_GetPerformanceCounter();
+    Uint64 ticksStart = ProfilerTimestamp();
+    SDL_Delay(PROFILER_CALIBRATION_MS);
+    Uint64 ticks = ProfilerTimestamp() - ticksStart;
+    Uint64 counter = SDL_GetPerformanceCounter() - counterStart;
+
+    double seconds = counter / (double)SDL_GetPerformanceFrequency();
+    return ticks / (seconds * 1e6);
+#else
+    return SDL_GetPerformanceFrequency() / 1e6;
+#endif
+}
+
+ProfileThread*
+ProfilerRegisterThread(void)
+{
+    int index = ThreadCount.fetch_add(1, std::memory_order_relaxed);
+    if (index >= PROFILER_MAX_THREADS)
+    {
+        ThreadCount.store(PROFILER_MAX_THREADS, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    ProfileThread* thread =
+      (ProfileThread*)SDL_calloc(1, sizeof(ProfileThread));
+    if (thread == NULL)
+    {
+        return NULL;
+    }
+
+    thread->index = index;
+    SDL_snprintf(thread->name, sizeof(thread->name), "Thread %d", index);
+
+    Threads[index] = thread;
+    ProfilerCurrentThread = thread;
+
+    return thread;
+}
+
+void
+ProfilerSetThreadName(const char* name)
+{
+    ProfileThread* thread = ProfilerCurrentThread;
+    if (thread == NULL)
+    {
+        thread = ProfilerRegisterThread();
+        if (thread == NULL)
+        {
+            return;
+        }
+    }
+
+    SDL_strlcpy(thread->name, name, sizeof(thread->name));
+}
+
+// Times empty zones on the calling thread, then drops them again
+internal double
+MeasureOverhead(void)
+{
+    ProfileThread* thread = ProfilerCurrentThread;
+    Uint64 count = thread->count.load(std::memory_order_relaxed);
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < PROFILER_OVERHEAD_ZONES; ++i)
+    {
+        PROFILE_ZONE("Overhead");
+    }
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+    thread->count.store(count, std::memory_order_relaxed);
+
+    return elapsed * 1e9 /
+           ((double)SDL_GetPerformanceFrequency() * PROFILER_OVERHEAD_ZONES);
+}
+
+int
+ProfilerInit(void)
+{
+    TicksPerMicrosecond = CalibrateTicks();
+    StartTicks = ProfilerTimestamp();
+
+    ProfilerSetThreadName("Main");
+    if (ProfilerCurrentThread == NULL)
+    {
+        SDL_Log("Could not register the main thread with the profiler");
+        return -1;
+    }
+
+    ProfilerIsEnabled.store(true, std::memory_order_relaxed);
+    printf("Profiler: %.1f ns per zone\n", MeasureOverhead());
+
+    return 0;
+}
+
+void
+ProfilerShutdown(void)
+{
+    ProfilerIsEnabled.store(false, std::memory_order_relaxed);
+
+    int threadCount = SDL_min(ThreadCount.load(), PROFILER_MAX_THREADS);
+    for (int i = 0; i < threadCount; ++i)
+    {
+        SDL_free(Threads[i]);
+        Threads[i] = NULL;
+    }
+    ThreadCount.store(0);
+    ProfilerCurrentThread = NULL;
+}
+
+// Zones still being written by other threads may come out torn, the
+// trace is a debugging aid and does not stop the world for it
+int
+ProfilerWriteTrace(const char* path)
+{
+    SDL_IOStream* file = SDL_IOFromFile(path, "w");
+    if (file == NULL)
+    {
+        SDL_Log("Could not open %s: %s", path, SDL_GetError());
+        return -1;
+    }
+
+    SDL_IOprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    bool isFirst = true;
+    Uint64 zoneCount = 0;
+    int threadCount = SDL_min(ThreadCount.load(), PROFILER_MAX_THREADS);
+    for (int i = 0; i < threadCount; ++i)
+    {
+        const ProfileThread* thread = Threads[i];
+        if (thread == NULL)
+        {
+            continue;
+        }
+
+        SDL_IOprintf(file,
+                     "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                     "\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                     isFirst ? "" : ",\n",
+                     thread->index,
+                     thread->name);
+        isFirst = false;
+
+        Uint64 count = thread->count.load(std::memory_order_acquire);
+        Uint64 first = count > PROFILER_EVENTS_PER_THREAD
+                         ? count - PROFILER_EVENTS_PER_THREAD
+                         : 0;
+        for (Uint64 n = first; n < count; ++n)
+        {
+            const ProfileEvent* event =
+              &thread->events[n & (PROFILER_EVENTS_PER_THREAD - 1)];
+            if (event->start < StartTicks || event->end < event->start)
+            {
+                continue;
+            }
+
+            SDL_IOprintf(file,
+                         ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                         "\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         event->name,
+                         thread->index,
+                         (event->start - StartTicks) / TicksPerMicrosecond,
+                         (event->end - event->start) / TicksPerMicrosecond);
+            zoneCount += 1;
+        }
+    }
+
+    SDL_IOprintf(file, "\n]}\n");
+    SDL_CloseIO(file);
+
+    printf("Profiler: wrote %llu zones from %d threads to %s\n",
+           (unsigned long long)zoneCount,
+           threadCount,
+           path);
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// Our code
+#include "includes.hpp"
+#include "profiler.hpp"
+#include "render_target_pool.hpp"
+
+// -------------------------------------------------------------------------------
+internal bool
+DescEquals(const RenderTargetDesc* a, const RenderTargetDesc* b)
+{
+    return a->width == b->width && a->height == b->height &&
+           a->format == b->format && a->usage == b->usage;
+}
+
+internal void
+ReleaseTarget(RenderTargetPool* pool, RenderTarget* target)
+{
+    SDL_ReleaseGPUTexture(pool->device, target->texture);
+    pool->stats.liveTargets -= 1;
+    pool->stats.liveBytes -= target->bytes;
+    *target = (RenderTarget){ 0 };
+}
+
+// Frames finish in submission order, stops at the first one still running
+internal void
+RetireFrames(RenderTargetPool* pool, bool isWaiting)
+{
+    int retired = 0;
+    while (retired < pool->pendingCount)
+    {
+        RenderTargetFrame* pending = &pool->pending[retired];
+        if (isWaiting)
+        {
+            SDL_WaitForGPUFences(pool->device, true, &pending->fence, 1);
+        }
+        else if (!SDL_QueryGPUFence(pool->device, pending->fence))
+        {
+            break;
+        }
+
+        SDL_ReleaseGPUFence(pool->device, pending->fence);
+        pool->completedFrame = pending->frame;
+        retired += 1;
+    }
+
+    pool->pendingCount -= retired;
+    SDL_memmove(&pool->pending[0],
+                &pool->pending[retired],
+                sizeof(RenderTargetFrame) * pool->pendingCount);
+}
+
+// -------------------------------------------------------------------------------
+void
+RenderTargetPoolInit(RenderTargetPool* pool, SDL_GPUDevice* device)
+{
+    *pool = (RenderTargetPool){ 0 };
+    pool->device = device;
+}
+
+void
+RenderTargetPoolDestroy(RenderTargetPool* pool)
+{
+    if (pool->device == NULL)
+    {
+        return;
+    }
+
+    RetireFrames(pool, true);
+    for (int i = 0; i < RENDER_TARGET_POOL_MAX_TARGETS; ++i)
+    {
+        if (pool->targets[i].texture != NULL)
+        {
+            ReleaseTarget(pool, &pool->targets[i]);
+        }
+    }
+
+    pool->device = NULL;
+}
+
+void
+RenderTargetPoolBeginFrame(RenderTargetPool* pool)
+{
+    PROFILE_FUNCTION();
+    RetireFrames(pool, false);
+    pool->frame += 1;
+
+    for (int i = 0; i < RENDER_TARGET_POOL_MAX_TARGETS; ++i)
+    {
+        RenderTarget* target = &pool->targets[i];
+        if (target->texture == NULL)
+        {
+            continue;
+        }
+
+        // A frame that never reached EndFrame never submitted either
+        target->isAcquired = false;
+
+        if (target->lastUsedFrame <= pool->completedFrame &&
+            pool->frame - target->lastUsedFrame >
+              RENDER_TARGET_POOL_IDLE_FRAMES)
+        {
+            ReleaseTarget(pool, target);
+            pool->stats.evicted += 1;
+        }
+    }
+}
+
+SDL_GPUTexture*
+RenderTargetPoolAcquire(RenderTargetPool* pool, const RenderTargetDesc* desc)
+{
+    RenderTarget* freeEntry = NULL;
+    for (int i = 0; i < RENDER_TARGET_POOL_MAX_TARGETS; ++i)
+    {
+        RenderTarget* target = &pool->targets[i];
+        if (target->texture == NULL)
+        {
+            freeEntry = freeEntry != NULL ? freeEntry : target;
+            continue;
+        }
+
+        // Released earlier this frame is fine, the passes are ordered
+        // within the command buffer
+        bool isIdle =
+          target->lastUsedFrame <= pool->completedFrame ||
+          target->lastUsedFrame == pool->frame;
+        if (!target->isAcquired && isIdle && DescEquals(&target->desc, desc))
+        {
+            target->isAcquired = true;
+            target->lastUsedFrame = pool->frame;
+            pool->stats.reused += 1;
+            return target->texture;
+        }
+    }
+
+    if (freeEntry == NULL)
+    {
+        pool->stats.failures += 1;
+        return NULL;
+    }
+
+    SDL_GPUTextureCreateInfo createInfo = {
+        .type = SDL_GPU_TEXTURETYPE_2D,
+        .format = desc->format,
+        .usage = desc->usage,
+        .width = desc->width,
+        .height = desc->height,
+        .layer_count_or_depth = 1,
+        .num_levels = 1,
+    };
+    SDL_GPUTexture* texture = SDL_CreateGPUTexture(pool->device, &createInfo);
+    if (texture == NULL)
+    {
+        SDL_Log("Could not create a %u x %u render target: %s",
+                desc->width,
+                desc->height,
+                SDL_GetError());
+        pool->stats.failures += 1;
+        return NULL;
+    }
+    SDL_SetGPUTextureName(pool->device, texture, "Pooled Render Target");
+
+    freeEntry->desc = *desc;
+    freeEntry->texture = texture;
+    freeEntry->bytes = SDL_CalculateGPUTextureFormatSize(
+      desc->format, desc->width, desc->height, 1);
+    freeEntry->isAcquired = true;
+    freeEntry->lastUsedFrame = pool->frame;
+
+    pool->stats.created += 1;
+    pool->stats.liveTargets += 1;
+    pool->stats.liveBytes += freeEntry->bytes;
+    pool->stats.peakBytes =
+      SDL_max(pool->stats.peakBytes, pool->stats.liveBytes);
+
+    return texture;
+}
+
+void
+RenderTargetPoolRelease(RenderTargetPool* pool, SDL_GPUTexture* texture)
+{
+    if (texture == NULL)
+    {
+        return;
+    }
+
+    for (int i = 0; i < RENDER_TARGET_POOL_MAX_TARGETS; ++i)
+    {
+        if (pool->targets[i].texture == texture)
+        {
+            pool->targets[i].isAcquired = false;
+            return;
+        }
+    }
+}
+
+void
+RenderTargetPoolEndFrame(RenderTargetPool* pool, SDL_GPUFence* fence)
+{
+    for (int i = 0; i < RENDER_TARGET_POOL_MAX_TARGETS; ++i)
+    {
+        pool->targets[i].isAcquired = false;
+    }
+
+    if (fence == NULL)
+    {
+        return;
+    }
+
+    // More frames in flight than slots, wait for the oldest
+    if (pool->pendingCount == RENDER_TARGET_POOL_MAX_FRAMES)
+    {
+        PROFILE_ZONE("RenderTargetFenceWait");
+        SDL_WaitForGPUFences(pool->device, true, &pool->pending[0].fence, 1);
+        RetireFrames(pool, false);
+        pool->stats.fenceWaits += 1;
+    }
+
+    pool->pending[pool->pendingCount++] = (RenderTargetFrame){
+        .fence = fence,
+        .frame = pool->frame,
+    };
+}
+
+void
+RenderTargetPoolPrintStats(const RenderTargetPool* pool)
+{
+    const RenderTargetPoolStats* stats = &pool->stats;
+    printf("Render targets: %d live, %.1f MB (peak %.1f MB), %llu created, "
+           "%llu reused, %llu evicted, %llu failed, %llu fence waits\n",
+           stats->liveTargets,
+           stats->liveBytes / (1024.0 * 1024.0),
+           stats->peakBytes / (1024.0 * 1024.0),
+           (unsigned long long)stats->created,
+           (unsigned long long)stats->reused,
+           (unsigned long long)stats->evicted,
+           (unsigned long long)stats->failures,
+           (unsigned long long)stats->fenceWaits);
+}
@@ -14,6 +14,7 @@
 // Our code
 #include "context.hpp"
 #include "includes.hpp"
+#include "profiler.hpp"
 #include "renderer.hpp"
 
 const char* SamplerNames[] = {
@@ -21,10 +22,487 @@ const char* SamplerNames[] = {
     "LinearWrap", "AnisotropicClamp", "AnisotropicWrap",
 };
 
+// Indexed by SDL_GPUPresentMode
+const char* PresentModeNames[] = {
+    "Vsync",
+    "Immediate",
+    "Mailbox",
+};
+
 // -------------------------------------------------------------------------------
+// Pixel space bounds of an entity's sprite, false if it has none
+internal bool
+GetEntityBounds(Context* context,
+                EntityId entity,
+                glm::vec2* center,
+                glm::vec2* halfExtents)
+{
+    const EntityTable* entities = &context->entities;
+    Uint32 index = entities->index[entity];
+
+    switch (entities->kind[entity])
+    {
+        case ENTITY_KIND_BALL:
+        {
+            const Ball* ball = &context->balls[index];
+            *center = ball->position;
+            *halfExtents = glm::vec2(ball->radius);
+        }
+        return true;
+
+        case ENTITY_KIND_WALL:
+        {
+            *center = context->physics.wallCenters[index];
+            *halfExtents = context->physics.wallHalfExtents[index];
+        }
+        return true;
+
+        case ENTITY_KIND_BOX:
+        case ENTITY_KIND_SPRITE:
+        {
+            const Prop* prop = &context->props[index];
+            *center = prop->position;
+            *halfExtents = prop->halfExtents;
+        }
+        return true;
+
+        default:
+            return false;
+    }
+}
+
+internal void
+WriteEntitySprite(Context* context,
+                  EntityId entity,
+                  PositionTextureVertex* quad)
+{
+    glm::vec2 center;
+    glm::vec2 halfExtents;
+    if (GetEntityBounds(context, entity, &center, &halfExtents))
+    {
+        RendererWriteSpriteQuad(quad, center, halfExtents);
+    }
+    else
+    {
+        SDL_memset(quad, 0, sizeof(PositionTextureVertex) * 4);
+    }
+}
+
+typedef struct WriteDirtySpritesJob
+{
+    Context* context;
+    RenderSnapshot* snapshot;
+} WriteDirtySpritesJob;
+
+internal void
+WriteDirtySprites(void* data, int start, int end, int workerIndex)
+{
+    (void)workerIndex;
+    WriteDirtySpritesJob* job = (WriteDirtySpritesJob*)data;
+    RenderSnapshot* snapshot = job->snapshot;
+
+    for (int i = start; i < end; ++i)
+    {
+        WriteEntitySprite(job->context,
+                          snapshot->dirtyList[i],
+                          &snapshot->dirtyVertices[i * 4]);
+    }
+}
+
+// Copies the snapshot's quads into the render side vertex mirror. They
+// stay pending until a frame actually reaches the copy pass.
+internal void
+ApplySnapshot(GameRenderer* renderer, const RenderSnapshot* snapshot)
+{
+    if (snapshot->sequence == renderer->appliedSequence)
+    {
+        return;
+    }
+    renderer->appliedSequence = snapshot->sequence;
+
+    if (snapshot->inputTimestamp != 0)
+    {
+        renderer->pendingInputTimestamp = snapshot->inputTimestamp;
+    }
+
+    renderer->ViewProjection = snapshot->viewProjection;
+    renderer->viewMin = snapshot->viewMin;
+    renderer->viewMax = snapshot->viewMax;
+
+    if (snapshot->visibleList != NULL)
+    {
+        SDL_memcpy(renderer->VisibleList,
+                   snapshot->visibleList,
+                   sizeof(EntityId) * snapshot->visibleCount);
+        renderer->visibleCount = snapshot->visibleCount;
+        renderer->isVisibleListPending = true;
+        renderer->spriteStats.cull = snapshot->cullStats;
+    }
+
+    for (int i = 0; i < snapshot->dirtyCount; ++i)
+    {
+        EntityId entity = snapshot->dirtyList[i];
+        SDL_memcpy(&renderer->SpriteVertices[entity * 4],
+                   &snapshot->dirtyVertices[i * 4],
+                   sizeof(PositionTextureVertex) * 4);
+
+        if (!renderer->isPendingUpload[entity])
+        {
+            renderer->isPendingUpload[entity] = 1;
+            renderer->pendingList[renderer->pendingCount++] = entity;
+        }
+    }
+}
+
+internal void
+UploadDirtySprites(Context* context, SDL_GPUCopyPass* copyPass)
+{
+    GameRenderer* renderer = &context->Renderer;
+    SpriteStats* stats = &renderer->spriteStats;
+
+    stats->dirtySprites = renderer->pendingCount;
+    stats->uploadRanges = 0;
+    stats->uploadedBytes = 0;
+
+    if (renderer->pendingCount == 0)
+    {
+        return;
+    }
+
+    SDL_qsort(renderer->pendingList,
+              renderer->pendingCount,
+              sizeof(EntityId),
+              EntityCompareIds);
+
+    ArenaScope scratch = ArenaBeginScope(&context->scratchArena);
+    SpriteRange* ranges =
+      ArenaPushArray(scratch.arena, SpriteRange, renderer->pendingCount);
+    if (ranges == NULL)
+    {
+        // Stays pending for the next frame
+        ArenaEndScope(scratch);
+        return;
+    }
+
+    int rangeCount = 0;
+    int cursor = 0;
+    while (RendererNextSpriteRange(renderer->pendingList,
+                                   renderer->pendingCount,
+                                   &cursor,
+                                   &ranges[rangeCount]))
+    {
+        rangeCount += 1;
+    }
+
+    // Pack the dirty ranges back to back into the transfer buffer. Cycling
+    // keeps us from overwriting data a frame in flight is still reading.
+    PositionTextureVertex* transferData =
+      static_cast<PositionTextureVertex*>(SDL_MapGPUTransferBuffer(
+        renderer->Device, renderer->SpriteTransferBuffer, true));
+
+    Uint32 transferOffset = 0;
+    for (int i = 0; i < rangeCount; ++i)
+    {
+        Uint32 vertexCount = (ranges[i].last - ranges[i].first + 1) * 4;
+        SDL_memcpy(&transferData[transferOffset],
+                   &renderer->SpriteVertices[ranges[i].first * 4],
+                   sizeof(PositionTextureVertex) * vertexCount);
+        transferOffset += vertexCount;
+    }
+
+    SDL_UnmapGPUTransferBuffer(renderer->Device,
+                               renderer->SpriteTransferBuffer);
+
+    transferOffset = 0;
+    for (int i = 0; i < rangeCount; ++i)
+    {
+        EntityId first = ranges[i].first;
+        Uint32 vertexCount = (ranges[i].last - first + 1) * 4;
+
+        SDL_GPUTransferBufferLocation transferLocation = {
+            .transfer_buffer = renderer->SpriteTransferBuffer,
+            .offset = static_cast<Uint32>(sizeof(PositionTextureVertex) *
+                                          transferOffset),
+        };
+        SDL_GPUBufferRegion vertexBufferRegion = {
+            .buffer = renderer->VertexBuffer,
+            .offset = static_cast<Uint32>(sizeof(PositionTextureVertex) *
+                                          first * 4),
+            .size = static_cast<Uint32>(sizeof(PositionTextureVertex) *
+                                        vertexCount),
+        };
+        SDL_UploadToGPUBuffer(
+          copyPass, &transferLocation, &vertexBufferRegion, false);
+
+        transferOffset += vertexCount;
+        stats->uploadRanges += 1;
+        stats->uploadedBytes += vertexBufferRegion.size;
+    }
+
+    ArenaEndScope(scratch);
+
+    for (int i = 0; i < renderer->pendingCount; ++i)
+    {
+        renderer->isPendingUpload[renderer->pendingList[i]] = 0;
+    }
+    renderer->pendingCount = 0;
+}
+
+// Six indices per visible sprite, in list order
+internal void
+UploadVisibleIndices(Context* context, SDL_GPUCopyPass* copyPass)
+{
+    GameRenderer* renderer = &context->Renderer;
+    if (!renderer->isVisibleListPending)
+    {
+        return;
+    }
+    renderer->isVisibleListPending = false;
+
+    if (renderer->visibleCount == 0)
+    {
+        return;
+    }
+
+    Uint32* indices = static_cast<Uint32*>(SDL_MapGPUTransferBuffer(
+      renderer->Device, renderer->VisibleTransferBuffer, true));
+    for (int i = 0; i < renderer->visibleCount; ++i)
+    {
+        Uint32 vertex = renderer->VisibleList[i] * 4;
+        indices[i * 6 + 0] = vertex + 0;
+        indices[i * 6 + 1] = vertex + 1;
+        indices[i * 6 + 2] = vertex + 2;
+        indices[i * 6 + 3] = vertex + 0;
+        indices[i * 6 + 4] = vertex + 2;
+        indices[i * 6 + 5] = vertex + 3;
+    }
+    SDL_UnmapGPUTransferBuffer(renderer->Device,
+                               renderer->VisibleTransferBuffer);
+
+    SDL_GPUTransferBufferLocation transferLocation = {
+        .transfer_buffer = renderer->VisibleTransferBuffer,
+        .offset = 0,
+    };
+    SDL_GPUBufferRegion indexBufferRegion = {
+        .buffer = renderer->VisibleIndexBuffer,
+        .offset = 0,
+        .size = static_cast<Uint32>(sizeof(Uint32) * 6 *
+                                    renderer->visibleCount),
+    };
+    SDL_UploadToGPUBuffer(
+      copyPass, &transferLocation, &indexBufferRegion, false);
+    renderer->spriteStats.uploadedBytes += indexBufferRegion.size;
+}
+
+// Refiles the entities that moved, then collects the ones overlapping the
+// view. Runs on the simulation side, before the dirty list is cleared.
+internal void
+CullSprites(Context* context, RenderSnapshot* snapshot)
+{
+    PROFILE_FUNCTION();
+    EntityTable* entities = &context->entities;
+    SpatialGrid* grid = &context->spatialGrid;
+
+    for (int i = 0; i < entities->dirtyCount; ++i)
+    {
+        EntityId entity = entities->dirtyList[i];
+        glm::vec2 center;
+        glm::vec2 halfExtents;
+        if (GetEntityBounds(context, entity, &center, &halfExtents))
+        {
+            SpatialGridUpdate(grid, entity, center, halfExtents);
+        }
+        else
+        {
+            SpatialGridRemove(grid, entity);
+        }
+    }
+    SpatialGridTruncate(grid, entities->count);
+
+    snapshot->shapeCount = 0;
+    snapshot->visibleList =
+      ArenaPushArray(context->frameArena, EntityId, SDL_max(grid->idEnd, 1));
+    if (snapshot->visibleList == NULL)
+    {
+        snapshot->visibleCount = 0;
+        return;
+    }
+
+    // Sorted, so the sprite batches stay contiguous runs of the list
+    snapshot->visibleCount = SpatialGridQuery(grid,
+                                              snapshot->viewMin,
+                                              snapshot->viewMax,
+                                              snapshot->visibleList,
+                                              &snapshot->cullStats);
+    SDL_qsort(snapshot->visibleList,
+              snapshot->visibleCount,
+              sizeof(EntityId),
+              EntityCompareIds);
+
+    if (!context->shapes.isAvailable)
+    {
+        return;
+    }
+
+    // Balls are drawn as circles by the shape renderer
+    snapshot->shapeList = ArenaPushArray(
+      context->frameArena, EntityId, SDL_max(snapshot->visibleCount, 1));
+    if (snapshot->shapeList == NULL)
+    {
+        return;
+    }
+
+    int spriteCount = 0;
+    for (int i = 0; i < snapshot->visibleCount; ++i)
+    {
+        EntityId entity = snapshot->visibleList[i];
+        if (entities->kind[entity] == ENTITY_KIND_BALL)
+        {
+            snapshot->shapeList[snapshot->shapeCount++] = entity;
+        }
+        else
+        {
+            snapshot->visibleList[spriteCount++] = entity;
+        }
+    }
+    snapshot->visibleCount = spriteCount;
+}
+
+RenderSnapshot*
+RendererBuildSnapshot(Context* context)
+{
+    PROFILE_FUNCTION();
+    GameRenderer* renderer = &context->Renderer;
+    EntityTable* entities = &context->entities;
+
+    RenderSnapshot* snapshot = &renderer->Snapshots[renderer->snapshotIndex];
+    renderer->snapshotIndex = (renderer->snapshotIndex + 1) % 2;
+
+    snapshot->sequence = ++renderer->snapshotSequence;
+    snapshot->frameIndex = context->frameIndex;
+    snapshot->spriteCount = entities->count;
+    snapshot->inputTimestamp = InputTakeTimestamp(&context->input);
+    snapshot->viewProjection = CameraViewProjection(&context->camera);
+    CameraBounds(&context->camera, &snapshot->viewMin, &snapshot->viewMax);
+
+    CullSprites(context, snapshot);
+
+    // The lists live as long as the frame arena they came from, which is
+    // not reset until this snapshot has been rendered
+    int dirtyCount = entities->dirtyCount;
+    snapshot->dirtyList =
+      ArenaPushArray(context->frameArena, EntityId, dirtyCount);
+    snapshot->dirtyVertices = ArenaPushArray(
+      context->frameArena, PositionTextureVertex, dirtyCount * 4);
+    if (snapshot->dirtyList == NULL || snapshot->dirtyVertices == NULL)
+    {
+        // Leave the entities dirty, they go out with the next snapshot
+        snapshot->dirtyCount = 0;
+        return snapshot;
+    }
+
+    // Balls drawn by the shape renderer never use their sprite quad
+    if (context->shapes.isAvailable)
+    {
+        snapshot->dirtyCount = 0;
+        for (int i = 0; i < dirtyCount; ++i)
+        {
+            EntityId entity = entities->dirtyList[i];
+            if (entities->kind[entity] != ENTITY_KIND_BALL)
+            {
+                snapshot->dirtyList[snapshot->dirtyCount++] = entity;
+            }
+        }
+    }
+    else
+    {
+        snapshot->dirtyCount = dirtyCount;
+        SDL_memcpy(snapshot->dirtyList,
+                   entities->dirtyList,
+                   sizeof(EntityId) * entities->dirtyCount);
+    }
+
+    // Each dirty entity owns its own four vertices
+    WriteDirtySpritesJob job = {
+        .context = context,
+        .snapshot = snapshot,
+    };
+    JobsParallelFor(&context->jobs,
+                    WriteDirtySprites,
+                    &job,
+                    snapshot->dirtyCount,
+                    SPRITE_WRITE_MIN_CHUNK,
+                    NULL);
+
+    EntityClearDirty(entities);
+
+    return snapshot;
+}
+
+// Draws quads [first, end) of the bound index buffer with the texture and
+// sampler of a batch
+internal void
+DrawSprites(Context* context,
+            SDL_GPURenderPass* renderPass,
+            const SpriteBatch* batch,
+            int first,
+            int end)
+{
+    GameRenderer* renderer = &context->Renderer;
+    if (end <= first)
+    {
+        return;
+    }
+
+    int samplerIndex = batch->samplerIndex >= 0 ? batch->samplerIndex
+                                                : renderer->CurrentSamplerIndex;
+    SDL_GPUTextureSamplerBinding textureSamplerBinding = {
+        .texture = renderer->SpriteTextures[batch->textureIndex],
+        .sampler = renderer->Samplers[samplerIndex],
+    };
+    SDL_BindGPUFragmentSamplers(renderPass, 0, &textureSamplerBinding, 1);
+
+    SDL_DrawGPUIndexedPrimitives(
+      renderPass, (Uint32)(end - first) * 6, 1, (Uint32)first * 6, 0, 0);
+    renderer->spriteStats.drawCalls += 1;
+    RendererCountDraw(renderer);
+}
+
+// The integer scaled letterbox from RendererResizeWindow, the whole target
+// if the window is smaller than the game
+internal SDL_GPUViewport
+GetGameViewport(Context* context, Uint32 targetWidth, Uint32 targetHeight)
+{
+    int width = GAME_WIDTH * context->scale;
+    int height = GAME_HEIGHT * context->scale;
+    if (context->scale < 1 ||
+        context->offsetX + width > (int)targetWidth ||
+        context->offsetY + height > (int)targetHeight)
+    {
+        return (SDL_GPUViewport){
+            0.0f, 0.0f, (float)targetWidth, (float)targetHeight, 0.0f, 1.0f
+        };
+    }
+
+    return (SDL_GPUViewport){ (float)context->offsetX,
+                              (float)context->offsetY,
+                              (float)width,
+                              (float)height,
+                              0.0f,
+                              1.0f };
+}
+
 int
-RendererRenderFrame(Context* context)
+RendererRenderFrame(Context* context, const RenderSnapshot* snapshot)
 {
+    PROFILE_FUNCTION();
+    if (snapshot != NULL)
+    {
+        ApplySnapshot(&context->Renderer, snapshot);
+    }
+    RenderTargetPoolBeginFrame(&context->Renderer.targetPool);
+    context->Renderer.recordedDrawCalls = 0;
+
     SDL_GPUCommandBuffer* cmdbuf =
       SDL_AcquireGPUCommandBuffer(context->Renderer.Device);
     if (cmdbuf == NULL)
@@ -33,11 +511,13 @@ RendererRenderFrame(Context* context)
         return -1;
     }
 
+    Uint32 swapchainWidth = 0;
+    Uint32 swapchainHeight = 0;
     if (!SDL_AcquireGPUSwapchainTexture(cmdbuf,
                                         context->Renderer.Window,
                                         &context->Renderer.SwapchainTexture,
-                                        NULL,
-                                        NULL))
+                                        &swapchainWidth,
+                                        &swapchainHeight))
 
     {
         SDL_Log("AcquireGPUSwapchainTexture failed: %s", SDL_GetError());
@@ -46,106 +526,175 @@ RendererRenderFrame(Context* context)
 
     if (context->Renderer.SwapchainTexture != NULL)
     {
+        // With post effects or dynamic resolution the world goes offscreen
+        // at the internal resolution first
+        Uint32 sceneWidth = 0;
+        Uint32 sceneHeight = 0;
+        DynamicResolutionGetSize(context, &sceneWidth, &sceneHeight);
+
+        SDL_GPUTexture* sceneTarget = NULL;
+        if (PostIsActive(context) || DynamicResolutionIsActive(context))
+        {
+            const RenderTargetDesc sceneDesc = {
+                .width = sceneWidth,
+                .height = sceneHeight,
+                .format = SDL_GetGPUSwapchainTextureFormat(
+                  context->Renderer.Device, context->Renderer.Window),
+                .usage = SDL_GPU_TEXTUREUSAGE_COLOR_TARGET |
+                         SDL_GPU_TEXTUREUSAGE_SAMPLER,
+            };
+            sceneTarget = RenderTargetPoolAcquire(
+              &context->Renderer.targetPool, &sceneDesc);
+        }
+
         SDL_GPUColorTargetInfo colorTargetInfo = { 0 };
-        colorTargetInfo.texture = context->Renderer.SwapchainTexture;
+        colorTargetInfo.texture = sceneTarget != NULL
+                                    ? sceneTarget
+                                    : context->Renderer.SwapchainTexture;
+        context->Renderer.renderWidth =
+          sceneTarget != NULL ? sceneWidth : swapchainWidth;
+        context->Renderer.renderHeight =
+          sceneTarget != NULL ? sceneHeight : swapchainHeight;
         colorTargetInfo.clear_color = (SDL_FColor){ 0.1f, 0.0f, 0.1f, 1.0f };
         colorTargetInfo.load_op = SDL_GPU_LOADOP_CLEAR;
         colorTargetInfo.store_op = SDL_GPU_STOREOP_STORE;
 
-        // Update the texture coordinates of the texture quad to the ball's
-        // position
+        // Upload only the sprites that changed
         {
-            PositionTextureVertex transferData[4];
-
-            // Calculate normalized position of the ball (center of the ball)
-            float left = (context->ball.position.x - context->ball.radius) /
-                           (float)GAME_WIDTH * 2.0f -
-                         1.0f;
-            float right = (context->ball.position.x + context->ball.radius) /
-                            (float)GAME_WIDTH * 2.0f -
-                          1.0f;
-            float top = (context->ball.position.y - context->ball.radius) /
-                          (float)GAME_HEIGHT * 2.0f -
-                        1.0f;
-            float bottom = (context->ball.position.y + context->ball.radius) /
-                             (float)GAME_HEIGHT * 2.0f -
-                           1.0f;
-
-            // Update the vertices to form a rectangle with the ball's position
-            // and radius
-            transferData[0] =
-              (PositionTextureVertex){ left, top, 0, 0, 0 }; // Top-left corner
-            transferData[1] = (PositionTextureVertex){
-                right, top, 0, 1, 0
-            }; // Top-right corner
-            transferData[2] = (PositionTextureVertex){
-                right, bottom, 0, 1, 1
-            }; // Bottom-right corner
-            transferData[3] = (PositionTextureVertex){
-                left, bottom, 0, 0, 1
-            }; // Bottom-left corner
-
-            SDL_GPUTransferBufferCreateInfo bufferTransferBufferCreateInfo = {
-                .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-                .size = sizeof(PositionTextureVertex) * 4
-            };
-            SDL_GPUTransferBuffer* bufferTransferBuffer =
-              SDL_CreateGPUTransferBuffer(context->Renderer.Device,
-                                          &bufferTransferBufferCreateInfo);
-
-            PositionTextureVertex* transferDataPtr =
-              static_cast<PositionTextureVertex*>(SDL_MapGPUTransferBuffer(
-                context->Renderer.Device, bufferTransferBuffer, false));
-
-            SDL_memcpy(transferDataPtr, transferData, sizeof(transferData));
-            SDL_GPUTransferBufferLocation vertexBufferLocation = {
-                .transfer_buffer = bufferTransferBuffer, .offset = 0
-            };
-            SDL_GPUBufferRegion vertexBufferRegion = {
-                .buffer = context->Renderer.VertexBuffer,
-                .offset = 0,
-                .size = sizeof(PositionTextureVertex) * 4
-            };
-
-            // Create a copy pass
+            PROFILE_ZONE("CopyPass");
             SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(cmdbuf);
-
-            // Upload the updated vertex data to the GPU
-            SDL_UploadToGPUBuffer(
-              copyPass, &vertexBufferLocation, &vertexBufferRegion, false);
-
-            SDL_UnmapGPUTransferBuffer(context->Renderer.Device,
-                                       bufferTransferBuffer);
+            UploadDirtySprites(context, copyPass);
+            UploadVisibleIndices(context, copyPass);
+            TilemapUpload(context, copyPass);
+            ShapesUpload(context, copyPass);
+            FontUpload(context, copyPass);
+            PerfHudUpload(context, copyPass);
+            ParticlesUpload(context, copyPass);
+            DebugDrawUpload(context, copyPass);
             SDL_EndGPUCopyPass(copyPass);
         }
 
+        GpuParticlesDispatch(context, cmdbuf);
+
         SDL_GPURenderPass* renderPass =
           SDL_BeginGPURenderPass(cmdbuf, &colorTargetInfo, 1, NULL);
 
+        SDL_PushGPUVertexUniformData(cmdbuf,
+                                     RENDERER_CAMERA_UNIFORM_SLOT,
+                                     &context->Renderer.ViewProjection,
+                                     sizeof(glm::mat4));
+
         SDL_BindGPUGraphicsPipeline(renderPass, context->Renderer.Pipeline);
 
+        SDL_GPUBufferBinding indexBufferBinding = {
+            .buffer = context->Renderer.IndexBuffer,
+            .offset = 0,
+        };
+        SDL_BindGPUIndexBuffer(
+          renderPass, &indexBufferBinding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+
+        // Background first, it brings its own vertex buffer
+        TilemapRender(context, renderPass);
+
         SDL_GPUBufferBinding vertexBufferBinding = {
             .buffer = context->Renderer.VertexBuffer,
             .offset = 0,
         };
         SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
 
-        SDL_GPUBufferBinding indexBufferBinding = {
-            .buffer = context->Renderer.IndexBuffer,
+        SDL_GPUBufferBinding visibleIndexBufferBinding = {
+            .buffer = context->Renderer.VisibleIndexBuffer,
             .offset = 0,
         };
+        SDL_BindGPUIndexBuffer(renderPass,
+                               &visibleIndexBufferBinding,
+                               SDL_GPU_INDEXELEMENTSIZE_32BIT);
+
+        const EntityId* visibleList = context->Renderer.VisibleList;
+        int visibleCount = context->Renderer.visibleCount;
+        const SpriteBatch defaultBatch = { 0, 0, 0, -1 };
+        context->Renderer.spriteStats.drawCalls = 0;
+
+        // Batches in slot order over the sorted visible list, the sprites
+        // between them in default draws
+        int cursor = 0;
+        for (int i = 0; i < context->Renderer.spriteBatchCount; ++i)
+        {
+            const SpriteBatch* batch = &context->Renderer.SpriteBatches[i];
+            EntityId end = batch->first + (EntityId)batch->count;
+
+            int first = cursor;
+            while (cursor < visibleCount && visibleList[cursor] < batch->first)
+            {
+                cursor += 1;
+            }
+            DrawSprites(context, renderPass, &defaultBatch, first, cursor);
+
+            first = cursor;
+            while (cursor < visibleCount && visibleList[cursor] < end)
+            {
+                cursor += 1;
+            }
+            DrawSprites(context, renderPass, batch, first, cursor);
+        }
+        DrawSprites(
+          context, renderPass, &defaultBatch, cursor, visibleCount);
+
+        // CPU particles sit in the slots after the entities, drawn through
+        // the static index buffer
         SDL_BindGPUIndexBuffer(
-          renderPass, &indexBufferBinding, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+          renderPass, &indexBufferBinding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+        int particleCount = context->particles.drawCount;
+        DrawSprites(context,
+                    renderPass,
+                    &defaultBatch,
+                    MAX_SPRITES,
+                    MAX_SPRITES + particleCount);
 
-        SDL_GPUTextureSamplerBinding textureSamplerBinding = {
-            .texture = context->Renderer.ColorTexture,
-            .sampler =
-              context->Renderer.Samplers[context->Renderer.CurrentSamplerIndex]
-        };
-        SDL_BindGPUFragmentSamplers(renderPass, 0, &textureSamplerBinding, 1);
+        context->Renderer.spriteStats.drawnSprites = visibleCount;
+
+        ShapesRender(context, cmdbuf, renderPass);
+        GpuParticlesRender(context, cmdbuf, renderPass);
+        DebugDrawRender(context, renderPass);
+
+        if (sceneTarget != NULL)
+        {
+            SDL_EndGPURenderPass(renderPass);
+            SDL_GPUTexture* image = PostRender(
+              context, cmdbuf, sceneTarget, sceneWidth, sceneHeight);
+
+            SDL_GPUColorTargetInfo swapchainTargetInfo = { 0 };
+            swapchainTargetInfo.texture = context->Renderer.SwapchainTexture;
+            swapchainTargetInfo.clear_color =
+              (SDL_FColor){ 0.0f, 0.0f, 0.0f, 1.0f };
+            swapchainTargetInfo.load_op = SDL_GPU_LOADOP_CLEAR;
+            swapchainTargetInfo.store_op = SDL_GPU_STOREOP_STORE;
+            renderPass =
+              SDL_BeginGPURenderPass(cmdbuf, &swapchainTargetInfo, 1, NULL);
+
+            // The overlays share the letterbox
+            SDL_GPUViewport viewport =
+              GetGameViewport(context, swapchainWidth, swapchainHeight);
+            SDL_SetGPUViewport(renderPass, &viewport);
+
+            // Filtered unless every image pixel covers whole window pixels
+            bool isFiltered = SDL_fmodf(viewport.w, (float)sceneWidth) != 0.0f;
+            PostUpscale(context, renderPass, image, isFiltered);
+        }
 
-        SDL_DrawGPUIndexedPrimitives(renderPass, 6, 1, 0, 0, 0);
-        // SDL_DrawGPUPrimitives(renderPass, 6, 1, 0, 0);
+        // Overlays last, over everything, in screen pixels with the origin
+        // at the top left
+        glm::mat4 screenProjection = glm::mat4(1.0f);
+        screenProjection[0][0] = 2.0f / GAME_WIDTH;
+        screenProjection[1][1] = -2.0f / GAME_HEIGHT;
+        screenProjection[3][0] = -1.0f;
+        screenProjection[3][1] = 1.0f;
+        SDL_PushGPUVertexUniformData(cmdbuf,
+                                     RENDERER_CAMERA_UNIFORM_SLOT,
+                                     &screenProjection,
+                                     sizeof(glm::mat4));
+        PerfHudRender(context, renderPass);
+        FontRender(context, renderPass);
 
         SDL_EndGPURenderPass(renderPass);
     }
@@ -155,7 +704,76 @@ RendererRenderFrame(Context* context)
         return -1;
     }
 
-    SDL_SubmitGPUCommandBuffer(cmdbuf);
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmdbuf);
+    context->Renderer.drawCalls = context->Renderer.recordedDrawCalls;
+    RenderTargetPoolEndFrame(&context->Renderer.targetPool, fence);
+
+    if (context->Renderer.pendingInputTimestamp != 0)
+    {
+        InputRecordLatency(&context->input,
+                           context->Renderer.PresentMode,
+                           context->Renderer.pendingInputTimestamp);
+        context->Renderer.pendingInputTimestamp = 0;
+    }
+
+    return 0;
+}
+
+int
+RendererSetSpriteBatches(Context* context,
+                         const SpriteBatch* batches,
+                         int batchCount)
+{
+    GameRenderer* renderer = &context->Renderer;
+    if (batchCount > RENDERER_MAX_SPRITE_BATCHES)
+    {
+        SDL_Log("Too many sprite batches: %d", batchCount);
+        return -1;
+    }
+
+    EntityId end = 0;
+    for (int i = 0; i < batchCount; ++i)
+    {
+        const SpriteBatch* batch = &batches[i];
+        if (batch->first < end || batch->count < 0 ||
+            batch->textureIndex < 0 ||
+            batch->textureIndex >= renderer->spriteTextureCount ||
+            batch->samplerIndex >= (int)NumSamplers)
+        {
+            SDL_Log("Invalid sprite batch %d", i);
+            return -1;
+        }
+        end = batch->first + batch->count;
+    }
+
+    SDL_memcpy(
+      renderer->SpriteBatches, batches, sizeof(SpriteBatch) * batchCount);
+    renderer->spriteBatchCount = batchCount;
+
+    return 0;
+}
+
+int
+RendererSetPresentMode(Context* context, SDL_GPUPresentMode presentMode)
+{
+    GameRenderer* renderer = &context->Renderer;
+    if (!SDL_WindowSupportsGPUPresentMode(
+          renderer->Device, renderer->Window, presentMode))
+    {
+        return -1;
+    }
+
+    if (!SDL_SetGPUSwapchainParameters(renderer->Device,
+                                       renderer->Window,
+                                       SDL_GPU_SWAPCHAINCOMPOSITION_SDR,
+                                       presentMode))
+    {
+        SDL_Log("SetGPUSwapchainParameters failed: %s", SDL_GetError());
+        return -1;
+    }
+
+    renderer->PresentMode = presentMode;
+    SDL_Log("Present mode: %s", PresentModeNames[presentMode]);
 
     return 0;
 }
@@ -163,33 +781,54 @@ RendererRenderFrame(Context* context)
 SDL_GPUTransferBuffer*
 RendererCreateTransferBuffers(Context* context)
 {
-    // Set up buffer data
+    PROFILE_FUNCTION();
+    const Uint32 slotCount =
+      RendererTextFirstSlot(&context->Renderer) + RENDERER_TEXT_SLOTS;
+    const Uint32 vertexDataSize =
+      sizeof(PositionTextureVertex) * MAX_SPRITES * 4;
+    const Uint32 indexDataSize = sizeof(Uint32) * slotCount * 6;
+
+    // Set up buffer data: every sprite slot starts out as a degenerate quad
     SDL_GPUTransferBufferCreateInfo bufferTransferBufferCreateInfo = {
         .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-        .size = 1024 * 1024 * 4,
+        .size = vertexDataSize + indexDataSize,
     };
     SDL_GPUTransferBuffer* bufferTransferBuffer = SDL_CreateGPUTransferBuffer(
       context->Renderer.Device, &bufferTransferBufferCreateInfo);
 
-    PositionTextureVertex* transferData =
-      static_cast<PositionTextureVertex*>(SDL_MapGPUTransferBuffer(
-        context->Renderer.Device, bufferTransferBuffer, false));
+    Uint8* bufferData = static_cast<Uint8*>(SDL_MapGPUTransferBuffer(
+      context->Renderer.Device, bufferTransferBuffer, false));
 
-    transferData[0] = (PositionTextureVertex){ -1, 1, 0, 0, 0 };
-    transferData[1] = (PositionTextureVertex){ 1, 1, 0, 4, 0 };
-    transferData[2] = (PositionTextureVertex){ 1, -1, 0, 4, 4 };
-    transferData[3] = (PositionTextureVertex){ -1, -1, 0, 0, 4 };
+    SDL_memset(bufferData, 0, vertexDataSize);
 
-    Uint16* indexData = (Uint16*)&transferData[4];
-    indexData[0] = 0;
-    indexData[1] = 1;
-    indexData[2] = 2;
-    indexData[3] = 0;
-    indexData[4] = 2;
-    indexData[5] = 3;
+    Uint32* indexData = (Uint32*)(bufferData + vertexDataSize);
+    for (Uint32 sprite = 0; sprite < slotCount; ++sprite)
+    {
+        indexData[sprite * 6 + 0] = sprite * 4 + 0;
+        indexData[sprite * 6 + 1] = sprite * 4 + 1;
+        indexData[sprite * 6 + 2] = sprite * 4 + 2;
+        indexData[sprite * 6 + 3] = sprite * 4 + 0;
+        indexData[sprite * 6 + 4] = sprite * 4 + 2;
+        indexData[sprite * 6 + 5] = sprite * 4 + 3;
+    }
 
     SDL_UnmapGPUTransferBuffer(context->Renderer.Device, bufferTransferBuffer);
 
+    // Persistent upload buffer for the per frame sprite updates
+    SDL_GPUTransferBufferCreateInfo spriteTransferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = vertexDataSize,
+    };
+    context->Renderer.SpriteTransferBuffer = SDL_CreateGPUTransferBuffer(
+      context->Renderer.Device, &spriteTransferBufferCreateInfo);
+
+    SDL_GPUTransferBufferCreateInfo visibleTransferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = static_cast<Uint32>(sizeof(Uint32) * MAX_SPRITES * 6),
+    };
+    context->Renderer.VisibleTransferBuffer = SDL_CreateGPUTransferBuffer(
+      context->Renderer.Device, &visibleTransferBufferCreateInfo);
+
     // Set up texture data
     SDL_GPUTransferBufferCreateInfo textureTransferBufferCreateInfo = {
         .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
@@ -216,6 +855,12 @@ RendererCreateTransferBuffers(Context* context)
     context->Renderer.copyPass =
       SDL_BeginGPUCopyPass(context->Renderer.uploadCmdBuf);
 
+    if (context->Renderer.copyPass == NULL)
+    {
+        SDL_Log("Failed to begin GPU copy pass: %s", SDL_GetError());
+        return NULL;
+    }
+
     context->Renderer.vertexBufferLocation = {
         .transfer_buffer = bufferTransferBuffer,
         .offset = 0,
@@ -223,7 +868,7 @@ RendererCreateTransferBuffers(Context* context)
     SDL_GPUBufferRegion vertexBufferRegion = {
         .buffer = context->Renderer.VertexBuffer,
         .offset = 0,
-        .size = sizeof(PositionTextureVertex) * 4
+        .size = vertexDataSize,
     };
     SDL_UploadToGPUBuffer(context->Renderer.copyPass,
                           &context->Renderer.vertexBufferLocation,
@@ -232,12 +877,12 @@ RendererCreateTransferBuffers(Context* context)
 
     SDL_GPUTransferBufferLocation indexBufferLocation = {
         .transfer_buffer = bufferTransferBuffer,
-        .offset = sizeof(PositionTextureVertex) * 4
+        .offset = vertexDataSize,
     };
     SDL_GPUBufferRegion indexBufferRegion = {
         .buffer = context->Renderer.IndexBuffer,
         .offset = 0,
-        .size = sizeof(Uint16) * 6,
+        .size = indexDataSize,
     };
     SDL_UploadToGPUBuffer(context->Renderer.copyPass,
                           &indexBufferLocation,
@@ -255,50 +900,69 @@ RendererCreateTransferBuffers(Context* context)
         .d = 1,
     };
 
-    printf("Texture dimensions 1: %d x %d\n",
+    printf("Texture dimensions: %d x %d\n",
            context->Renderer.imageData->w,
            context->Renderer.imageData->h);
 
-    SDL_UploadToGPUTexture(
-      context->Renderer.copyPass, &textureTransferInfo, &textureRegion, false);
+    // Every sprite texture gets the same image
+    for (int i = 0; i < context->Renderer.spriteTextureCount; ++i)
+    {
+        textureRegion.texture = context->Renderer.SpriteTextures[i];
+        SDL_UploadToGPUTexture(context->Renderer.copyPass,
+                               &textureTransferInfo,
+                               &textureRegion,
+                               false);
+    }
 
     SDL_EndGPUCopyPass(context->Renderer.copyPass);
     SDL_SubmitGPUCommandBuffer(context->Renderer.uploadCmdBuf);
 
-    // @Note(Victor): This causes three Vulkan errors, however without it the
-    // ColorTexture is not displayed
+    // Released once the upload has finished on the GPU
+    SDL_ReleaseGPUTransferBuffer(context->Renderer.Device,
+                                 bufferTransferBuffer);
+
     SDL_DestroySurface(context->Renderer.imageData);
+    context->Renderer.imageData = NULL;
 
-    return bufferTransferBuffer;
+    return context->Renderer.SpriteTransferBuffer;
 }
 
 SDL_GPUTransferBuffer*
 RendererCreateTexture(Context* context)
 {
-    // Create the GPU resources
+    // Create the GPU resources, the particle and then the text slots follow
+    // the entities
+    const Uint32 slotCount =
+      RendererTextFirstSlot(&context->Renderer) + RENDERER_TEXT_SLOTS;
     SDL_GPUBufferCreateInfo vertexBufferCreateInfo = {
         .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
-        .size = sizeof(PositionTextureVertex) * 4
+        .size =
+          static_cast<Uint32>(sizeof(PositionTextureVertex) * slotCount * 4)
     };
 
-    context->Renderer.uploadCmdBuf =
-      SDL_AcquireGPUCommandBuffer(context->Renderer.Device);
-
-    context->Renderer.copyPass =
-      SDL_BeginGPUCopyPass(context->Renderer.uploadCmdBuf);
-
     context->Renderer.VertexBuffer =
       SDL_CreateGPUBuffer(context->Renderer.Device, &vertexBufferCreateInfo);
     SDL_SetGPUBufferName(context->Renderer.Device,
                          context->Renderer.VertexBuffer,
-                         "TestImage Vertex Buffer");
+                         "Sprite Vertex Buffer");
 
     SDL_GPUBufferCreateInfo indexBufferCreateInfo = {
-        .usage = SDL_GPU_BUFFERUSAGE_INDEX, .size = sizeof(Uint16) * 6
+        .usage = SDL_GPU_BUFFERUSAGE_INDEX,
+        .size = static_cast<Uint32>(sizeof(Uint32) * slotCount * 6)
     };
     context->Renderer.IndexBuffer =
       SDL_CreateGPUBuffer(context->Renderer.Device, &indexBufferCreateInfo);
 
+    SDL_GPUBufferCreateInfo visibleIndexBufferCreateInfo = {
+        .usage = SDL_GPU_BUFFERUSAGE_INDEX,
+        .size = static_cast<Uint32>(sizeof(Uint32) * MAX_SPRITES * 6)
+    };
+    context->Renderer.VisibleIndexBuffer = SDL_CreateGPUBuffer(
+      context->Renderer.Device, &visibleIndexBufferCreateInfo);
+    SDL_SetGPUBufferName(context->Renderer.Device,
+                         context->Renderer.VisibleIndexBuffer,
+                         "Visible Sprite Index Buffer");
+
     SDL_GPUTextureCreateInfo textureCreateInfo = {
         .type = SDL_GPU_TEXTURETYPE_2D,
         .format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
@@ -315,72 +979,25 @@ RendererCreateTexture(Context* context)
                           context->Renderer.ColorTexture,
                           "TestImage ColorTexture");
 
-    SDL_GPUTransferBuffer* transferBuffer =
-      RendererCreateTransferBuffers(context);
-
-    SDL_GPUCommandBuffer* uploadCmdBuf =
-      SDL_AcquireGPUCommandBuffer(context->Renderer.Device);
-    context->Renderer.copyPass = SDL_BeginGPUCopyPass(uploadCmdBuf);
-
-    if (context->Renderer.copyPass == NULL)
+    GameRenderer* renderer = &context->Renderer;
+    renderer->spriteTextureCount =
+      SDL_clamp(renderer->spriteTextureCount, 1, RENDERER_MAX_TEXTURES);
+    renderer->SpriteTextures[0] = renderer->ColorTexture;
+    for (int i = 1; i < renderer->spriteTextureCount; ++i)
     {
-        SDL_Log("Failed to begin GPU copy pass: %s", SDL_GetError());
-        return NULL;
+        renderer->SpriteTextures[i] =
+          SDL_CreateGPUTexture(renderer->Device, &textureCreateInfo);
+        if (renderer->SpriteTextures[i] == NULL)
+        {
+            SDL_Log("Failed to create sprite texture %d: %s",
+                    i,
+                    SDL_GetError());
+            renderer->spriteTextureCount = i;
+            break;
+        }
     }
 
-    SDL_GPUTransferBufferLocation vertexBufferLocation = { .transfer_buffer =
-                                                             transferBuffer,
-                                                           .offset = 0 };
-    SDL_GPUBufferRegion vertexBufferRegion = {
-        .buffer = context->Renderer.VertexBuffer,
-        .offset = 0,
-        .size = sizeof(PositionTextureVertex) * 4
-    };
-    SDL_UploadToGPUBuffer(context->Renderer.copyPass,
-                          &vertexBufferLocation,
-                          &vertexBufferRegion,
-                          false);
-
-    SDL_GPUTransferBufferLocation indexBufferLocation = {
-        .transfer_buffer = transferBuffer,
-        .offset = sizeof(PositionTextureVertex) * 4
-    };
-    SDL_GPUBufferRegion indexBufferRegion = {
-        .buffer = context->Renderer.IndexBuffer,
-        .offset = 0,
-        .size = sizeof(Uint16) * 6,
-    };
-    SDL_UploadToGPUBuffer(context->Renderer.copyPass,
-                          &indexBufferLocation,
-                          &indexBufferRegion,
-                          false);
-
-    SDL_GPUTextureTransferInfo textureTransferInfo = {
-        .transfer_buffer = transferBuffer,
-        .offset = 0,
-    };
-    SDL_GPUTextureRegion textureRegion = {
-        .texture = context->Renderer.ColorTexture,
-        .x = 0,
-        .y = 0,
-        .z = 0,
-        .w = static_cast<Uint32>(context->Renderer.imageData->w),
-        .h = static_cast<Uint32>(context->Renderer.imageData->h),
-        .d = 1,
-    };
-
-    printf("Texture dimensions 2: %d x %d\n",
-           context->Renderer.imageData->w,
-           context->Renderer.imageData->h);
-
-    SDL_UploadToGPUTexture(
-      context->Renderer.copyPass, &textureTransferInfo, &textureRegion, false);
-
-    SDL_EndGPUCopyPass(context->Renderer.copyPass);
-    SDL_SubmitGPUCommandBuffer(uploadCmdBuf);
-    SDL_DestroySurface(context->Renderer.imageData);
-
-    return transferBuffer;
+    return RendererCreateTransferBuffers(context);
 }
 
 int
@@ -505,38 +1122,23 @@ RendererInitSDL(Context* context, SDL_WindowFlags windowFlags)
         return -1;
     }
 
+    RenderTargetPoolInit(&context->Renderer.targetPool,
+                         context->Renderer.Device);
+
     return 0;
 }
 
-internal SDL_GPUShader*
-LoadShader(Context* context,
-           SDL_GPUDevice* device,
-           const char* shaderFilename,
-           Uint32 samplerCount,
-           Uint32 uniformBufferCount,
-           Uint32 storageBufferCount,
-           Uint32 storageTextureCount)
+// Loads the compiled shader for the first format the backend supports
+internal void*
+LoadShaderCode(Context* context,
+               SDL_GPUDevice* device,
+               const char* shaderFilename,
+               SDL_GPUShaderFormat* format,
+               const char** entrypoint,
+               size_t* codeSize)
 {
-    // Auto-detect the shader stage from the file name for convenience
-    SDL_GPUShaderStage stage;
-    if (SDL_strstr(shaderFilename, ".vert"))
-    {
-        stage = SDL_GPU_SHADERSTAGE_VERTEX;
-    }
-    else if (SDL_strstr(shaderFilename, ".frag"))
-    {
-        stage = SDL_GPU_SHADERSTAGE_FRAGMENT;
-    }
-    else
-    {
-        SDL_Log("Invalid shader stage!");
-        return NULL;
-    }
-
     char fullPath[256];
     SDL_GPUShaderFormat backendFormats = SDL_GetGPUShaderFormats(device);
-    SDL_GPUShaderFormat format = SDL_GPU_SHADERFORMAT_INVALID;
-    const char* entrypoint;
 
     if (backendFormats & SDL_GPU_SHADERFORMAT_SPIRV)
     {
@@ -545,8 +1147,8 @@ LoadShader(Context* context,
                      "%sshaders/compiled/SPIRV/%s.spv",
                      context->BasePath,
                      shaderFilename);
-        format = SDL_GPU_SHADERFORMAT_SPIRV;
-        entrypoint = "main";
+        *format = SDL_GPU_SHADERFORMAT_SPIRV;
+        *entrypoint = "main";
     }
     else if (backendFormats & SDL_GPU_SHADERFORMAT_MSL)
     {
@@ -555,8 +1157,8 @@ LoadShader(Context* context,
                      "%sshaders/compiled/MSL/%s.msl",
                      context->BasePath,
                      shaderFilename);
-        format = SDL_GPU_SHADERFORMAT_MSL;
-        entrypoint = "main0";
+        *format = SDL_GPU_SHADERFORMAT_MSL;
+        *entrypoint = "main0";
     }
     else if (backendFormats & SDL_GPU_SHADERFORMAT_DXIL)
     {
@@ -565,8 +1167,8 @@ LoadShader(Context* context,
                      "%sshaders/compiled/DXIL/%s.dxil",
                      context->BasePath,
                      shaderFilename);
-        format = SDL_GPU_SHADERFORMAT_DXIL;
-        entrypoint = "main";
+        *format = SDL_GPU_SHADERFORMAT_DXIL;
+        *entrypoint = "main";
     }
     else
     {
@@ -574,14 +1176,52 @@ LoadShader(Context* context,
         return NULL;
     }
 
-    size_t codeSize;
-    void* code = SDL_LoadFile(fullPath, &codeSize);
+    void* code = SDL_LoadFile(fullPath, codeSize);
     if (code == NULL)
     {
         SDL_Log("Failed to load shader from disk! %s", fullPath);
         return NULL;
     }
 
+    return code;
+}
+
+SDL_GPUShader*
+RendererLoadShader(Context* context,
+                   SDL_GPUDevice* device,
+                   const char* shaderFilename,
+                   Uint32 samplerCount,
+                   Uint32 uniformBufferCount,
+                   Uint32 storageBufferCount,
+                   Uint32 storageTextureCount)
+{
+    // Auto-detect the shader stage from the file name for convenience
+    PROFILE_FUNCTION();
+    SDL_GPUShaderStage stage;
+    if (SDL_strstr(shaderFilename, ".vert"))
+    {
+        stage = SDL_GPU_SHADERSTAGE_VERTEX;
+    }
+    else if (SDL_strstr(shaderFilename, ".frag"))
+    {
+        stage = SDL_GPU_SHADERSTAGE_FRAGMENT;
+    }
+    else
+    {
+        SDL_Log("Invalid shader stage!");
+        return NULL;
+    }
+
+    SDL_GPUShaderFormat format = SDL_GPU_SHADERFORMAT_INVALID;
+    const char* entrypoint;
+    size_t codeSize;
+    void* code = LoadShaderCode(
+      context, device, shaderFilename, &format, &entrypoint, &codeSize);
+    if (code == NULL)
+    {
+        return NULL;
+    }
+
     SDL_GPUShaderCreateInfo shaderInfo = {
         .code_size = codeSize,
         .code = static_cast<const Uint8*>(code),
@@ -606,19 +1246,52 @@ LoadShader(Context* context,
     return shader;
 }
 
+SDL_GPUComputePipeline*
+RendererLoadComputePipeline(Context* context,
+                            SDL_GPUDevice* device,
+                            const char* shaderFilename,
+                            const SDL_GPUComputePipelineCreateInfo* createInfo)
+{
+    PROFILE_FUNCTION();
+    SDL_GPUComputePipelineCreateInfo pipelineInfo = *createInfo;
+    size_t codeSize;
+    void* code = LoadShaderCode(context,
+                                device,
+                                shaderFilename,
+                                &pipelineInfo.format,
+                                &pipelineInfo.entrypoint,
+                                &codeSize);
+    if (code == NULL)
+    {
+        return NULL;
+    }
+    pipelineInfo.code = static_cast<const Uint8*>(code);
+    pipelineInfo.code_size = codeSize;
+
+    SDL_GPUComputePipeline* pipeline =
+      SDL_CreateGPUComputePipeline(device, &pipelineInfo);
+    if (pipeline == NULL)
+    {
+        SDL_Log("Failed to create compute pipeline! %s", SDL_GetError());
+    }
+
+    SDL_free(code);
+    return pipeline;
+}
+
 int
 RendererInitShaders(Context* context)
 {
     // Create the shaders
-    context->Renderer.vertexShader = LoadShader(
-      context, context->Renderer.Device, "TexturedQuad.vert", 0, 0, 0, 0);
+    context->Renderer.vertexShader = RendererLoadShader(
+      context, context->Renderer.Device, "TexturedQuad.vert", 0, 1, 0, 0);
     if (context->Renderer.vertexShader == NULL)
     {
         SDL_Log("Failed to create vertex shader!");
         return -1;
     }
 
-    context->Renderer.fragmentShader = LoadShader(
+    context->Renderer.fragmentShader = RendererLoadShader(
       context, context->Renderer.Device, "TexturedQuad.frag", 1, 0, 0, 0);
     if (context->Renderer.fragmentShader == NULL)
     {
@@ -719,6 +1392,7 @@ RendererLoadImage(Context* context,
                   const char* imageFilename,
                   int desiredChannels)
 {
+    PROFILE_FUNCTION();
     char fullPath[256];
     SDL_Surface* result;
     SDL_PixelFormat format;
@@ -776,12 +1450,19 @@ RendererResizeWindow(Context* context, int w, int h)
 void
 RendererDestroy(Context* context)
 {
+    RenderTargetPoolDestroy(&context->Renderer.targetPool);
+
     // Release textures
     if (context->Renderer.ColorTexture != nullptr)
     {
         SDL_ReleaseGPUTexture(context->Renderer.Device,
                               context->Renderer.ColorTexture);
     }
+    for (int i = 1; i < context->Renderer.spriteTextureCount; ++i)
+    {
+        SDL_ReleaseGPUTexture(context->Renderer.Device,
+                              context->Renderer.SpriteTextures[i]);
+    }
 
     // Release graphics pipeline
     if (context->Renderer.Pipeline != nullptr)
@@ -803,13 +1484,31 @@ RendererDestroy(Context* context)
                              context->Renderer.IndexBuffer);
     }
 
-    // Release transfer buffer
+    if (context->Renderer.VisibleIndexBuffer != nullptr)
+    {
+        SDL_ReleaseGPUBuffer(context->Renderer.Device,
+                             context->Renderer.VisibleIndexBuffer);
+    }
+
+    // Release transfer buffers
     if (context->Renderer.textureTransferBuffer != nullptr)
     {
         SDL_ReleaseGPUTransferBuffer(context->Renderer.Device,
                                      context->Renderer.textureTransferBuffer);
     }
 
+    if (context->Renderer.SpriteTransferBuffer != nullptr)
+    {
+        SDL_ReleaseGPUTransferBuffer(context->Renderer.Device,
+                                     context->Renderer.SpriteTransferBuffer);
+    }
+
+    if (context->Renderer.VisibleTransferBuffer != nullptr)
+    {
+        SDL_ReleaseGPUTransferBuffer(context->Renderer.Device,
+                                     context->Renderer.VisibleTransferBuffer);
+    }
+
     // Shaders
     if (context->Renderer.vertexShader != nullptr)
     {
@@ -843,7 +1542,7 @@ RendererDestroy(Context* context)
 
     if (context != nullptr)
     {
-        free(context);
+        SDL_free(context);
     }
     else
     {
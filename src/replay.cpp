@@ -0,0 +1,333 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glm/glm.hpp>
+#include <glm/vec2.hpp>
+
+#include <box2d/box2d.h>
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "replay.hpp"
+
+const Uint64 FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+const Uint64 FNV_PRIME = 0x100000001b3ULL;
+
+// -------------------------------------------------------------------------------
+internal Uint64
+HashBytes(Uint64 hash, const void* data, size_t size)
+{
+    const Uint8* bytes = (const Uint8*)data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+// Field by field, Ball has padding and Box2D handles that do not matter
+internal Uint64
+HashSimulation(const Context* context)
+{
+    Uint64 hash = FNV_OFFSET_BASIS;
+    hash = HashBytes(hash, &context->frameIndex, sizeof(context->frameIndex));
+    hash = HashBytes(
+      hash, &context->simulationTime, sizeof(context->simulationTime));
+    hash = HashBytes(hash, &context->random, sizeof(context->random));
+    hash = HashBytes(hash, &context->ballCount, sizeof(context->ballCount));
+
+    for (int i = 0; i < context->ballCount; ++i)
+    {
+        const Ball* ball = &context->balls[i];
+        hash = HashBytes(hash, &ball->position, sizeof(ball->position));
+        hash = HashBytes(hash, &ball->velocity, sizeof(ball->velocity));
+        hash = HashBytes(hash, &ball->bounceCount, sizeof(ball->bounceCount));
+    }
+
+    hash = HashBytes(hash, &context->propCount, sizeof(context->propCount));
+    for (int i = 0; i < context->propCount; ++i)
+    {
+        const Prop* prop = &context->props[i];
+        hash = HashBytes(hash, &prop->position, sizeof(prop->position));
+    }
+
+    return hash;
+}
+
+internal bool
+Write(ReplayState* replay, const void* data, size_t size)
+{
+    if (SDL_WriteIO(replay->file, data, size) != size)
+    {
+        SDL_Log("Replay write failed, recording stopped: %s", SDL_GetError());
+        SDL_CloseIO(replay->file);
+        replay->file = NULL;
+        replay->mode = REPLAY_MODE_OFF;
+        return false;
+    }
+
+    return true;
+}
+
+// Returns a pointer into the loaded log, NULL past the end
+internal const void*
+Read(ReplayState* replay, size_t size)
+{
+    if (replay->dataSize - replay->readOffset < size)
+    {
+        return NULL;
+    }
+
+    const void* result = replay->data + replay->readOffset;
+    replay->readOffset += size;
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
+int
+ReplayStartRecording(ReplayState* replay, const char* path, Uint64 seed)
+{
+    replay->file = SDL_IOFromFile(path, "wb");
+    if (replay->file == NULL)
+    {
+        SDL_Log("Could not create replay %s: %s", path, SDL_GetError());
+        return -1;
+    }
+
+    replay->mode = REPLAY_MODE_RECORD;
+    replay->seed = seed;
+
+    ReplayHeader header = {
+        .magic = REPLAY_MAGIC,
+        .version = REPLAY_VERSION,
+        .seed = seed,
+    };
+    if (!Write(replay, &header, sizeof(header)))
+    {
+        return -1;
+    }
+
+    printf("Replay: recording to %s\n", path);
+
+    return 0;
+}
+
+int
+ReplayStartPlayback(ReplayState* replay, const char* path, Uint64* seed)
+{
+    replay->data = (Uint8*)SDL_LoadFile(path, &replay->dataSize);
+    if (replay->data == NULL)
+    {
+        SDL_Log("Could not load replay %s: %s", path, SDL_GetError());
+        return -1;
+    }
+
+    const ReplayHeader* header =
+      (const ReplayHeader*)Read(replay, sizeof(ReplayHeader));
+    if (header == NULL || header->magic != REPLAY_MAGIC ||
+        header->version != REPLAY_VERSION)
+    {
+        SDL_Log("%s is not a version %u replay", path, REPLAY_VERSION);
+        SDL_free(replay->data);
+        replay->data = NULL;
+        return -1;
+    }
+
+    replay->mode = REPLAY_MODE_PLAYBACK;
+    replay->seed = header->seed;
+    *seed = header->seed;
+
+    printf("Replay: playing back %s\n", path);
+
+    return 0;
+}
+
+bool
+ReplayIsPlayerInput(const SDL_Event* event)
+{
+    switch (event->type)
+    {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+        {
+            return true;
+        }
+
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+bool
+ReplayBeginFrame(ReplayState* replay, float* deltaTime)
+{
+    if (replay->frames == 0)
+    {
+        replay->startTicks = SDL_GetTicksNS();
+    }
+
+    if (replay->mode == REPLAY_MODE_RECORD)
+    {
+        replay->frameEventCount = 0;
+        return true;
+    }
+
+    if (replay->mode != REPLAY_MODE_PLAYBACK)
+    {
+        return true;
+    }
+
+    const ReplayFrame* frame =
+      (const ReplayFrame*)Read(replay, sizeof(ReplayFrame));
+    if (frame == NULL)
+    {
+        return false;
+    }
+
+    const ReplayEvent* events = (const ReplayEvent*)Read(
+      replay, sizeof(ReplayEvent) * (size_t)frame->eventCount);
+    if (events == NULL)
+    {
+        SDL_Log("Replay is truncated after %llu frames",
+                (unsigned long long)replay->frames);
+        return false;
+    }
+
+    *deltaTime = frame->deltaTime;
+    replay->playbackEvents = events;
+    replay->playbackEventCount = frame->eventCount;
+    replay->playbackEventNext = 0;
+
+    return true;
+}
+
+void
+ReplayRecordEvent(ReplayState* replay, const SDL_Event* event)
+{
+    if (replay->mode != REPLAY_MODE_RECORD || !ReplayIsPlayerInput(event))
+    {
+        return;
+    }
+
+    if (replay->frameEventCount == REPLAY_MAX_FRAME_EVENTS)
+    {
+        replay->droppedEvents += 1;
+        return;
+    }
+
+    ReplayEvent* entry = &replay->frameEvents[replay->frameEventCount++];
+    *entry = (ReplayEvent){ 0 };
+    entry->type = event->type;
+    if (event->type == SDL_EVENT_KEY_DOWN || event->type == SDL_EVENT_KEY_UP)
+    {
+        entry->code = event->key.key;
+        entry->modifiers = event->key.mod;
+        entry->isRepeat = event->key.repeat;
+    }
+    else
+    {
+        entry->code = event->button.button;
+        entry->clicks = event->button.clicks;
+    }
+}
+
+bool
+ReplayNextEvent(ReplayState* replay, SDL_Event* event)
+{
+    if (replay->mode != REPLAY_MODE_PLAYBACK ||
+        replay->playbackEventNext == replay->playbackEventCount)
+    {
+        return false;
+    }
+
+    const ReplayEvent* entry =
+      &replay->playbackEvents[replay->playbackEventNext++];
+
+    // Stamped now so input latency is still measured from injection
+    *event = (SDL_Event){ 0 };
+    event->type = entry->type;
+    event->common.timestamp = SDL_GetTicksNS();
+    if (entry->type == SDL_EVENT_KEY_DOWN || entry->type == SDL_EVENT_KEY_UP)
+    {
+        event->key.key = entry->code;
+        event->key.mod = entry->modifiers;
+        event->key.repeat = entry->isRepeat;
+        event->key.down = entry->type == SDL_EVENT_KEY_DOWN;
+    }
+    else
+    {
+        event->button.button = (Uint8)entry->code;
+        event->button.clicks = entry->clicks;
+        event->button.down = entry->type == SDL_EVENT_MOUSE_BUTTON_DOWN;
+    }
+
+    return true;
+}
+
+void
+ReplayEndFrame(ReplayState* replay, float deltaTime)
+{
+    if (replay->mode == REPLAY_MODE_PLAYBACK)
+    {
+        replay->frames += 1;
+        return;
+    }
+
+    if (replay->mode != REPLAY_MODE_RECORD)
+    {
+        return;
+    }
+
+    ReplayFrame frame = {
+        .deltaTime = deltaTime,
+        .eventCount = replay->frameEventCount,
+    };
+    if (Write(replay, &frame, sizeof(frame)) &&
+        Write(replay,
+              replay->frameEvents,
+              sizeof(ReplayEvent) * replay->frameEventCount))
+    {
+        replay->frames += 1;
+    }
+}
+
+void
+ReplayStop(Context* context)
+{
+    ReplayState* replay = &context->replay;
+    if (replay->mode == REPLAY_MODE_OFF && replay->frames == 0)
+    {
+        return;
+    }
+
+    double seconds = (SDL_GetTicksNS() - replay->startTicks) / 1e9;
+    printf("Replay: %llu frames in %.3f s, %.3f ms/frame, "
+           "state hash %016llx\n",
+           (unsigned long long)replay->frames,
+           seconds,
+           replay->frames > 0 ? seconds * 1000.0 / replay->frames : 0.0,
+           (unsigned long long)HashSimulation(context));
+    if (replay->droppedEvents > 0)
+    {
+        printf("Replay: %llu events dropped, more than %d in a frame\n",
+               (unsigned long long)replay->droppedEvents,
+               REPLAY_MAX_FRAME_EVENTS);
+    }
+
+    if (replay->file != NULL)
+    {
+        SDL_CloseIO(replay->file);
+    }
+    SDL_free(replay->data);
+    SDL_memset(replay, 0, sizeof(ReplayState));
+}
@@ -0,0 +1,623 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glm/glm.hpp>
+#include <glm/vec2.hpp>
+
+#include <box2d/box2d.h>
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "scenario.hpp"
+
+// -------------------------------------------------------------------------------
+internal bool
+ParseInt(const char* value, int min, int max, int* result)
+{
+    char* end = NULL;
+    long number = SDL_strtol(value, &end, 10);
+    if (end == value || *end != '\0' || number < min || number > max)
+    {
+        return false;
+    }
+
+    *result = (int)number;
+    return true;
+}
+
+internal bool
+ParseFloat(const char* value, float min, float max, float* result)
+{
+    char* end = NULL;
+    double number = SDL_strtod(value, &end);
+    if (end == value || *end != '\0' || number < min || number > max)
+    {
+        return false;
+    }
+
+    *result = (float)number;
+    return true;
+}
+
+// Comma separated sampler names, "current" for the arrow key selection
+internal bool
+ParseSamplers(Scenario* scenario, const char* value)
+{
+    char names[128];
+    SDL_strlcpy(names, value, sizeof(names));
+
+    int count = 0;
+    char* state = NULL;
+    for (char* name = SDL_strtok_r(names, ",", &state); name != NULL;
+         name = SDL_strtok_r(NULL, ",", &state))
+    {
+        if (SDL_strcasecmp(name, "current") == 0)
+        {
+            scenario->samplerCount = 0;
+            return true;
+        }
+
+        int index = -1;
+        for (int i = 0; i < (int)NumSamplers; ++i)
+        {
+            if (SDL_strcasecmp(name, SamplerNames[i]) == 0)
+            {
+                index = i;
+            }
+        }
+
+        if (index < 0 || count == (int)NumSamplers)
+        {
+            return false;
+        }
+        scenario->samplers[count++] = index;
+    }
+
+    scenario->samplerCount = count;
+    return count > 0;
+}
+
+// Comma separated PostEffectNames, "none" turns them all off
+internal bool
+ParsePostEffects(Scenario* scenario, const char* value)
+{
+    char names[128];
+    SDL_strlcpy(names, value, sizeof(names));
+
+    Uint32 effects = 0;
+    char* state = NULL;
+    for (char* name = SDL_strtok_r(names, ",", &state); name != NULL;
+         name = SDL_strtok_r(NULL, ",", &state))
+    {
+        if (SDL_strcasecmp(name, "none") == 0)
+        {
+            continue;
+        }
+
+        int index = -1;
+        for (int i = 0; i < POST_EFFECT_COUNT; ++i)
+        {
+            if (SDL_strcasecmp(name, PostEffectNames[i]) == 0)
+            {
+                index = i;
+            }
+        }
+
+        if (index < 0)
+        {
+            return false;
+        }
+        effects |= 1u << index;
+    }
+
+    scenario->postEffects = effects;
+    return true;
+}
+
+internal void
+SpawnBall(Context* context,
+          glm::vec2 position,
+          glm::vec2 velocity,
+          float radius)
+{
+    if (context->ballCount >= MAX_BALLS)
+    {
+        SDL_Log("Ball limit reached!");
+        return;
+    }
+
+    Ball* ball = &context->balls[context->ballCount];
+    ball->position = position;
+    ball->velocity = velocity;
+    ball->radius = radius;
+
+    if (PhysicsCreateBall(context, ball) < 0)
+    {
+        return;
+    }
+
+    context->ballCount += 1;
+}
+
+internal Prop*
+SpawnProp(Context* context,
+          EntityKind kind,
+          glm::vec2 position,
+          glm::vec2 halfExtents)
+{
+    if (context->propCount >= MAX_PROPS)
+    {
+        SDL_Log("Prop limit reached!");
+        return NULL;
+    }
+
+    Prop* prop = &context->props[context->propCount];
+    prop->entity =
+      EntityCreate(&context->entities, kind, (Uint32)context->propCount);
+    if (prop->entity == 0)
+    {
+        return NULL;
+    }
+
+    prop->position = position;
+    prop->halfExtents = halfExtents;
+    prop->bodyId = b2_nullBodyId;
+    EntityMarkDirty(&context->entities, prop->entity);
+
+    context->propCount += 1;
+
+    return prop;
+}
+
+internal glm::vec2
+RandomPosition(RandomState* random, glm::vec2 halfExtents)
+{
+    return glm::vec2(
+      RandomRange(random, halfExtents.x, GAME_WIDTH - halfExtents.x),
+      RandomRange(random, halfExtents.y, GAME_HEIGHT - halfExtents.y));
+}
+
+// Anywhere in the world, which may reach past the screen
+internal glm::vec2
+RandomWorldPosition(RandomState* random,
+                    int worldScreens,
+                    glm::vec2 halfExtents)
+{
+    return glm::vec2(RandomRange(random,
+                                 halfExtents.x,
+                                 GAME_WIDTH * worldScreens - halfExtents.x),
+                     RandomRange(random,
+                                 halfExtents.y,
+                                 GAME_HEIGHT * worldScreens - halfExtents.y));
+}
+
+internal glm::vec2
+RandomVelocity(RandomState* random, float minSpeed, float maxSpeed)
+{
+    float angle = RandomRange(random, 0.0f, 2.0f * (float)PI);
+    float speed = RandomRange(random, minSpeed, maxSpeed);
+    return glm::vec2(SDL_cosf(angle) * speed, SDL_sinf(angle) * speed);
+}
+
+internal int
+CompareFloats(const void* a, const void* b)
+{
+    float left = *(const float*)a;
+    float right = *(const float*)b;
+    return (left > right) - (left < right);
+}
+
+internal void
+Report(Context* context)
+{
+    Scenario* scenario = &context->scenario;
+    int count = scenario->frameTimeCount;
+
+    SDL_qsort(scenario->frameTimes, count, sizeof(float), CompareFloats);
+
+    double sum = 0.0;
+    for (int i = 0; i < count; ++i)
+    {
+        sum += scenario->frameTimes[i];
+    }
+    double mean = sum / count;
+    float p50 = scenario->frameTimes[count / 2];
+    float p95 = scenario->frameTimes[(count * 95) / 100];
+    float p99 = scenario->frameTimes[(count * 99) / 100];
+    float max = scenario->frameTimes[count - 1];
+
+    printf("Scenario %s: %d balls, %d boxes, %d sprites, %d textures, "
+           "%d samplers, %d draw calls\n",
+           scenario->name,
+           scenario->ballCount,
+           scenario->boxCount,
+           scenario->spriteCount,
+           scenario->textureCount,
+           scenario->samplerCount,
+           context->Renderer.spriteStats.drawCalls);
+
+    const SpatialGridStats* cull = &context->Renderer.spriteStats.cull;
+    printf("  cull: %d visible of %d tested in %d cells, %.3f ms\n",
+           cull->visible,
+           cull->tested,
+           cull->cellsVisited,
+           cull->querySeconds * 1000.0);
+    printf("  %d frames: mean %.3f ms (%.1f fps), p50 %.3f, p95 %.3f, "
+           "p99 %.3f, max %.3f\n",
+           count,
+           mean,
+           1000.0 / mean,
+           p50,
+           p95,
+           p99,
+           max);
+
+    if (scenario->resultsPath[0] == '\0')
+    {
+        return;
+    }
+
+    SDL_IOStream* file = SDL_IOFromFile(scenario->resultsPath, "a");
+    if (file == NULL)
+    {
+        SDL_Log("Could not open %s: %s",
+                scenario->resultsPath,
+                SDL_GetError());
+        return;
+    }
+
+    if (SDL_GetIOSize(file) == 0)
+    {
+        SDL_IOprintf(file,
+                     "name,balls,boxes,sprites,textures,samplers,frames,"
+                     "mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n");
+    }
+    SDL_IOprintf(file,
+                 "%s,%d,%d,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                 scenario->name,
+                 scenario->ballCount,
+                 scenario->boxCount,
+                 scenario->spriteCount,
+                 scenario->textureCount,
+                 scenario->samplerCount,
+                 count,
+                 mean,
+                 p50,
+                 p95,
+                 p99,
+                 max);
+    SDL_CloseIO(file);
+}
+
+// Restores the same capture over and over, each one rebuilds the whole
+// Box2D world. Runs between frames with the simulation at rest.
+internal void
+MeasureSnapshots(Context* context)
+{
+    Scenario* scenario = &context->scenario;
+    SimulationSnapshot* snapshot = context->snapshot;
+    if (scenario->snapshotRestores == 0 || snapshot == NULL)
+    {
+        return;
+    }
+
+    SnapshotCapture(context, snapshot);
+
+    float best = 1e30f;
+    float worst = 0.0f;
+    double sum = 0.0;
+    for (int i = 0; i < scenario->snapshotRestores; ++i)
+    {
+        if (SnapshotRestore(context, snapshot) < 0)
+        {
+            return;
+        }
+        best = SDL_min(best, snapshot->restoreTime);
+        worst = SDL_max(worst, snapshot->restoreTime);
+        sum += snapshot->restoreTime;
+    }
+
+    printf("  snapshot: %d bodies, capture %.3f ms, %d restores: "
+           "best %.3f ms, mean %.3f, max %.3f\n",
+           snapshot->bodyCount,
+           snapshot->captureTime,
+           scenario->snapshotRestores,
+           best,
+           sum / scenario->snapshotRestores,
+           worst);
+}
+
+// -------------------------------------------------------------------------------
+void
+ScenarioInit(Scenario* scenario)
+{
+    SDL_memset(scenario, 0, sizeof(Scenario));
+    SDL_strlcpy(scenario->name, "default", sizeof(scenario->name));
+    scenario->ballCount = 1;
+    scenario->worldScreens = 1;
+    scenario->textureCount = 1;
+    scenario->warmupFrames = SCENARIO_DEFAULT_WARMUP_FRAMES;
+    scenario->measureFrames = SCENARIO_DEFAULT_MEASURE_FRAMES;
+}
+
+int
+ScenarioSet(Scenario* scenario, const char* key, const char* value)
+{
+    bool isValid = true;
+    if (SDL_strcmp(key, "name") == 0)
+    {
+        SDL_strlcpy(scenario->name, value, sizeof(scenario->name));
+    }
+    else if (SDL_strcmp(key, "balls") == 0)
+    {
+        isValid = ParseInt(value, 0, MAX_BALLS, &scenario->ballCount);
+    }
+    else if (SDL_strcmp(key, "boxes") == 0)
+    {
+        isValid = ParseInt(value, 0, MAX_PROPS, &scenario->boxCount);
+    }
+    else if (SDL_strcmp(key, "sprites") == 0)
+    {
+        isValid = ParseInt(value, 0, MAX_PROPS, &scenario->spriteCount);
+    }
+    else if (SDL_strcmp(key, "world") == 0)
+    {
+        isValid = ParseInt(
+          value, 1, SCENARIO_MAX_WORLD_SCREENS, &scenario->worldScreens);
+    }
+    else if (SDL_strcmp(key, "textures") == 0)
+    {
+        isValid =
+          ParseInt(value, 1, RENDERER_MAX_TEXTURES, &scenario->textureCount);
+    }
+    else if (SDL_strcmp(key, "samplers") == 0)
+    {
+        isValid = ParseSamplers(scenario, value);
+    }
+    else if (SDL_strcmp(key, "warmup") == 0)
+    {
+        isValid = ParseInt(value, 0, SDL_MAX_SINT32, &scenario->warmupFrames);
+    }
+    else if (SDL_strcmp(key, "measure") == 0)
+    {
+        isValid = ParseInt(
+          value, 1, SCENARIO_MAX_MEASURE_FRAMES, &scenario->measureFrames);
+    }
+    else if (SDL_strcmp(key, "results") == 0)
+    {
+        SDL_strlcpy(
+          scenario->resultsPath, value, sizeof(scenario->resultsPath));
+    }
+    else if (SDL_strcmp(key, "exit") == 0)
+    {
+        scenario->isExitWhenDone = SDL_strcmp(value, "0") != 0;
+    }
+    else if (SDL_strcmp(key, "tilemap") == 0)
+    {
+        isValid = ParseInt(
+          value, 0, TILEMAP_MAX_CHUNKS_PER_SIDE, &scenario->tilemapChunks);
+    }
+    else if (SDL_strcmp(key, "tileedits") == 0)
+    {
+        isValid =
+          ParseInt(value, 0, TILEMAP_CHUNK_TILES, &scenario->tileEditsPerFrame);
+    }
+    else if (SDL_strcmp(key, "shapes") == 0)
+    {
+        isValid =
+          ParseInt(value, 0, SHAPES_MAX_STATIC, &scenario->shapeCount);
+    }
+    else if (SDL_strcmp(key, "particles") == 0)
+    {
+        isValid = ParseInt(
+          value, 0, PARTICLES_MAX_CAPACITY, &scenario->particleCapacity);
+    }
+    else if (SDL_strcmp(key, "particleemit") == 0)
+    {
+        isValid = ParseInt(value, 0, SDL_MAX_SINT32, &scenario->particleRate);
+    }
+    else if (SDL_strcmp(key, "gpuparticles") == 0)
+    {
+        isValid = ParseInt(value,
+                           0,
+                           (int)GPU_PARTICLES_MAX_CAPACITY,
+                           &scenario->gpuParticleCapacity);
+    }
+    else if (SDL_strcmp(key, "gpuemit") == 0)
+    {
+        isValid =
+          ParseInt(value, 0, SDL_MAX_SINT32, &scenario->gpuParticleRate);
+    }
+    else if (SDL_strcmp(key, "post") == 0)
+    {
+        isValid = ParsePostEffects(scenario, value);
+    }
+    else if (SDL_strcmp(key, "dynres") == 0)
+    {
+        isValid = ParseFloat(
+          value, 0.0f, 1000.0f, &scenario->dynamicResolutionBudgetMs);
+    }
+    else if (SDL_strcmp(key, "snapshots") == 0)
+    {
+        isValid = ParseInt(
+          value, 0, SCENARIO_MAX_SNAPSHOTS, &scenario->snapshotRestores);
+    }
+    else
+    {
+        return -1;
+    }
+
+    if (!isValid)
+    {
+        SDL_Log("Invalid scenario value for %s: %s", key, value);
+        return -1;
+    }
+
+    return 0;
+}
+
+int
+ScenarioLoad(Scenario* scenario, const char* path)
+{
+    size_t size = 0;
+    char* data = (char*)SDL_LoadFile(path, &size);
+    if (data == NULL)
+    {
+        SDL_Log("Could not load scenario %s: %s", path, SDL_GetError());
+        return -1;
+    }
+
+    int result = 0;
+    int lineNumber = 0;
+    char* lineState = NULL;
+    for (char* line = SDL_strtok_r(data, "\n", &lineState); line != NULL;
+         line = SDL_strtok_r(NULL, "\n", &lineState))
+    {
+        lineNumber += 1;
+
+        char* comment = SDL_strchr(line, '#');
+        if (comment != NULL)
+        {
+            *comment = '\0';
+        }
+
+        char* state = NULL;
+        char* key = SDL_strtok_r(line, " \t\r", &state);
+        char* value = SDL_strtok_r(NULL, " \t\r", &state);
+        if (key == NULL)
+        {
+            continue;
+        }
+
+        if (value == NULL || ScenarioSet(scenario, key, value) < 0)
+        {
+            SDL_Log("%s:%d: bad scenario line", path, lineNumber);
+            result = -1;
+        }
+    }
+
+    SDL_free(data);
+
+    return result;
+}
+
+void
+ScenarioSpawnRandomBall(Context* context)
+{
+    float radius = RandomRange(&context->random, 8.0f, 32.0f);
+    glm::vec2 position =
+      RandomPosition(&context->random, glm::vec2(radius, radius));
+    glm::vec2 velocity = RandomVelocity(&context->random, 80.0f, 200.0f);
+
+    SpawnBall(context, position, velocity, radius);
+}
+
+int
+ScenarioSpawn(Context* context)
+{
+    Scenario* scenario = &context->scenario;
+    RandomState* random = &context->random;
+    EntityId firstEntity = (EntityId)context->entities.count;
+
+    int ballCount = context->ballCount;
+    for (int i = 0; i < scenario->ballCount; ++i)
+    {
+        ScenarioSpawnRandomBall(context);
+    }
+    scenario->ballCount = context->ballCount - ballCount;
+
+    int boxCount = 0;
+    for (int i = 0; i < scenario->boxCount; ++i)
+    {
+        glm::vec2 halfExtents = glm::vec2(RandomRange(random, 4.0f, 16.0f),
+                                          RandomRange(random, 4.0f, 16.0f));
+        Prop* prop = SpawnProp(context,
+                               ENTITY_KIND_BOX,
+                               RandomPosition(random, halfExtents),
+                               halfExtents);
+        if (prop == NULL ||
+            PhysicsCreateBox(
+              context, prop, RandomVelocity(random, 20.0f, 120.0f)) < 0)
+        {
+            break;
+        }
+        boxCount += 1;
+    }
+    scenario->boxCount = boxCount;
+
+    int spriteCount = 0;
+    for (int i = 0; i < scenario->spriteCount; ++i)
+    {
+        float halfSize = RandomRange(random, 4.0f, 16.0f);
+        glm::vec2 halfExtents = glm::vec2(halfSize, halfSize);
+        if (SpawnProp(context,
+                      ENTITY_KIND_SPRITE,
+                      RandomWorldPosition(
+                        random, scenario->worldScreens, halfExtents),
+                      halfExtents) == NULL)
+        {
+            break;
+        }
+        spriteCount += 1;
+    }
+    scenario->spriteCount = spriteCount;
+
+    // Split the spawned entities into contiguous batches that cycle
+    // through the textures and samplers
+    scenario->textureCount = context->Renderer.spriteTextureCount;
+    int spawned = context->entities.count - (int)firstEntity;
+    int batchCount = SDL_max(scenario->textureCount, scenario->samplerCount);
+    if (batchCount <= 1 || spawned == 0)
+    {
+        return RendererSetSpriteBatches(context, NULL, 0);
+    }
+
+    batchCount = SDL_min(batchCount, spawned);
+    SpriteBatch batches[RENDERER_MAX_SPRITE_BATCHES];
+    for (int i = 0; i < batchCount; ++i)
+    {
+        int first = spawned * i / batchCount;
+        int end = spawned * (i + 1) / batchCount;
+
+        batches[i].first = firstEntity + first;
+        batches[i].count = end - first;
+        batches[i].textureIndex = i % scenario->textureCount;
+        batches[i].samplerIndex =
+          scenario->samplerCount > 0
+            ? scenario->samplers[i % scenario->samplerCount]
+            : -1;
+    }
+
+    return RendererSetSpriteBatches(context, batches, batchCount);
+}
+
+void
+ScenarioEndFrame(Context* context, float frameSeconds)
+{
+    Scenario* scenario = &context->scenario;
+    scenario->frames += 1;
+    if (scenario->isReported ||
+        scenario->frames <= (Uint64)scenario->warmupFrames)
+    {
+        return;
+    }
+
+    scenario->frameTimes[scenario->frameTimeCount++] = frameSeconds * 1000.0f;
+    if (scenario->frameTimeCount < scenario->measureFrames)
+    {
+        return;
+    }
+
+    Report(context);
+    MeasureSnapshots(context);
+    scenario->isReported = true;
+
+    if (scenario->isExitWhenDone)
+    {
+        context->isRunning = false;
+    }
+}
@@ -0,0 +1,409 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "profiler.hpp"
+#include "shapes.hpp"
+
+static_assert(sizeof(ShapeInstance) == 32, "Instance layout changed");
+
+// Second vertex uniform, after the camera
+typedef struct ShapeUniforms
+{
+    float pixelSize; // World units per screen pixel, for the edge margin
+    float padding[3];
+} ShapeUniforms;
+
+global_variable const Uint32 ShapePalette[] = {
+    0xff4f8fffu, 0xff6fd35fu, 0xff3fb7f7u, 0xffd36fe0u,
+    0xff5fd3e0u, 0xffe0d35fu, 0xff9f7fffu, 0xffffffffu,
+};
+
+// -------------------------------------------------------------------------------
+internal int
+CreatePipeline(Context* context)
+{
+    ShapeRenderer* shapes = &context->shapes;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    SDL_GPUShader* vertexShader =
+      RendererLoadShader(context, device, "SdfShape.vert", 0, 2, 0, 0);
+    if (vertexShader == NULL)
+    {
+        SDL_Log("Failed to create shape vertex shader!");
+        return -1;
+    }
+
+    SDL_GPUShader* fragmentShader =
+      RendererLoadShader(context, device, "SdfShape.frag", 0, 0, 0, 0);
+    if (fragmentShader == NULL)
+    {
+        SDL_Log("Failed to create shape fragment shader!");
+        SDL_ReleaseGPUShader(device, vertexShader);
+        return -1;
+    }
+
+    // One instance per shape, the corners come from the vertex index
+    SDL_GPUVertexBufferDescription vertexBufferDescriptions[] = {
+        {
+          .slot = 0,
+          .pitch = sizeof(ShapeInstance),
+          .input_rate = SDL_GPU_VERTEXINPUTRATE_INSTANCE,
+          .instance_step_rate = 0,
+        },
+    };
+
+    SDL_GPUVertexAttribute vertexAttributes[] = {
+        { .location = 0,
+          .buffer_slot = 0,
+          .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4,
+          .offset = offsetof(ShapeInstance, center) },
+        { .location = 1,
+          .buffer_slot = 0,
+          .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2,
+          .offset = offsetof(ShapeInstance, rotation) },
+        { .location = 2,
+          .buffer_slot = 0,
+          .format = SDL_GPU_VERTEXELEMENTFORMAT_UINT,
+          .offset = offsetof(ShapeInstance, kind) },
+        { .location = 3,
+          .buffer_slot = 0,
+          .format = SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM,
+          .offset = offsetof(ShapeInstance, color) },
+    };
+
+    SDL_GPUColorTargetDescription colorTargetDescriptions[] = {
+        {
+          .format = SDL_GetGPUSwapchainTextureFormat(device,
+                                                     context->Renderer.Window),
+          .blend_state =
+            (SDL_GPUColorTargetBlendState){
+              .src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA,
+              .dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+              .color_blend_op = SDL_GPU_BLENDOP_ADD,
+              .src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
+              .dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+              .alpha_blend_op = SDL_GPU_BLENDOP_ADD,
+              .enable_blend = true,
+            },
+        },
+    };
+
+    SDL_GPUGraphicsPipelineCreateInfo pipelineCreateInfo = {
+        .vertex_shader = vertexShader,
+        .fragment_shader = fragmentShader,
+        .vertex_input_state =
+          (SDL_GPUVertexInputState){
+            .vertex_buffer_descriptions = vertexBufferDescriptions,
+            .num_vertex_buffers = 1,
+            .vertex_attributes = vertexAttributes,
+            .num_vertex_attributes = 4,
+          },
+        .primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
+        .rasterizer_state =
+          (SDL_GPURasterizerState){
+            .fill_mode = SDL_GPU_FILLMODE_FILL,
+            .cull_mode = SDL_GPU_CULLMODE_NONE,
+            .front_face = SDL_GPU_FRONTFACE_CLOCKWISE,
+          },
+        .target_info = {
+          .color_target_descriptions = colorTargetDescriptions,
+          .num_color_targets = 1,
+        },
+    };
+
+    shapes->Pipeline =
+      SDL_CreateGPUGraphicsPipeline(device, &pipelineCreateInfo);
+
+    SDL_ReleaseGPUShader(device, vertexShader);
+    SDL_ReleaseGPUShader(device, fragmentShader);
+
+    if (shapes->Pipeline == NULL)
+    {
+        SDL_Log("Failed to create shape pipeline!");
+        return -1;
+    }
+
+    return 0;
+}
+
+internal ShapeInstance
+RandomShape(RandomState* random, glm::vec2 worldSize)
+{
+    ShapeInstance shape;
+    SDL_memset(&shape, 0, sizeof(ShapeInstance));
+    shape.kind = RandomNext(random) % 3;
+    shape.center = glm::vec2(RandomRange(random, 0.0f, worldSize.x),
+                             RandomRange(random, 0.0f, worldSize.y));
+    shape.rotation = RandomRange(random, 0.0f, 2.0f * (float)PI);
+    shape.color =
+      ShapePalette[RandomNext(random) % SDL_arraysize(ShapePalette)];
+
+    float size = RandomRange(random, 1.0f, 6.0f);
+    switch (shape.kind)
+    {
+        case SHAPE_KIND_CIRCLE:
+        {
+            shape.halfExtents = glm::vec2(size);
+        }
+        break;
+
+        case SHAPE_KIND_ROUNDED_RECT:
+        {
+            float height = RandomRange(random, 1.0f, 6.0f);
+            shape.halfExtents = glm::vec2(size, height);
+            shape.cornerRadius = SDL_min(size, height) * 0.5f;
+        }
+        break;
+
+        default:
+        {
+            shape.halfExtents = glm::vec2(size * 2.0f, size * 0.5f);
+        }
+        break;
+    }
+
+    return shape;
+}
+
+// -------------------------------------------------------------------------------
+int
+ShapesInit(Context* context, int staticCount, glm::vec2 worldSize)
+{
+    ShapeRenderer* shapes = &context->shapes;
+    SDL_GPUDevice* device = context->Renderer.Device;
+    SDL_memset(shapes, 0, sizeof(ShapeRenderer));
+
+    if (staticCount < 0 || staticCount > SHAPES_MAX_STATIC)
+    {
+        SDL_Log("Invalid static shape count: %d", staticCount);
+        return -1;
+    }
+
+    if (CreatePipeline(context) < 0)
+    {
+        return -1;
+    }
+
+    SDL_GPUBufferCreateInfo instanceBufferCreateInfo = {
+        .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
+        .size = static_cast<Uint32>(sizeof(ShapeInstance) *
+                                    (staticCount + SHAPES_MAX_DYNAMIC)),
+    };
+    shapes->InstanceBuffer =
+      SDL_CreateGPUBuffer(device, &instanceBufferCreateInfo);
+    SDL_SetGPUBufferName(
+      device, shapes->InstanceBuffer, "Shape Instance Buffer");
+
+    SDL_GPUTransferBufferCreateInfo transferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size =
+          static_cast<Uint32>(sizeof(ShapeInstance) * SHAPES_MAX_DYNAMIC),
+    };
+    shapes->TransferBuffer =
+      SDL_CreateGPUTransferBuffer(device, &transferBufferCreateInfo);
+
+    if (shapes->InstanceBuffer == NULL || shapes->TransferBuffer == NULL)
+    {
+        SDL_Log("Could not create the shape buffers: %s", SDL_GetError());
+        ShapesDestroy(context);
+        return -1;
+    }
+
+    if (staticCount > 0)
+    {
+        SDL_GPUTransferBufferCreateInfo staticTransferBufferCreateInfo = {
+            .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+            .size = static_cast<Uint32>(sizeof(ShapeInstance) * staticCount),
+        };
+        shapes->StaticTransferBuffer =
+          SDL_CreateGPUTransferBuffer(device, &staticTransferBufferCreateInfo);
+        if (shapes->StaticTransferBuffer == NULL)
+        {
+            SDL_Log("Could not create the shape transfer buffer: %s",
+                    SDL_GetError());
+            ShapesDestroy(context);
+            return -1;
+        }
+
+        ShapeInstance* instances =
+          static_cast<ShapeInstance*>(SDL_MapGPUTransferBuffer(
+            device, shapes->StaticTransferBuffer, false));
+        RandomState random;
+        RandomSeed(&random, SHAPES_SEED);
+        for (int i = 0; i < staticCount; ++i)
+        {
+            instances[i] = RandomShape(&random, worldSize);
+        }
+        SDL_UnmapGPUTransferBuffer(device, shapes->StaticTransferBuffer);
+    }
+
+    shapes->staticCount = staticCount;
+    shapes->stats.staticShapes = staticCount;
+    shapes->isAvailable = true;
+
+    return 0;
+}
+
+void
+ShapesBuild(Context* context)
+{
+    ShapeRenderer* shapes = &context->shapes;
+    const RenderSnapshot* snapshot = context->renderSnapshot;
+    shapes->dynamicCount = 0;
+
+    if (!shapes->isAvailable || snapshot == NULL || snapshot->shapeCount == 0)
+    {
+        return;
+    }
+
+    PROFILE_FUNCTION();
+
+    // Cycled, the previous frame may still be reading from it
+    ShapeInstance* instances =
+      static_cast<ShapeInstance*>(SDL_MapGPUTransferBuffer(
+        context->Renderer.Device, shapes->TransferBuffer, true));
+
+    int count = SDL_min(snapshot->shapeCount, SHAPES_MAX_DYNAMIC);
+    for (int i = 0; i < count; ++i)
+    {
+        EntityId entity = snapshot->shapeList[i];
+        const Ball* ball = &context->balls[context->entities.index[entity]];
+
+        ShapeInstance* instance = &instances[i];
+        SDL_memset(instance, 0, sizeof(ShapeInstance));
+        instance->center = ball->position;
+        instance->halfExtents = glm::vec2(ball->radius);
+        instance->kind = SHAPE_KIND_CIRCLE;
+        instance->color = ShapePalette[entity % SDL_arraysize(ShapePalette)];
+    }
+
+    SDL_UnmapGPUTransferBuffer(context->Renderer.Device,
+                               shapes->TransferBuffer);
+    shapes->dynamicCount = count;
+}
+
+void
+ShapesUpload(Context* context, SDL_GPUCopyPass* copyPass)
+{
+    ShapeRenderer* shapes = &context->shapes;
+    shapes->stats.uploadedBytes = 0;
+    if (!shapes->isAvailable)
+    {
+        return;
+    }
+
+    if (shapes->StaticTransferBuffer != NULL)
+    {
+        SDL_GPUTransferBufferLocation transferLocation = {
+            .transfer_buffer = shapes->StaticTransferBuffer,
+            .offset = 0,
+        };
+        SDL_GPUBufferRegion instanceBufferRegion = {
+            .buffer = shapes->InstanceBuffer,
+            .offset = 0,
+            .size = static_cast<Uint32>(sizeof(ShapeInstance) *
+                                        shapes->staticCount),
+        };
+        SDL_UploadToGPUBuffer(
+          copyPass, &transferLocation, &instanceBufferRegion, false);
+        shapes->stats.uploadedBytes += instanceBufferRegion.size;
+
+        // Released once the upload has finished on the GPU
+        SDL_ReleaseGPUTransferBuffer(context->Renderer.Device,
+                                     shapes->StaticTransferBuffer);
+        shapes->StaticTransferBuffer = NULL;
+    }
+
+    if (shapes->dynamicCount > 0)
+    {
+        SDL_GPUTransferBufferLocation transferLocation = {
+            .transfer_buffer = shapes->TransferBuffer,
+            .offset = 0,
+        };
+        SDL_GPUBufferRegion instanceBufferRegion = {
+            .buffer = shapes->InstanceBuffer,
+            .offset = static_cast<Uint32>(sizeof(ShapeInstance) *
+                                          shapes->staticCount),
+            .size = static_cast<Uint32>(sizeof(ShapeInstance) *
+                                        shapes->dynamicCount),
+        };
+        // Not cycled, the static shapes before them are only uploaded once
+        SDL_UploadToGPUBuffer(
+          copyPass, &transferLocation, &instanceBufferRegion, false);
+        shapes->stats.uploadedBytes += instanceBufferRegion.size;
+    }
+}
+
+void
+ShapesRender(Context* context,
+             SDL_GPUCommandBuffer* cmdbuf,
+             SDL_GPURenderPass* renderPass)
+{
+    ShapeRenderer* shapes = &context->shapes;
+    int instanceCount = shapes->staticCount + shapes->dynamicCount;
+    shapes->stats.dynamicShapes = shapes->dynamicCount;
+    if (!shapes->isAvailable || instanceCount == 0)
+    {
+        return;
+    }
+
+    // The first column of the view projection holds zoom * 2 / width, the
+    // pixels are those of the target the world goes into
+    glm::mat4 viewProjection = context->Renderer.ViewProjection;
+    float scale =
+      glm::length(glm::vec2(viewProjection[0][0], viewProjection[0][1]));
+    float targetWidth = context->Renderer.renderWidth > 0
+                          ? (float)context->Renderer.renderWidth
+                          : (float)GAME_WIDTH;
+    ShapeUniforms uniforms = {
+        .pixelSize = 2.0f / (scale * targetWidth),
+    };
+
+    SDL_BindGPUGraphicsPipeline(renderPass, shapes->Pipeline);
+    SDL_GPUBufferBinding instanceBufferBinding = {
+        .buffer = shapes->InstanceBuffer,
+        .offset = 0,
+    };
+    SDL_BindGPUVertexBuffers(renderPass, 0, &instanceBufferBinding, 1);
+    SDL_PushGPUVertexUniformData(cmdbuf,
+                                 RENDERER_CAMERA_UNIFORM_SLOT + 1,
+                                 &uniforms,
+                                 sizeof(ShapeUniforms));
+
+    SDL_DrawGPUPrimitives(renderPass, 6, (Uint32)instanceCount, 0, 0);
+    RendererCountDraw(&context->Renderer);
+}
+
+void
+ShapesDestroy(Context* context)
+{
+    ShapeRenderer* shapes = &context->shapes;
+    SDL_GPUDevice* device = context->Renderer.Device;
+
+    if (shapes->Pipeline != NULL)
+    {
+        SDL_ReleaseGPUGraphicsPipeline(device, shapes->Pipeline);
+    }
+    if (shapes->InstanceBuffer != NULL)
+    {
+        SDL_ReleaseGPUBuffer(device, shapes->InstanceBuffer);
+    }
+    if (shapes->TransferBuffer != NULL)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, shapes->TransferBuffer);
+    }
+    if (shapes->StaticTransferBuffer != NULL)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, shapes->StaticTransferBuffer);
+    }
+
+    SDL_memset(shapes, 0, sizeof(ShapeRenderer));
+}
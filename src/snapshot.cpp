@@ -0,0 +1,136 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glm/glm.hpp>
+#include <glm/vec2.hpp>
+
+#include <box2d/box2d.h>
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "snapshot.hpp"
+
+// -------------------------------------------------------------------------------
+internal float
+ElapsedMilliseconds(Uint64 start)
+{
+    return (SDL_GetPerformanceCounter() - start) * 1000.0f /
+           (float)SDL_GetPerformanceFrequency();
+}
+
+SimulationSnapshot*
+SnapshotCreate(void)
+{
+    SimulationSnapshot* snapshot =
+      (SimulationSnapshot*)SDL_calloc(1, sizeof(SimulationSnapshot));
+    if (snapshot == NULL)
+    {
+        SDL_Log("Could not allocate the simulation snapshot!");
+    }
+
+    return snapshot;
+}
+
+void
+SnapshotCapture(Context* context, SimulationSnapshot* snapshot)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    snapshot->frameIndex = context->frameIndex;
+    snapshot->simulationTime = context->simulationTime;
+    snapshot->physicsAccumulator = context->physics.accumulator;
+    snapshot->physicsStepCount = context->physics.stepCount;
+    snapshot->random = context->random;
+
+    snapshot->ballCount = context->ballCount;
+    SDL_memcpy(
+      snapshot->balls, context->balls, sizeof(Ball) * context->ballCount);
+
+    snapshot->propCount = context->propCount;
+    SDL_memcpy(
+      snapshot->props, context->props, sizeof(Prop) * context->propCount);
+
+    const EntityTable* entities = &context->entities;
+    snapshot->entityCount = entities->count;
+    SDL_memcpy(snapshot->entityKind, entities->kind, entities->count);
+    SDL_memcpy(snapshot->entityIndex,
+               entities->index,
+               sizeof(Uint32) * entities->count);
+
+    snapshot->bodyCount = 0;
+    for (int entity = 1; entity < entities->count; ++entity)
+    {
+        if (PhysicsDescribeBody(
+              context, entity, &snapshot->bodies[snapshot->bodyCount]))
+        {
+            snapshot->bodyCount += 1;
+        }
+    }
+
+    snapshot->isValid = true;
+    snapshot->captureTime = ElapsedMilliseconds(start);
+
+    SDL_Log("Snapshot captured: frame %llu, %d bodies in %.3f ms",
+            (unsigned long long)snapshot->frameIndex,
+            snapshot->bodyCount,
+            snapshot->captureTime);
+}
+
+int
+SnapshotRestore(Context* context, SimulationSnapshot* snapshot)
+{
+    if (!snapshot->isValid)
+    {
+        SDL_Log("No snapshot to restore!");
+        return -1;
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    context->frameIndex = snapshot->frameIndex;
+    context->simulationTime = snapshot->simulationTime;
+    context->physics.accumulator = snapshot->physicsAccumulator;
+    context->physics.stepCount = snapshot->physicsStepCount;
+    context->physics.eventCount = 0;
+    context->random = snapshot->random;
+
+    context->ballCount = snapshot->ballCount;
+    SDL_memcpy(
+      context->balls, snapshot->balls, sizeof(Ball) * snapshot->ballCount);
+
+    context->propCount = snapshot->propCount;
+    SDL_memcpy(
+      context->props, snapshot->props, sizeof(Prop) * snapshot->propCount);
+
+    EntityTable* entities = &context->entities;
+    EntityClearDirty(entities);
+    entities->count = snapshot->entityCount;
+    SDL_memcpy(entities->kind, snapshot->entityKind, snapshot->entityCount);
+    SDL_memcpy(entities->index,
+               snapshot->entityIndex,
+               sizeof(Uint32) * snapshot->entityCount);
+
+    // Also refreshes the body ids stored in the balls, walls and boxes.
+    // Static sprites have no body, mark everything dirty for them.
+    PhysicsRebuildWorld(context, snapshot->bodies, snapshot->bodyCount);
+    EntityMarkAllDirty(entities);
+
+    snapshot->restoreTime = ElapsedMilliseconds(start);
+
+    SDL_Log("Snapshot restored: frame %llu, %d bodies in %.3f ms",
+            (unsigned long long)snapshot->frameIndex,
+            snapshot->bodyCount,
+            snapshot->restoreTime);
+
+    return 0;
+}
+
+void
+SnapshotDestroy(SimulationSnapshot* snapshot)
+{
+    SDL_free(snapshot);
+}
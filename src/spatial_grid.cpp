@@ -0,0 +1,209 @@
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "includes.hpp"
+#include "spatial_grid.hpp"
+
+// -------------------------------------------------------------------------------
+internal int
+CellCoordinate(float position, int cellCount)
+{
+    int cell = (int)SDL_floorf(position / SPATIAL_GRID_CELL_SIZE);
+    return SDL_clamp(cell, 0, cellCount - 1);
+}
+
+internal Sint32
+CellFor(const SpatialGrid* grid, glm::vec2 center, glm::vec2 halfExtents)
+{
+    if (halfExtents.x > SPATIAL_GRID_LOOSENESS ||
+        halfExtents.y > SPATIAL_GRID_LOOSENESS)
+    {
+        return SPATIAL_GRID_OVERSIZED;
+    }
+
+    return CellCoordinate(center.y, grid->cellsY) * grid->cellsX +
+           CellCoordinate(center.x, grid->cellsX);
+}
+
+internal void
+Unlink(SpatialGrid* grid, EntityId entity)
+{
+    EntityId next = grid->next[entity];
+    EntityId previous = grid->previous[entity];
+    if (previous != 0)
+    {
+        grid->next[previous] = next;
+    }
+    else
+    {
+        grid->heads[grid->cell[entity]] = next;
+    }
+    if (next != 0)
+    {
+        grid->previous[next] = previous;
+    }
+    grid->cell[entity] = SPATIAL_GRID_NONE;
+}
+
+internal void
+Link(SpatialGrid* grid, EntityId entity, Sint32 cell)
+{
+    EntityId head = grid->heads[cell];
+    grid->next[entity] = head;
+    grid->previous[entity] = 0;
+    if (head != 0)
+    {
+        grid->previous[head] = entity;
+    }
+    grid->heads[cell] = entity;
+    grid->cell[entity] = cell;
+}
+
+// Tests one list against the view, appending the overlapping entities
+internal int
+QueryList(const SpatialGrid* grid,
+          Sint32 cell,
+          glm::vec2 viewMin,
+          glm::vec2 viewMax,
+          EntityId* result,
+          int count,
+          int* tested)
+{
+    for (EntityId entity = grid->heads[cell]; entity != 0;
+         entity = grid->next[entity])
+    {
+        *tested += 1;
+        const glm::vec2 boundsMin = grid->boundsMin[entity];
+        const glm::vec2 boundsMax = grid->boundsMax[entity];
+        if (boundsMax.x >= viewMin.x && boundsMin.x <= viewMax.x &&
+            boundsMax.y >= viewMin.y && boundsMin.y <= viewMax.y)
+        {
+            result[count++] = entity;
+        }
+    }
+
+    return count;
+}
+
+// -------------------------------------------------------------------------------
+void
+SpatialGridInit(SpatialGrid* grid, glm::vec2 worldSize)
+{
+    int cellsX = (int)SDL_ceilf(worldSize.x / SPATIAL_GRID_CELL_SIZE);
+    int cellsY = (int)SDL_ceilf(worldSize.y / SPATIAL_GRID_CELL_SIZE);
+    grid->cellsX = SDL_clamp(cellsX, 1, SPATIAL_GRID_MAX_CELLS_PER_SIDE);
+    grid->cellsY = SDL_clamp(cellsY, 1, SPATIAL_GRID_MAX_CELLS_PER_SIDE);
+    grid->idEnd = 0;
+
+    for (int entity = 0; entity < MAX_ENTITIES; ++entity)
+    {
+        grid->cell[entity] = SPATIAL_GRID_NONE;
+    }
+    SDL_memset(grid->heads, 0, sizeof(grid->heads));
+}
+
+void
+SpatialGridUpdate(SpatialGrid* grid,
+                  EntityId entity,
+                  glm::vec2 center,
+                  glm::vec2 halfExtents)
+{
+    if (entity == 0)
+    {
+        return;
+    }
+
+    grid->boundsMin[entity] = center - halfExtents;
+    grid->boundsMax[entity] = center + halfExtents;
+
+    // Most moves stay inside the cell
+    Sint32 cell = CellFor(grid, center, halfExtents);
+    if (cell == grid->cell[entity])
+    {
+        return;
+    }
+
+    if (grid->cell[entity] != SPATIAL_GRID_NONE)
+    {
+        Unlink(grid, entity);
+    }
+    Link(grid, entity, cell);
+    grid->idEnd = SDL_max(grid->idEnd, (int)entity + 1);
+}
+
+void
+SpatialGridRemove(SpatialGrid* grid, EntityId entity)
+{
+    if (grid->cell[entity] != SPATIAL_GRID_NONE)
+    {
+        Unlink(grid, entity);
+    }
+}
+
+void
+SpatialGridTruncate(SpatialGrid* grid, int count)
+{
+    for (int entity = SDL_max(count, 1); entity < grid->idEnd; ++entity)
+    {
+        SpatialGridRemove(grid, (EntityId)entity);
+    }
+    grid->idEnd = SDL_min(grid->idEnd, count);
+}
+
+int
+SpatialGridQuery(const SpatialGrid* grid,
+                 glm::vec2 viewMin,
+                 glm::vec2 viewMax,
+                 EntityId* result,
+                 SpatialGridStats* stats)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    int tested = 0;
+    int count = QueryList(grid,
+                          SPATIAL_GRID_OVERSIZED,
+                          viewMin,
+                          viewMax,
+                          result,
+                          0,
+                          &tested);
+
+    // Anything filed outside these cells is too far from the view to reach
+    // into it
+    int firstX =
+      CellCoordinate(viewMin.x - SPATIAL_GRID_LOOSENESS, grid->cellsX);
+    int firstY =
+      CellCoordinate(viewMin.y - SPATIAL_GRID_LOOSENESS, grid->cellsY);
+    int lastX =
+      CellCoordinate(viewMax.x + SPATIAL_GRID_LOOSENESS, grid->cellsX);
+    int lastY =
+      CellCoordinate(viewMax.y + SPATIAL_GRID_LOOSENESS, grid->cellsY);
+    for (int cellY = firstY; cellY <= lastY; ++cellY)
+    {
+        for (int cellX = firstX; cellX <= lastX; ++cellX)
+        {
+            count = QueryList(grid,
+                              cellY * grid->cellsX + cellX,
+                              viewMin,
+                              viewMax,
+                              result,
+                              count,
+                              &tested);
+        }
+    }
+
+    if (stats != NULL)
+    {
+        stats->cellsVisited = (lastX - firstX + 1) * (lastY - firstY + 1);
+        stats->tested = tested;
+        stats->visible = count;
+        stats->querySeconds = (SDL_GetPerformanceCounter() - start) /
+                              (double)SDL_GetPerformanceFrequency();
+    }
+
+    return count;
+}
@@ -0,0 +1,389 @@
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_gpu.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <glm/glm.hpp>
+
+// Our code
+#include "context.hpp"
+#include "includes.hpp"
+#include "profiler.hpp"
+#include "tilemap.hpp"
+
+static_assert(TILEMAP_CHUNK_TILES <= MAX_SPRITES,
+              "A chunk draws from the sprite index buffer");
+
+constexpr Uint32 CHUNK_VERTICES = TILEMAP_CHUNK_TILES * 4;
+
+// -------------------------------------------------------------------------------
+internal void
+MarkChunkDirty(Tilemap* tilemap, int chunk)
+{
+    if (!tilemap->chunks[chunk].isDirty)
+    {
+        tilemap->chunks[chunk].isDirty = true;
+        tilemap->dirtyList[tilemap->dirtyCount++] = chunk;
+    }
+}
+
+// Solid border, scattered blocks inside
+internal void
+GenerateTiles(Tilemap* tilemap)
+{
+    RandomState random;
+    RandomSeed(&random, TILEMAP_SEED);
+
+    for (int y = 0; y < tilemap->height; ++y)
+    {
+        for (int x = 0; x < tilemap->width; ++x)
+        {
+            bool isBorder = x == 0 || y == 0 || x == tilemap->width - 1 ||
+                            y == tilemap->height - 1;
+            Uint32 value = RandomNext(&random);
+            Tile tile = 0;
+            if (isBorder)
+            {
+                tile = 1;
+            }
+            else if (value % 5 == 0)
+            {
+                tile = (Tile)(1 + (value >> 8) % TILEMAP_TILE_KINDS);
+            }
+            tilemap->tiles[y * tilemap->width + x] = tile;
+        }
+    }
+}
+
+// Non-empty tiles of a chunk packed at the front, returns their count
+internal int
+WriteChunk(const Tilemap* tilemap, int chunk, PositionTextureVertex* vertices)
+{
+    int chunkX = chunk % tilemap->chunksX;
+    int chunkY = chunk / tilemap->chunksX;
+    const float cellSize = 1.0f / TILEMAP_ATLAS_COLUMNS;
+    const glm::vec2 halfExtents(TILEMAP_TILE_SIZE * 0.5f);
+
+    int quadCount = 0;
+    for (int ty = 0; ty < TILEMAP_CHUNK_SIZE; ++ty)
+    {
+        int y = chunkY * TILEMAP_CHUNK_SIZE + ty;
+        for (int tx = 0; tx < TILEMAP_CHUNK_SIZE; ++tx)
+        {
+            int x = chunkX * TILEMAP_CHUNK_SIZE + tx;
+            if (x >= tilemap->width || y >= tilemap->height)
+            {
+                continue;
+            }
+
+            Tile tile = tilemap->tiles[y * tilemap->width + x];
+            if (tile == 0)
+            {
+                continue;
+            }
+
+            PositionTextureVertex* quad = &vertices[quadCount * 4];
+            glm::vec2 center((x + 0.5f) * TILEMAP_TILE_SIZE,
+                             (y + 0.5f) * TILEMAP_TILE_SIZE);
+            RendererWriteSpriteQuad(quad, center, halfExtents);
+
+            float u = ((tile - 1) % TILEMAP_ATLAS_COLUMNS) * cellSize;
+            float v = ((tile - 1) / TILEMAP_ATLAS_COLUMNS) * cellSize;
+            for (int corner = 0; corner < 4; ++corner)
+            {
+                quad[corner].u = u + quad[corner].u * cellSize;
+                quad[corner].v = v + quad[corner].v * cellSize;
+            }
+
+            quadCount += 1;
+        }
+    }
+
+    return quadCount;
+}
+
+// -------------------------------------------------------------------------------
+int
+TilemapInit(Context* context, int chunksPerSide, int editsPerFrame)
+{
+    Tilemap* tilemap = &context->tilemap;
+    SDL_memset(tilemap, 0, sizeof(Tilemap));
+
+    if (chunksPerSide <= 0 || chunksPerSide > TILEMAP_MAX_CHUNKS_PER_SIDE)
+    {
+        SDL_Log("Invalid tilemap size: %d chunks", chunksPerSide);
+        return -1;
+    }
+
+    tilemap->chunksX = chunksPerSide;
+    tilemap->chunksY = chunksPerSide;
+    tilemap->width = chunksPerSide * TILEMAP_CHUNK_SIZE;
+    tilemap->height = chunksPerSide * TILEMAP_CHUNK_SIZE;
+    tilemap->editsPerFrame = editsPerFrame;
+    RandomSeed(&tilemap->random, TILEMAP_SEED + 1);
+
+    tilemap->tiles =
+      (Tile*)SDL_malloc(sizeof(Tile) * tilemap->width * tilemap->height);
+    if (tilemap->tiles == NULL)
+    {
+        SDL_Log("Could not allocate the tilemap!");
+        return -1;
+    }
+    GenerateTiles(tilemap);
+
+    int chunkCount = tilemap->chunksX * tilemap->chunksY;
+    SDL_GPUBufferCreateInfo vertexBufferCreateInfo = {
+        .usage = SDL_GPU_BUFFERUSAGE_VERTEX,
+        .size = static_cast<Uint32>(sizeof(PositionTextureVertex) *
+                                    CHUNK_VERTICES * chunkCount),
+    };
+    tilemap->VertexBuffer =
+      SDL_CreateGPUBuffer(context->Renderer.Device, &vertexBufferCreateInfo);
+    SDL_SetGPUBufferName(context->Renderer.Device,
+                         tilemap->VertexBuffer,
+                         "Tilemap Vertex Buffer");
+
+    SDL_GPUTransferBufferCreateInfo transferBufferCreateInfo = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = static_cast<Uint32>(sizeof(PositionTextureVertex) *
+                                    CHUNK_VERTICES *
+                                    TILEMAP_MAX_CHUNK_UPLOADS),
+    };
+    tilemap->TransferBuffer = SDL_CreateGPUTransferBuffer(
+      context->Renderer.Device, &transferBufferCreateInfo);
+
+    if (tilemap->VertexBuffer == NULL || tilemap->TransferBuffer == NULL)
+    {
+        SDL_Log("Could not create the tilemap buffers: %s", SDL_GetError());
+        TilemapDestroy(context);
+        return -1;
+    }
+
+    // Everything is built once, over the first frames
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        MarkChunkDirty(tilemap, chunk);
+    }
+
+    tilemap->stats.chunks = chunkCount;
+    tilemap->isEnabled = true;
+    SDL_Log("Tilemap: %d x %d tiles in %d chunks",
+            tilemap->width,
+            tilemap->height,
+            chunkCount);
+
+    return 0;
+}
+
+void
+TilemapSetTile(Tilemap* tilemap, int x, int y, Tile tile)
+{
+    if (x < 0 || y < 0 || x >= tilemap->width || y >= tilemap->height)
+    {
+        return;
+    }
+
+    Tile* current = &tilemap->tiles[y * tilemap->width + x];
+    if (*current == tile)
+    {
+        return;
+    }
+    *current = tile;
+
+    int chunk = (y / TILEMAP_CHUNK_SIZE) * tilemap->chunksX +
+                x / TILEMAP_CHUNK_SIZE;
+    MarkChunkDirty(tilemap, chunk);
+}
+
+void
+TilemapUpdate(Context* context)
+{
+    Tilemap* tilemap = &context->tilemap;
+    if (!tilemap->isEnabled)
+    {
+        return;
+    }
+
+    // Inside the view, so the rebuilt chunks are also drawn
+    glm::vec2 viewMin;
+    glm::vec2 viewMax;
+    CameraBounds(&context->camera, &viewMin, &viewMax);
+    int firstX = SDL_max(0, (int)(viewMin.x / TILEMAP_TILE_SIZE));
+    int firstY = SDL_max(0, (int)(viewMin.y / TILEMAP_TILE_SIZE));
+    int endX = SDL_min(tilemap->width, (int)(viewMax.x / TILEMAP_TILE_SIZE));
+    int endY = SDL_min(tilemap->height, (int)(viewMax.y / TILEMAP_TILE_SIZE));
+    if (endX <= firstX || endY <= firstY)
+    {
+        return;
+    }
+
+    for (int i = 0; i < tilemap->editsPerFrame; ++i)
+    {
+        Uint32 value = RandomNext(&tilemap->random);
+        int x = firstX + (int)(value % (endX - firstX));
+        int y = firstY + (int)((value >> 12) % (endY - firstY));
+        Tile tile = (Tile)((value >> 24) % (TILEMAP_TILE_KINDS + 1));
+        TilemapSetTile(tilemap, x, y, tile);
+    }
+}
+
+void
+TilemapBuild(Context* context)
+{
+    Tilemap* tilemap = &context->tilemap;
+    tilemap->stats.rebuiltChunks = 0;
+
+    // Wait until the last batch actually made it to the GPU
+    if (!tilemap->isEnabled || tilemap->dirtyCount == 0 ||
+        tilemap->uploadCount > 0)
+    {
+        return;
+    }
+
+    PROFILE_FUNCTION();
+
+    // Cycled, the previous uploads may still be reading from it
+    PositionTextureVertex* vertices =
+      static_cast<PositionTextureVertex*>(SDL_MapGPUTransferBuffer(
+        context->Renderer.Device, tilemap->TransferBuffer, true));
+
+    int buildCount = SDL_min(tilemap->dirtyCount, TILEMAP_MAX_CHUNK_UPLOADS);
+    for (int i = 0; i < buildCount; ++i)
+    {
+        int chunk = tilemap->dirtyList[i];
+        TileChunkUpload* upload = &tilemap->uploads[i];
+        upload->chunk = chunk;
+        upload->transferOffset = CHUNK_VERTICES * i;
+        upload->quadCount =
+          WriteChunk(tilemap, chunk, &vertices[upload->transferOffset]);
+        tilemap->chunks[chunk].isDirty = false;
+    }
+
+    SDL_UnmapGPUTransferBuffer(context->Renderer.Device,
+                               tilemap->TransferBuffer);
+
+    // The rest stays in the list for the next frames
+    tilemap->dirtyCount -= buildCount;
+    SDL_memmove(tilemap->dirtyList,
+                &tilemap->dirtyList[buildCount],
+                sizeof(int) * tilemap->dirtyCount);
+
+    tilemap->uploadCount = buildCount;
+    tilemap->stats.rebuiltChunks = buildCount;
+}
+
+void
+TilemapUpload(Context* context, SDL_GPUCopyPass* copyPass)
+{
+    Tilemap* tilemap = &context->tilemap;
+    tilemap->stats.uploadedBytes = 0;
+
+    for (int i = 0; i < tilemap->uploadCount; ++i)
+    {
+        const TileChunkUpload* upload = &tilemap->uploads[i];
+        if (upload->quadCount > 0)
+        {
+            SDL_GPUTransferBufferLocation transferLocation = {
+                .transfer_buffer = tilemap->TransferBuffer,
+                .offset = static_cast<Uint32>(sizeof(PositionTextureVertex) *
+                                              upload->transferOffset),
+            };
+            SDL_GPUBufferRegion vertexBufferRegion = {
+                .buffer = tilemap->VertexBuffer,
+                .offset = static_cast<Uint32>(sizeof(PositionTextureVertex) *
+                                              CHUNK_VERTICES * upload->chunk),
+                .size = static_cast<Uint32>(sizeof(PositionTextureVertex) * 4 *
+                                            upload->quadCount),
+            };
+            SDL_UploadToGPUBuffer(
+              copyPass, &transferLocation, &vertexBufferRegion, false);
+            tilemap->stats.uploadedBytes += vertexBufferRegion.size;
+        }
+
+        // Drawn from this frame on
+        tilemap->chunks[upload->chunk].quadCount = upload->quadCount;
+    }
+
+    tilemap->uploadCount = 0;
+}
+
+void
+TilemapRender(Context* context, SDL_GPURenderPass* renderPass)
+{
+    Tilemap* tilemap = &context->tilemap;
+    tilemap->stats.visibleChunks = 0;
+    tilemap->stats.drawnQuads = 0;
+    if (!tilemap->isEnabled)
+    {
+        return;
+    }
+
+    GameRenderer* renderer = &context->Renderer;
+    SDL_GPUTextureSamplerBinding textureSamplerBinding = {
+        .texture = renderer->SpriteTextures[0],
+        .sampler = renderer->Samplers[renderer->CurrentSamplerIndex],
+    };
+    SDL_BindGPUFragmentSamplers(renderPass, 0, &textureSamplerBinding, 1);
+
+    SDL_GPUBufferBinding vertexBufferBinding = {
+        .buffer = tilemap->VertexBuffer,
+        .offset = 0,
+    };
+    SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
+
+    // Only the chunks under the view are visited, so the cost does not
+    // grow with the size of the map
+    const glm::vec2 viewMin = context->Renderer.viewMin;
+    const glm::vec2 viewMax = context->Renderer.viewMax;
+    const float chunkPixels = (float)TILEMAP_CHUNK_PIXELS;
+    int firstX = SDL_max(0, (int)SDL_floorf(viewMin.x / chunkPixels));
+    int firstY = SDL_max(0, (int)SDL_floorf(viewMin.y / chunkPixels));
+    int lastX = SDL_min(tilemap->chunksX - 1,
+                        (int)SDL_ceilf(viewMax.x / chunkPixels) - 1);
+    int lastY = SDL_min(tilemap->chunksY - 1,
+                        (int)SDL_ceilf(viewMax.y / chunkPixels) - 1);
+    for (int chunkY = firstY; chunkY <= lastY; ++chunkY)
+    {
+        for (int chunkX = firstX; chunkX <= lastX; ++chunkX)
+        {
+            int chunk = chunkY * tilemap->chunksX + chunkX;
+            int quadCount = tilemap->chunks[chunk].quadCount;
+            tilemap->stats.visibleChunks += 1;
+            if (quadCount == 0)
+            {
+                continue;
+            }
+
+            SDL_DrawGPUIndexedPrimitives(renderPass,
+                                         (Uint32)quadCount * 6,
+                                         1,
+                                         0,
+                                         (Sint32)(CHUNK_VERTICES * chunk),
+                                         0);
+            tilemap->stats.drawnQuads += quadCount;
+            RendererCountDraw(&context->Renderer);
+        }
+    }
+}
+
+void
+TilemapDestroy(Context* context)
+{
+    Tilemap* tilemap = &context->tilemap;
+
+    if (tilemap->VertexBuffer != nullptr)
+    {
+        SDL_ReleaseGPUBuffer(context->Renderer.Device, tilemap->VertexBuffer);
+    }
+
+    if (tilemap->TransferBuffer != nullptr)
+    {
+        SDL_ReleaseGPUTransferBuffer(context->Renderer.Device,
+                                     tilemap->TransferBuffer);
+    }
+
+    SDL_free(tilemap->tiles);
+
+    *tilemap = (Tilemap){ 0 };
+}